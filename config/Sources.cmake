@@ -36,6 +36,7 @@ set(vkcv_sources
 		${vkcv_source}/vkcv/Window.cpp
 		
 		${vkcv_include}/vkcv/BufferTypes.hpp
+		${vkcv_include}/vkcv/BufferRange.hpp
 		${vkcv_include}/vkcv/Buffer.hpp
 		
 		${vkcv_include}/vkcv/PushConstants.hpp
@@ -122,6 +123,9 @@ set(vkcv_sources
         ${vkcv_source}/vkcv/CommandStreamManager.hpp
         ${vkcv_source}/vkcv/CommandStreamManager.cpp
         
+        ${vkcv_source}/vkcv/WorkerPool.hpp
+        ${vkcv_source}/vkcv/WorkerPool.cpp
+        
         ${vkcv_include}/vkcv/EventFunctionTypes.hpp
         
         ${vkcv_include}/vkcv/Multisampling.hpp
@@ -147,6 +151,9 @@ set(vkcv_sources
 		${vkcv_include}/vkcv/VertexData.hpp
 		${vkcv_source}/vkcv/VertexData.cpp
 		
+		${vkcv_include}/vkcv/MemoryStatistics.hpp
+		${vkcv_source}/vkcv/MemoryStatistics.cpp
+		
 		${vkcv_include}/vkcv/GeometryData.hpp
 		${vkcv_source}/vkcv/GeometryData.cpp
 		
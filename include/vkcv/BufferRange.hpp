@@ -0,0 +1,22 @@
+#pragma once
+/**
+ * @authors Tobias Frisch
+ * @file vkcv/BufferRange.hpp
+ * @brief Structure to represent a range of memory inside a buffer.
+ */
+
+#include "Handles.hpp"
+
+namespace vkcv {
+
+	/**
+	 * @brief Structure to store a range of memory inside a buffer which
+	 * might be shared with other ranges.
+	 */
+	struct BufferRange {
+		BufferHandle m_buffer;
+		size_t m_offset;
+		size_t m_size;
+	};
+
+} // namespace vkcv
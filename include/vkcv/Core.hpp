@@ -6,11 +6,15 @@
  * @brief Handling of global states regarding dependencies.
  */
 
+#include <filesystem>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vulkan/vulkan.hpp>
 
 #include "BlitDownsampler.hpp"
+#include "BufferRange.hpp"
 #include "BufferTypes.hpp"
 #include "ComputePipelineConfig.hpp"
 #include "Container.hpp"
@@ -24,6 +28,7 @@
 #include "GraphicsPipelineConfig.hpp"
 #include "Handles.hpp"
 #include "ImageConfig.hpp"
+#include "MemoryStatistics.hpp"
 #include "PassConfig.hpp"
 #include "PushConstants.hpp"
 #include "RayTracingPipelineConfig.hpp"
@@ -50,12 +55,21 @@ namespace vkcv {
 	class CommandStreamManager;
 	class WindowManager;
 	class SwapchainManager;
+	class WorkerPool;
 
 	/**
 	 * @brief Class to handle the core functionality of the framework.
 	 *
 	 * The class handles the core functionality of the framework with most
 	 * calls addressing resource management via more simplified abstraction.
+	 *
+	 * Buffers, images, samplers, descriptor set layouts and descriptor sets
+	 * can be created from multiple threads while another thread records
+	 * commands. Querying their Vulkan handles is safe concurrently as well.
+	 * Handles can be released from any thread because their destruction gets
+	 * deferred to the thread advancing the frames. Filling, mapping or
+	 * transitioning resources and everything involving command streams
+	 * still needs to happen on one thread at a time.
 	 */
 	class Core final {
 	private:
@@ -64,15 +78,84 @@ namespace vkcv {
 		 *
 		 * @param context encapsulates various Vulkan objects
 		 */
-		explicit Core(Context &&context) noexcept;
+		explicit Core(Context &&context, uint32_t framesInFlight) noexcept;
 
 		// explicit destruction of default constructor
 		Core() = delete;
 
+		friend bool deferDestruction(Core &core, const FinishCommandFunction &destroy);
+
+		/**
+		 * @brief Command pool to allocate secondary command buffers from which
+		 * get recorded by one thread at a time.
+		 */
+		struct SecondaryCommandPool {
+			vk::CommandPool commandPool;
+			Vector<vk::CommandBuffer> commandBuffers;
+			size_t usedCommandBuffers;
+		};
+
+		/**
+		 * @brief Resources of a frame which might be in flight at the same time as
+		 * the frames following it.
+		 */
+		struct FrameInFlight {
+			Vector<vk::CommandPool> commandPools;
+			Vector<SecondaryCommandPool> secondaryCommandPools;
+			vk::Semaphore renderFinished;
+			bool renderingSignaled;
+			uint64_t submission;
+			Vector<FinishCommandFunction> destructions;
+		};
+
 		Result acquireSwapchainImage(const SwapchainHandle &swapchainHandle);
 
+		/**
+		 * @brief Closes the current frame in flight and opens the next one in the
+		 * ring after all of its previous submissions have been retired.
+		 */
+		void advanceFrameInFlight();
+
+		/**
+		 * @brief Adds the semaphores to a submission of the current frame in flight
+		 * which signal the end of its rendering. A submission following another one
+		 * signaling it waits for the previous signal, so the presentation waits
+		 * for both.
+		 *
+		 * @param[in] signalRendering Flag to specify if the submission finishes rendering
+		 * @param[out] waitSemaphores Semaphores to wait for
+		 * @param[out] signalSemaphores Semaphores to signal
+		 */
+		void prepareRenderingSemaphores(bool signalRendering,
+										Vector<vk::Semaphore> &waitSemaphores,
+										Vector<vk::Semaphore> &signalSemaphores);
+
+		/**
+		 * @brief Returns secondary command buffers of the current frame in flight
+		 * on the graphics queue, each one allocated from a different command pool.
+		 *
+		 * @param[in] count Amount of command buffers
+		 * @return Secondary command buffers
+		 */
+		Vector<vk::CommandBuffer> getSecondaryCommandBuffers(size_t count);
+
+		/**
+		 * @brief Returns the shared pool of worker threads creating resources in
+		 * parallel, which gets started on its first use.
+		 *
+		 * @return Worker pool
+		 */
+		WorkerPool &getCreationWorkers();
+
 		Context m_Context;
 
+		Vector<FrameInFlight> m_Frames;
+		uint32_t m_currentFrameIndex;
+		std::mutex m_FramesMutex;
+
+		vk::PipelineCache m_PipelineCache;
+		std::filesystem::path m_PipelineCacheDirectory;
+
 		std::unique_ptr<DescriptorSetLayoutManager> m_DescriptorSetLayoutManager;
 		std::unique_ptr<DescriptorSetManager> m_DescriptorSetManager;
 		std::unique_ptr<BufferManager> m_BufferManager;
@@ -86,9 +169,13 @@ namespace vkcv {
 		std::unique_ptr<GraphicsPipelineManager> m_GraphicsPipelineManager;
 		std::unique_ptr<ComputePipelineManager> m_ComputePipelineManager;
 		std::unique_ptr<RayTracingPipelineManager> m_RayTracingPipelineManager;
+		std::unique_ptr<WorkerPool> m_RecordingWorkers;
+		std::unique_ptr<WorkerPool> m_CreationWorkers;
+		std::once_flag m_CreationWorkersFlag;
+
+		bool m_DrawcallSorting;
+		DrawcallStatistics m_DrawcallStatistics;
 		
-		Vector<vk::CommandPool> m_CommandPools;
-		vk::Semaphore m_RenderFinished;
 		std::vector<vk::Semaphore> m_SwapchainImagesAcquired;
 		uint32_t m_currentSwapchainImageIndex;
 		uint32_t m_currentSwapchainSemaphoreIndex;
@@ -159,12 +246,114 @@ namespace vkcv {
 		 * @param[in] queueFlags (optional) Requested flags of queues
 		 * @param[in] instanceExtensions (optional) Requested instance extensions
 		 * @param[in] deviceExtensions (optional) Requested device extensions
+		 * @param[in] framesInFlight (optional) Amount of frames in flight
 		 * @return New instance of #Context
 		 */
 		static Core create(const std::string &applicationName, uint32_t applicationVersion,
 						   const Vector<vk::QueueFlagBits> &queueFlags = {},
 						   const Features &features = {},
-						   const Vector<const char*> &instanceExtensions = {});
+						   const Vector<const char*> &instanceExtensions = {},
+						   uint32_t framesInFlight = 2);
+
+		/**
+		 * @brief Returns the amount of frames which can be in flight at the same time.
+		 *
+		 * @return Amount of frames in flight
+		 */
+		[[nodiscard]] uint32_t getFramesInFlight() const;
+
+		/**
+		 * @brief Returns the index of the current frame in the ring of frames in
+		 * flight. Resources which get updated every frame while previous frames
+		 * are still in flight can be duplicated per index.
+		 *
+		 * @return Index of the current frame in flight
+		 */
+		[[nodiscard]] uint32_t getCurrentFrameInFlight() const;
+
+		/**
+		 * @brief Sets the amount of threads recording drawcalls in parallel into
+		 * secondary command buffers, including the thread recording the command
+		 * stream. A value of one or zero disables parallel recording.
+		 *
+		 * @param[in] threadCount Amount of recording threads
+		 */
+		void setRecordingThreadCount(uint32_t threadCount);
+
+		/**
+		 * @brief Returns the amount of threads recording drawcalls in parallel.
+		 *
+		 * @return Amount of recording threads
+		 */
+		[[nodiscard]] uint32_t getRecordingThreadCount() const;
+
+		/**
+		 * @brief Sets whether drawcalls get sorted by their descriptor sets, vertex
+		 * buffers and index buffer before recording, so that redundant binds
+		 * can be skipped more often. Sorting changes the order of drawcalls
+		 * which might affect blending. It is disabled by default.
+		 *
+		 * @param[in] sorting Sorting of drawcalls
+		 */
+		void setDrawcallSorting(bool sorting);
+
+		/**
+		 * @brief Returns whether drawcalls get sorted before recording.
+		 *
+		 * @return True, if drawcalls get sorted, otherwise false
+		 */
+		[[nodiscard]] bool isDrawcallSorting() const;
+
+		/**
+		 * @brief Returns the statistics of binds recorded and skipped for
+		 * drawcalls since the last reset.
+		 *
+		 * @return Drawcall statistics
+		 */
+		[[nodiscard]] const DrawcallStatistics &getDrawcallStatistics() const;
+
+		/**
+		 * @brief Resets the statistics of binds recorded and skipped for
+		 * drawcalls.
+		 */
+		void resetDrawcallStatistics();
+
+		/**
+		 * @brief Returns the current memory usage and budget of each memory heap
+		 * and the memory used by buffers and images grouped by buffer type, image
+		 * format and debug label. Budgets are only reported accurately if the
+		 * device supports the memory budget extension.
+		 *
+		 * @return Memory statistics
+		 */
+		[[nodiscard]] MemoryStatistics getMemoryStatistics() const;
+
+		/**
+		 * @brief Returns the pipeline cache shared by all pipelines created
+		 * via the core.
+		 *
+		 * @return Vulkan pipeline cache
+		 */
+		[[nodiscard]] const vk::PipelineCache &getPipelineCache() const;
+
+		/**
+		 * @brief Sets the directory to load the pipeline cache from and to
+		 * save it to on destruction of the core. Cached data will only be
+		 * loaded if it matches the current device and driver. By default the
+		 * cache is stored in the temporary directory of the system.
+		 *
+		 * @param[in] directory Path of the cache directory
+		 * @return True on success, false otherwise
+		 */
+		bool setPipelineCacheDirectory(const std::filesystem::path &directory);
+
+		/**
+		 * @brief Writes the current content of the pipeline cache to the
+		 * cache directory if any has been set.
+		 *
+		 * @return True on success, false otherwise
+		 */
+		bool savePipelineCache() const;
 
 		/**
 		 * Creates a basic vulkan graphics pipeline using @p config from the pipeline config class
@@ -188,6 +377,26 @@ namespace vkcv {
 		 */
 		[[nodiscard]] ComputePipelineHandle
 		createComputePipeline(const ComputePipelineConfig &config);
+
+		/**
+		 * @brief Creates multiple graphics pipelines in parallel across a pool
+		 * of worker threads, sharing the pipeline cache of the core.
+		 *
+		 * @param[in] configs Pipeline configs
+		 * @return Handles of the created pipelines in order of their configs
+		 */
+		[[nodiscard]] Vector<GraphicsPipelineHandle>
+		createGraphicsPipelines(const Vector<GraphicsPipelineConfig> &configs);
+
+		/**
+		 * @brief Creates multiple compute pipelines in parallel across a pool
+		 * of worker threads, sharing the pipeline cache of the core.
+		 *
+		 * @param[in] configs Pipeline configs
+		 * @return Handles of the created pipelines in order of their configs
+		 */
+		[[nodiscard]] Vector<ComputePipelineHandle>
+		createComputePipelines(const Vector<ComputePipelineConfig> &configs);
 		
 		/**
 		 * Creates a basic vulkan ray tracing pipeline using @p shader program and returns it using
@@ -245,6 +454,23 @@ namespace vkcv {
 								  BufferMemoryType memoryType = BufferMemoryType::DEVICE_LOCAL,
 								  bool readable = false);
 
+		/**
+		 * @brief Allocates a range of memory from a large pooled buffer of a given
+		 * type and returns the buffer handle with the offset of the range. Many small
+		 * ranges share the same buffer this way, so they can be bound together. The
+		 * memory of a range can only be reused once all ranges of its buffer have been
+		 * released.
+		 *
+		 * @param[in] type Type of buffer
+		 * @param[in] size Size of the range in bytes
+		 * @param[in] alignment Alignment of the range in bytes
+		 * @param[in] memoryType Type of buffers memory
+		 * @return Range of buffer memory
+		 */
+		[[nodiscard]] BufferRange
+		allocateBufferRange(BufferType type, size_t size, size_t alignment = 16,
+							BufferMemoryType memoryType = BufferMemoryType::DEVICE_LOCAL);
+
 		/**
 		 * @brief Returns the vulkan buffer of a given buffer handle.
 		 *
@@ -331,13 +557,15 @@ namespace vkcv {
 		void unmapBuffer(const BufferHandle &buffer);
 
 		/**
-		 * Creates a Sampler with given attributes.
+		 * Creates a Sampler with given attributes. Samplers with equal attributes
+		 * get shared, so a matching handle is returned if one is still in use.
 		 *
 		 * @param[in] magFilter Magnifying filter
 		 * @param[in] minFilter Minimizing filter
 		 * @param[in] mipmapMode Mipmapping filter
 		 * @param[in] addressMode Address mode
 		 * @param[in] mipLodBias Mip level of detail bias
+		 * @param[in] borderColor Border color
 		 * @return Sampler handle
 		 */
 		[[nodiscard]] SamplerHandle
@@ -361,19 +589,24 @@ namespace vkcv {
 
 		/**
 		 * @brief Fills the image with given data of a specified size
-		 * in bytes.
+		 * in bytes. The data contains the filled mip levels in order,
+		 * each with all of its filled image layers tightly packed.
 		 *
 		 * @param[in] image Image handle
 		 * @param[in] data Image data pointer
 		 * @param[in] size Size of data
 		 * @param[in] firstLayer First image layer
 		 * @param[in] layerCount Image layer count
+		 * @param[in] firstMipLevel (Optional) First mip level
+		 * @param[in] mipLevelCount (Optional) Mip level count
 		 */
 		void fillImage(const ImageHandle &image,
 					   const void* data,
 					   size_t size,
 					   uint32_t firstLayer,
-					   uint32_t layerCount);
+					   uint32_t layerCount,
+					   uint32_t firstMipLevel = 0,
+					   uint32_t mipLevelCount = 1);
 
 		/**
 		 * @brief Switches the images layout synchronously if possible.
@@ -383,6 +616,26 @@ namespace vkcv {
 		 */
 		void switchImageLayout(const ImageHandle &image, vk::ImageLayout layout);
 
+		/**
+		 * @brief Records the generation of the mip chain of an image into the
+		 * pending uploads, so it runs right after them in the same batch. The
+		 * image is ready for sampling afterwards.
+		 *
+		 * @param[in] image Image handle
+		 */
+		void recordMipChainGenerationToUploads(const ImageHandle &image);
+
+		/**
+		 * @brief Submits all pending uploads from buffer and image fills at once.
+		 *
+		 * Uploads get flushed automatically before any command stream gets submitted
+		 * and when a new frame begins. Flushing them explicitly allows finishing a
+		 * whole batch of uploads, for example while loading a scene, in the background.
+		 *
+		 * @return Submission token of the uploads or zero if nothing was pending
+		 */
+		uint64_t flushUploads();
+
 		/**
 		 * @brief Returns the default blit-downsampler.
 		 *
@@ -526,6 +779,11 @@ namespace vkcv {
 		/**
 		 * @brief Records drawcalls to a command stream
 		 *
+		 * Binds of vertex buffers, descriptor sets and index buffers which match
+		 * the state of the previous drawcall get skipped. Large amounts of
+		 * drawcalls get split across the recording threads into secondary
+		 * command buffers if more than one recording thread is set.
+		 *
 		 * @param cmdStreamHandle Handle of the command stream that the drawcalls are recorded into
 		 * @param pipelineHandle Handle of the pipeline that is used for the drawcalls
 		 * @param pushConstants Push constants that are used for the drawcalls, ignored if constant
@@ -680,6 +938,38 @@ namespace vkcv {
 		 */
 		void submitCommandStream(const CommandStreamHandle &stream, bool signalRendering = true);
 
+		/**
+		 * @brief Submit command stream to GPU for actual execution without waiting
+		 * for its completion. The finish functions of the command stream will be
+		 * called once the GPU has retired the submitted work.
+		 *
+		 * @param[in] handle Command stream to submit
+		 * @param[in] signalRendering Flag to specify if the command stream finishes rendering
+		 * @return Submission token to poll or wait for its completion
+		 */
+		uint64_t submitCommandStreamAsync(const CommandStreamHandle &stream,
+										  bool signalRendering = true);
+
+		/**
+		 * @brief Checks whether the work of a submission has been finished by the GPU
+		 * without blocking. Finish functions of all retired command streams get called.
+		 *
+		 * @param[in] submission Submission token
+		 * @return True, if the submission is finished, otherwise false
+		 */
+		bool isSubmissionFinished(uint64_t submission);
+
+		/**
+		 * @brief Waits until the work of a submission has been finished by the GPU.
+		 * Finish functions of all retired command streams get called.
+		 *
+		 * @param[in] submission Submission token
+		 * @param[in] timeout Timeout in nanoseconds
+		 * @return True, if the submission is finished, otherwise false
+		 */
+		bool waitForSubmission(uint64_t submission,
+							   uint64_t timeout = std::numeric_limits<uint64_t>::max());
+
 		/**
 		 * @brief Prepare swapchain image for presentation to screen.
 		 * Handles internal state such as image format, also acts as a memory barrier
@@ -59,18 +59,44 @@ namespace vkcv {
 	class IndirectDrawcall : public Drawcall {
 	private:
 		BufferHandle m_indirectDrawBuffer;
+		size_t m_indirectDrawOffset;
 		VertexData m_vertexData;
 		uint32_t m_drawCount;
+		BufferHandle m_drawCountBuffer;
+		size_t m_drawCountOffset;
 
 	public:
 		explicit IndirectDrawcall(const BufferHandle &indirectDrawBuffer,
-								  const VertexData &vertexData, uint32_t drawCount = 1);
+								  const VertexData &vertexData, uint32_t drawCount = 1,
+								  size_t indirectDrawOffset = 0);
 
 		[[nodiscard]] BufferHandle getIndirectDrawBuffer() const;
 
+		[[nodiscard]] size_t getIndirectDrawOffset() const;
+
 		[[nodiscard]] const VertexData &getVertexData() const;
 
+		/**
+		 * @brief Returns the amount of draws or the maximum amount of draws
+		 * if a draw count buffer is used.
+		 *
+		 * @return Amount of draws
+		 */
 		[[nodiscard]] uint32_t getDrawCount() const;
+
+		/**
+		 * @brief Uses a buffer to read the actual amount of draws from
+		 * during execution, limited by the draw count of the drawcall.
+		 *
+		 * @param[in] drawCountBuffer Buffer containing the draw count
+		 * @param[in] drawCountOffset Offset in bytes of the draw count
+		 */
+		void useDrawCountBuffer(const BufferHandle &drawCountBuffer,
+								size_t drawCountOffset = 0);
+
+		[[nodiscard]] BufferHandle getDrawCountBuffer() const;
+
+		[[nodiscard]] size_t getDrawCountOffset() const;
 	};
 
 	/**
@@ -86,4 +112,19 @@ namespace vkcv {
 		[[nodiscard]] DispatchSize getTaskSize() const;
 	};
 
+	/**
+	 * @brief Structure to count the state changes recorded for drawcalls and
+	 * the redundant ones which got skipped because consecutive drawcalls
+	 * share the same state.
+	 */
+	struct DrawcallStatistics {
+		size_t drawcalls;
+		size_t vertexBufferBinds;
+		size_t vertexBufferBindsSkipped;
+		size_t descriptorSetBinds;
+		size_t descriptorSetBindsSkipped;
+		size_t indexBufferBinds;
+		size_t indexBufferBindsSkipped;
+	};
+
 } // namespace vkcv
@@ -5,16 +5,46 @@
  * @brief Central header file for all possible handles that the framework will hand out.
  */
 
+#include <cstdint>
 #include <iostream>
 
+#ifdef VKCV_ATOMIC_HANDLES
+#include <atomic>
+#endif
+
 #include "Event.hpp"
 
 namespace vkcv {
 
 	/**
-	 * @brief Function to be called when a handles resources can be destroyed.
+	 * @brief Reference counter of handles stored in the slot of its owner.
 	 */
-	typedef typename event_function<uint64_t>::type HandleDestroyFunction;
+#ifdef VKCV_ATOMIC_HANDLES
+	typedef std::atomic<uint64_t> HandleCounter;
+#else
+	typedef uint64_t HandleCounter;
+#endif
+
+	class Handle;
+
+	/**
+	 * @brief Interface of owners managing the resources of handles.
+	 */
+	class HandleOwner {
+		friend class Handle;
+
+	protected:
+		/**
+		 * @brief Releases the resources of a handle after its last
+		 * reference got dropped.
+		 *
+		 * @param[in] id Handle id
+		 */
+		virtual void releaseHandle(uint64_t id) = 0;
+
+	public:
+		virtual ~HandleOwner() = default;
+	};
 
 	/**
 	 * @brief Class for general memory management via handles.
@@ -24,9 +54,8 @@ namespace vkcv {
 
 	private:
 		uint64_t m_id;
-		uint64_t* m_rc;
-
-		HandleDestroyFunction m_destroy;
+		HandleCounter* m_rc;
+		HandleOwner* m_owner;
 
 		/**
 		 * @brief Private internal method to destroy handle.
@@ -41,12 +70,21 @@ namespace vkcv {
 
 		/**
 		 * @brief Constructor of a valid handle with an
-		 * unique id and an optional destroy callback.
+		 * unique id which is not reference counted.
+		 *
+		 * @param[in] id Unique handle id
+		 */
+		explicit Handle(uint64_t id);
+
+		/**
+		 * @brief Constructor of a valid handle with an unique id
+		 * and a reference counter stored by its owner.
 		 *
 		 * @param[in] id Unique handle id
-		 * @param[in] destroy Destroy callback (optional)
+		 * @param[in,out] counter Reference counter
+		 * @param[in,out] owner Owner of the handle
 		 */
-		explicit Handle(uint64_t id, const HandleDestroyFunction &destroy = nullptr);
+		Handle(uint64_t id, HandleCounter &counter, HandleOwner &owner);
 
 		/**
 		 * @brief Returns the actual handle id of a handle.
@@ -194,14 +232,12 @@ namespace vkcv {
 		[[nodiscard]] bool isSwapchainImage() const;
 
 		/**
-		 * @brief Creates a valid image handle to represent a swapchain image
-		 * using an optional destroy callback.
+		 * @brief Creates a valid image handle to represent a swapchain image.
 		 *
-		 * @param[in] destroy Destroy callback (optional)
 		 * @return New swapchain image handle
 		 */
 		static ImageHandle
-		createSwapchainImageHandle(const HandleDestroyFunction &destroy = nullptr);
+		createSwapchainImageHandle();
 	};
 	
 	/**
@@ -35,6 +35,15 @@ namespace vkcv {
 	 */
 	bool isStencilFormat(const vk::Format format);
 
+	/**
+	 * @brief Returns whether an image format is block-compressed.
+	 *
+	 * @param format Vulkan image format
+	 * @return True, if the format stores texels in compressed blocks,
+	 * otherwise false.
+	 */
+	bool isCompressedFormat(const vk::Format format);
+
 	/**
 	 * @brief Class for image handling and filling data.
 	 */
@@ -123,6 +132,23 @@ namespace vkcv {
 		 * the actual number of copied bytes is min(size, imageDataSize)
 		 */
 		void fillLayer(uint32_t layer, const void* data, size_t size = SIZE_MAX);
+		
+		/**
+		 * @brief Fills a range of mip levels with data of a given
+		 * size in bytes. The data contains the mip levels in order
+		 * starting with the largest one, tightly packed.
+		 *
+		 * @param[in] firstMipLevel First mip level destination
+		 * @param[in] mipLevelCount Amount of mip levels, zero fills
+		 * all remaining mip levels
+		 * @param[in] data Pointer to the source data
+		 * @param[in] size Lower limit of the data size to copy in bytes,
+		 * only mip levels fully covered by the size get filled
+		 */
+		void fillMipLevels(uint32_t firstMipLevel,
+						   uint32_t mipLevelCount,
+						   const void* data,
+						   size_t size = SIZE_MAX);
 
 		/**
 		 * @brief Records mip chain generation to command stream,
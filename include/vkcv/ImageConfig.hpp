@@ -18,6 +18,8 @@ namespace vkcv {
 		uint32_t m_height;
 		uint32_t m_depth;
 		
+		uint32_t m_mipCount;
+		
 		bool m_supportStorage;
 		bool m_supportColorAttachment;
 		bool m_cubeMapImage;
@@ -90,6 +92,25 @@ namespace vkcv {
 		 */
 		void setDepth(uint32_t depth);
 		
+		/**
+		 * Return the maximum amount of mip levels of the image
+		 * configuration when created with a mip chain, zero
+		 * means the mip chain is complete.
+		 *
+		 * @return Maximum amount of mip levels
+		 */
+		[[nodiscard]]
+		uint32_t getMipCount() const;
+		
+		/**
+		 * Set the maximum amount of mip levels of the image
+		 * configuration when created with a mip chain (for
+		 * example to match prebuilt mip levels).
+		 *
+		 * @param[in] mipCount Maximum amount of mip levels
+		 */
+		void setMipCount(uint32_t mipCount);
+		
 		/**
 		 * Return whether the image is configured to
 		 * support storage operations.
@@ -0,0 +1,70 @@
+#pragma once
+/**
+ * @authors Tobias Frisch
+ * @file vkcv/MemoryStatistics.hpp
+ * @brief Structures to report the memory usage of resources.
+ */
+
+#include <string>
+#include <vulkan/vulkan.hpp>
+
+#include "BufferTypes.hpp"
+#include "Container.hpp"
+
+namespace vkcv {
+
+	/**
+	 * @brief Structure to store the usage and budget of a memory heap.
+	 * The usage and budget include allocations of other processes and
+	 * are only estimated if the device does not support memory budgets.
+	 */
+	struct MemoryHeapStatistics {
+		bool deviceLocal;
+		size_t size;
+		size_t usage;
+		size_t budget;
+		size_t blockBytes;
+		size_t allocationBytes;
+		size_t blockCount;
+		size_t allocationCount;
+	};
+
+	/**
+	 * @brief Structure to store the amount of allocations and their
+	 * total size in bytes.
+	 */
+	struct MemoryUsage {
+		size_t bytes;
+		size_t count;
+	};
+
+	/**
+	 * @brief Structure to report the memory usage per heap and the memory
+	 * used by buffers and images grouped by buffer type, image format and
+	 * debug label. Resources without a debug label are not listed per label.
+	 */
+	struct MemoryStatistics {
+		bool budgetSupported;
+		Vector<MemoryHeapStatistics> heaps;
+		Dictionary<BufferType, MemoryUsage> bufferTypes;
+		Dictionary<vk::Format, MemoryUsage> imageFormats;
+		Dictionary<std::string, MemoryUsage> labels;
+	};
+
+	/**
+	 * @brief Adds an allocation with a given size to the memory usage.
+	 *
+	 * @param[in,out] usage Memory usage
+	 * @param[in] bytes Size of the allocation in bytes
+	 */
+	void addMemoryUsage(MemoryUsage &usage, size_t bytes);
+
+	/**
+	 * @brief Returns the memory statistics in JSON format.
+	 *
+	 * @param[in] statistics Memory statistics
+	 * @return JSON string
+	 */
+	[[nodiscard]] std::string memoryStatisticsToJSON(const MemoryStatistics &statistics);
+
+} // namespace vkcv
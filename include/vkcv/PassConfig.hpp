@@ -69,6 +69,7 @@ namespace vkcv {
 	private:
 		AttachmentDescriptions m_attachments;
 		Multisampling m_multisampling;
+		bool m_dynamicRendering;
 
 	public:
 		PassConfig();
@@ -89,6 +90,21 @@ namespace vkcv {
 		void setMultisampling(Multisampling multisampling);
 
 		[[nodiscard]] Multisampling getMultisampling() const;
+
+		/**
+		 * @brief Sets whether the pass should use dynamic rendering instead of
+		 * a render pass and framebuffers if the device supports it.
+		 *
+		 * @param[in] dynamicRendering Dynamic rendering
+		 */
+		void setDynamicRendering(bool dynamicRendering);
+
+		/**
+		 * @brief Returns whether the pass should use dynamic rendering.
+		 *
+		 * @return True, if dynamic rendering is requested, otherwise false
+		 */
+		[[nodiscard]] bool isDynamicRendering() const;
 	};
 
 } // namespace vkcv
\ No newline at end of file
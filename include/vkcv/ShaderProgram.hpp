@@ -43,6 +43,15 @@ namespace vkcv {
 		 */
 		bool addShader(ShaderStage stage, const std::filesystem::path &path);
 
+		/**
+		 * @brief Adds a shader into the shader program from a SPIR-V
+		 * binary in memory.
+		 *
+		 * @param[in] stage The stage of the shader
+		 * @param[in] binary SPIR-V shader binary
+		 */
+		bool addShader(ShaderStage stage, const Vector<uint32_t> &binary);
+
 		/**
 		 * @brief Returns the shader binary of a specified stage from the program.
 		 * Needed for the transfer to the pipeline.
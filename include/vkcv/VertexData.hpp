@@ -51,6 +51,7 @@ namespace vkcv {
 		VertexBufferBindings m_bindings;
 		BufferHandle m_indices;
 		IndexBitCount m_indexBitCount;
+		size_t m_indexOffset;
 		size_t m_count;
 
 	public:
@@ -82,9 +83,11 @@ namespace vkcv {
 		 *
 		 * @param[in] indices Index buffer handle
 		 * @param[in] indexBitCount Index bit count
+		 * @param[in] offset (Optional) Offset of the indices in bytes
 		 */
 		void setIndexBuffer(const BufferHandle &indices,
-							IndexBitCount indexBitCount = IndexBitCount::Bit16);
+							IndexBitCount indexBitCount = IndexBitCount::Bit16,
+							size_t offset = 0);
 
 		/**
 		 * @brief Return the handle from the used index buffer of the vertex
@@ -102,6 +105,14 @@ namespace vkcv {
 		 */
 		[[nodiscard]] IndexBitCount getIndexBitCount() const;
 
+		/**
+		 * @brief Return the offset in bytes of the indices inside the used
+		 * index buffer of the vertex data.
+		 *
+		 * @return Offset of indices in bytes
+		 */
+		[[nodiscard]] size_t getIndexOffset() const;
+
 		/**
 		 * @brief Set the count of elements to use by the vertex data.
 		 *
@@ -177,8 +177,8 @@ namespace vkcv::algorithm {
 					{ "ffx_a.h", FFX_A_H_SHADER },
 					{ "ffx_spd.h", FFX_SPD_H_SHADER }
 				},
-				[&program](vkcv::ShaderStage shaderStage, const std::filesystem::path& path) {
-					program.addShader(shaderStage, path);
+				[&program](vkcv::ShaderStage shaderStage, const Vector<uint32_t>& binary) {
+					program.addShader(shaderStage, binary);
 				}
 		);
 		
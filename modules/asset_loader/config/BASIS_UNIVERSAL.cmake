@@ -0,0 +1,15 @@
+
+use_git_submodule("${vkcv_asset_loader_lib_path}/basis_universal" basis_universal_status)
+
+# the transcoder of Basis Universal is required for KTX2 textures with universal compression
+if (${basis_universal_status})
+	list(APPEND vkcv_asset_loader_includes ${vkcv_asset_loader_lib}/basis_universal)
+	
+	target_sources(vkcv_asset_loader PRIVATE
+			${vkcv_asset_loader_lib_path}/basis_universal/transcoder/basisu_transcoder.cpp
+			${vkcv_asset_loader_lib_path}/basis_universal/zstd/zstddeclib.c
+	)
+	
+	list(APPEND vkcv_asset_loader_definitions VKCV_ASSET_LOADER_BASISU)
+	list(APPEND vkcv_asset_loader_definitions BASISD_SUPPORT_KTX2_ZSTD=1)
+endif ()
@@ -0,0 +1,151 @@
+#pragma once
+/**
+ * @authors Tobias Frisch
+ * @file include/vkcv/asset/TextureLoader.hpp
+ * @brief Asynchronous texture decoding for the asset loader module.
+ */
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "asset_loader.hpp"
+
+namespace vkcv::asset {
+
+/**
+ * @addtogroup vkcv_asset
+ * @{
+ */
+
+/**
+ * This struct describes a texture which was decoded asynchronously by a
+ * TextureLoader. The pixels are always decoded with 4 channels as RGBA, so
+ * they can directly be uploaded into an image. Textures from KTX2- or
+ * DDS-files keep their compressed blocks of all mip levels instead, like
+ * described by the Texture struct. The memory of the pixels is owned by the
+ * struct and released with its last copy.
+ */
+struct DecodedTexture {
+	size_t index;			// index of the requested texture
+
+	union { int width; int w; };
+	union { int height; int h; };
+	int channels;			// channels of the encoded image
+
+	int format;			// VkFormat of the pixels, VK_FORMAT_UNDEFINED for RGBA
+	int levels;			// amount of mip levels in the pixels
+	size_t size;			// size of the pixels in bytes
+
+	std::shared_ptr<uint8_t> pixels;	// decoded RGBA pixels or compressed blocks
+};
+
+/**
+ * A class to decode textures on a bounded pool of worker threads. Requested
+ * textures are decoded in order of their priority, so textures with lower
+ * priority values get decoded first. The priority of pending requests can be
+ * changed at any time (eg. depending on the distance to the camera).
+ * The amount of decoded textures waiting to be polled is limited, so workers
+ * pause decoding until textures get polled to keep the memory usage bounded.
+ */
+class TextureLoader {
+private:
+	/**
+	 * A nested structure to store a pending request of a texture.
+	 */
+	struct Request {
+		size_t index;
+		float priority;
+		Texture texture;
+	};
+
+	std::vector<std::thread> m_threads;
+
+	mutable std::mutex m_mutex;
+	std::condition_variable m_requested;
+
+	std::vector<Request> m_requests;
+	std::deque<DecodedTexture> m_decoded;
+
+	std::vector<int> m_transcodeFormats;
+
+	size_t m_maxDecoded;
+	size_t m_decoding;
+	bool m_running;
+
+	/**
+	 * Main loop of each worker thread decoding requested textures.
+	 */
+	void work();
+
+public:
+	/**
+	 * Constructor of a texture loader with a given amount of worker threads
+	 * and a maximum amount of decoded textures waiting to be polled.
+	 *
+	 * @param[in] threadCount (Optional) Amount of worker threads, all available
+	 * 	hardware threads except one are used by default
+	 * @param[in] maxDecoded (Optional) Maximum amount of decoded textures
+	 * @param[in] transcodeFormats (Optional) Supported VkFormats to transcode
+	 * 	universal textures into in order of preference
+	 */
+	explicit TextureLoader(size_t threadCount = 0, size_t maxDecoded = 8,
+						   std::vector<int> transcodeFormats = {});
+
+	TextureLoader(const TextureLoader &other) = delete;
+	TextureLoader(TextureLoader &&other) = delete;
+
+	/**
+	 * Destructor of a texture loader which discards all pending requests and
+	 * waits for its worker threads to finish.
+	 */
+	~TextureLoader();
+
+	TextureLoader &operator=(const TextureLoader &other) = delete;
+	TextureLoader &operator=(TextureLoader &&other) = delete;
+
+	/**
+	 * Requests a texture to be decoded with a given priority. The texture
+	 * is decoded from its path or from its data member containing the encoded
+	 * image if the path is empty.
+	 *
+	 * @param[in] index Index to identify the texture when polling
+	 * @param[in] texture Texture struct describing the texture
+	 * @param[in] priority (Optional) Priority of the texture, lower values first
+	 */
+	void request(size_t index, Texture texture, float priority = 0.0f);
+
+	/**
+	 * Changes the priority of a pending texture request. Textures which are
+	 * already being decoded are not affected.
+	 *
+	 * @param[in] index Index of the requested texture
+	 * @param[in] priority Priority of the texture, lower values first
+	 */
+	void prioritize(size_t index, float priority);
+
+	/**
+	 * Returns the next decoded texture if there is any. Textures which could
+	 * not be decoded are returned as well without any pixels.
+	 *
+	 * @param[out] texture Decoded texture
+	 * @return True if a texture was returned, otherwise false
+	 */
+	bool poll(DecodedTexture &texture);
+
+	/**
+	 * Returns the amount of requested textures which have not been polled yet.
+	 *
+	 * @return Amount of pending textures
+	 */
+	[[nodiscard]] size_t getPendingCount() const;
+
+};
+
+/** @} */
+
+}	// end namespace vkcv::asset
@@ -10,6 +10,8 @@
 #include <array>
 #include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <span>
 
 #include "vkcv/VertexData.hpp"
 
@@ -99,6 +101,10 @@ struct Sampler {
  * RGB or is grayscale. In the case where the glTF-file does not provide a URI
  * but references a buffer view for the raw data, the path member will be empty
  * even though the rest is initialized properly.
+ * Textures stored in KTX2- or DDS-files are not decoded but loaded with their
+ * compressed blocks instead. Then the format member contains the VkFormat of
+ * the data and all mip levels of the file are stored after another, starting
+ * with the largest one.
  * NOTE: Loading textures without URI is untested.
  */
 struct Texture {
@@ -109,6 +115,9 @@ struct Texture {
 	union { int height; int h; };
 	int channels;
 	
+	int format = 0;			// VkFormat of the data, VK_FORMAT_UNDEFINED for RGBA pixels
+	int levels = 1;			// amount of mip levels in the data
+	
 	std::vector<uint8_t> data;	// binary data of the decoded texture
 };
 
@@ -218,6 +227,10 @@ struct VertexAttribute {
  * common but not always used). If there is no index buffer, this is indicated
  * by indexBuffer.data being empty. Each vertex buffer can have one or more
  * vertex attributes.
+ * If the scene was loaded with mapped buffers, the data members stay empty
+ * and the mapped members reference the binary data inside the memory-mapped
+ * files of the scene instead. Use getIndexData() and getVertexData() to access
+ * the binary data independent of the way it was loaded.
  */
 struct VertexGroup {
 	enum PrimitiveMode mode;	// draw as points, lines or triangle?
@@ -227,10 +240,12 @@ struct VertexGroup {
 	struct {
 		enum IndexType type;	// data type of the indices
 		std::vector<uint8_t> data; // binary data of the index buffer
+		std::span<const uint8_t> mapped; // binary data inside a mapped file
 	} indexBuffer;
 	
 	struct {
 		std::vector<uint8_t> data; // binary data of the vertex buffer
+		std::span<const uint8_t> mapped; // binary data inside a mapped file
 		std::vector<VertexAttribute> attributes; // description of one
 	} vertexBuffer;
 	
@@ -238,6 +253,23 @@ struct VertexGroup {
 	struct { float x, y, z; } max;	// bounding box upper right
 	
 	int materialIndex;		// index to one of the materials
+	
+	/**
+	 * Returns the binary data of the index buffer, either copied or
+	 * referenced inside a mapped file. If there is no index buffer, the
+	 * returned span is empty.
+	 *
+	 * @return Binary data of the index buffer
+	 */
+	std::span<const uint8_t> getIndexData() const;
+	
+	/**
+	 * Returns the binary data of the vertex buffer, either copied or
+	 * referenced inside a mapped file.
+	 *
+	 * @return Binary data of the vertex buffer
+	 */
+	std::span<const uint8_t> getVertexData() const;
 };
 
 /**
@@ -251,10 +283,19 @@ struct Mesh {
 	std::vector<int> vertexGroups;
 };
 
+/**
+ * This struct represents a file which is mapped read-only into memory. It is
+ * defined internally by the asset loader and unmaps the file on destruction.
+ */
+struct MappedFile;
+
 /**
  * The scene struct is simply a collection of objects in the scene as well as
  * the resources used by those objects.
  * Note that parent-child relations are not yet possible.
+ * If the scene was loaded with mapped buffers, it keeps the files mapped which
+ * its vertex groups reference. So copies of the vertex groups can only be used
+ * as long as the scene or one of its copies still exists.
  */
 struct Scene {
 	std::vector<Mesh> meshes;
@@ -263,6 +304,7 @@ struct Scene {
 	std::vector<Texture> textures;
 	std::vector<Sampler> samplers;
 	std::vector<std::string> uris;
+	std::vector<std::shared_ptr<MappedFile>> files;
 };
 
 /**
@@ -280,13 +322,20 @@ struct Scene {
  * shallow scene struct is filled with data by loadMesh().
  * Note that for URIs only (local) filesystem paths are supported, no
  * URLs using network protocols etc.
+ * With mapped buffers the glb-file or the binary buffer files get mapped into
+ * memory instead of being read and the vertex groups only reference their
+ * data inside those mappings. This avoids copying the geometry of large scenes.
+ * Buffers embedded as base64 URIs can not be mapped, so those scenes are
+ * loaded with copied buffers instead.
  *
  * @param[in] path must be the path to a glTF- or glb-file.
  * @param[out] scene is a reference to a Scene struct that will be filled with the
  * 	meta-data of all objects described in the glTF file.
+ * @param[in] mapBuffers (Optional) Flag to map binary buffers instead of copying them
  * @return ASSET_ERROR on failure, otherwise ASSET_SUCCESS
  */
-int probeScene(const std::filesystem::path &path, Scene &scene);
+int probeScene(const std::filesystem::path &path, Scene &scene,
+			   bool mapBuffers = false);
 
 /**
  * This function loads a single mesh from the given file and adds it to the
@@ -299,9 +348,12 @@ int probeScene(const std::filesystem::path &path, Scene &scene);
  *
  * @param[in,out] scene	is the scene struct to which the results will be written.
  * @param[in] mesh_index Index of the mesh to load
+ * @param[in] transcodeFormats (Optional) Supported VkFormats to transcode universal
+ * 	textures into in order of preference, RGBA pixels are used as fallback
  * @return ASSET_ERROR on failure, otherwise ASSET_SUCCESS
  */
-int loadMesh(Scene &scene, int mesh_index);
+int loadMesh(Scene &scene, int mesh_index,
+			 const std::vector<int> &transcodeFormats = {});
 
 /**
  * Load every mesh from the glTF file, as well as materials, textures and other
@@ -310,9 +362,14 @@ int loadMesh(Scene &scene, int mesh_index);
  * @param[in] path	must be the path to a glTF- or glb-file.
  * @param[out] scene is a reference to a Scene struct that will be filled with the
  * 	content of the glTF file being loaded.
+ * @param[in] mapBuffers (Optional) Flag to map binary buffers instead of copying them
+ * @param[in] transcodeFormats (Optional) Supported VkFormats to transcode universal
+ * 	textures into in order of preference, RGBA pixels are used as fallback
  * @return ASSET_ERROR on failure, otherwise ASSET_SUCCESS
  */
-int loadScene(const std::filesystem::path &path, Scene &scene);
+int loadScene(const std::filesystem::path &path, Scene &scene,
+			  bool mapBuffers = false,
+			  const std::vector<int> &transcodeFormats = {});
 
 /**
  * Simply loads a single image at the given path and returns a Texture
@@ -325,9 +382,12 @@ int loadScene(const std::filesystem::path &path, Scene &scene);
  * check that !data.empty() before using the struct.
  *
  * @param[in] path	must be the path to an image file.
+ * @param[in] transcodeFormats (Optional) Supported VkFormats to transcode universal
+ * 	textures into in order of preference, RGBA pixels are used as fallback
  * @return	Texture struct describing the loaded image.
  */
-Texture loadTexture(const std::filesystem::path& path);
+Texture loadTexture(const std::filesystem::path& path,
+					const std::vector<int> &transcodeFormats = {});
 
 /**
  * Loads up the vertex attributes and creates usable vertex buffer bindings
@@ -337,11 +397,13 @@ Texture loadTexture(const std::filesystem::path& path);
  * @param[in] attributes Vertex attributes
  * @param[in] buffer Buffer handle
  * @param[in] types Primitive type order
+ * @param[in] offset (Optional) Offset of the vertex data inside the buffer in bytes
  * @return Vertex buffer bindings
  */
 VertexBufferBindings loadVertexBufferBindings(const std::vector<VertexAttribute> &attributes,
 											  const BufferHandle &buffer,
-											  const std::vector<PrimitiveType> &types);
+											  const std::vector<PrimitiveType> &types,
+											  size_t offset = 0);
 
 /** @} */
 
@@ -0,0 +1,628 @@
+
+#include "CompressedTexture.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cstring>
+#include <mutex>
+#include <span>
+#include <vulkan/vulkan.hpp>
+#include <vkcv/File.hpp>
+#include <vkcv/Logger.hpp>
+
+#ifdef VKCV_ASSET_LOADER_BASISU
+#include <transcoder/basisu_transcoder.h>
+#endif
+
+namespace vkcv::asset {
+	
+	/**
+	 * The identifier at the start of each KTX2-file.
+	 */
+	static const uint8_t KTX2_IDENTIFIER [12] = {
+			0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+	};
+	
+	/**
+	 * The identifier at the start of each DDS-file ("DDS ").
+	 */
+	static const uint8_t DDS_IDENTIFIER [4] = {
+			0x44, 0x44, 0x53, 0x20
+	};
+	
+	constexpr size_t KTX2_HEADER_SIZE = 80;
+	constexpr size_t KTX2_LEVEL_SIZE = 24;
+	
+	constexpr uint32_t KTX2_SUPERCOMPRESSION_NONE = 0;
+	
+	constexpr size_t DDS_HEADER_SIZE = 128;
+	constexpr size_t DDS_HEADER_DX10_SIZE = 20;
+	
+	constexpr uint32_t DDS_PIXEL_FORMAT_FOURCC = 0x4;
+	constexpr uint32_t DDS_PIXEL_FORMAT_RGB = 0x40;
+	constexpr uint32_t DDS_CAPS2_CUBEMAP = 0x200;
+	constexpr uint32_t DDS_DX10_MISC_CUBEMAP = 0x4;
+	
+	constexpr uint32_t makeFourCC(char a, char b, char c, char d) {
+		return (
+				static_cast<uint32_t>(a) |
+				(static_cast<uint32_t>(b) << 8) |
+				(static_cast<uint32_t>(c) << 16) |
+				(static_cast<uint32_t>(d) << 24)
+		);
+	}
+	
+	static uint32_t readUint32(const uint8_t* data, size_t offset) {
+		uint32_t value;
+		memcpy(&value, data + offset, sizeof(value));
+		return value;
+	}
+	
+	static uint64_t readUint64(const uint8_t* data, size_t offset) {
+		uint64_t value;
+		memcpy(&value, data + offset, sizeof(value));
+		return value;
+	}
+	
+	static bool hasIdentifier(std::span<const uint8_t> data, const uint8_t* identifier, size_t size) {
+		return (data.size() >= size) && (memcmp(data.data(), identifier, size) == 0);
+	}
+	
+	bool isCompressedTexture(const Texture &texture) {
+		if (texture.path.empty()) {
+			const std::span<const uint8_t> data (texture.data);
+			
+			return (
+					hasIdentifier(data, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) ||
+					hasIdentifier(data, DDS_IDENTIFIER, sizeof(DDS_IDENTIFIER))
+			);
+		}
+		
+		std::string extension = texture.path.extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) {
+			return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+		});
+		
+		return (extension == ".ktx2") || (extension == ".dds");
+	}
+	
+	/**
+	 * Returns the amount of channels stored in texels or blocks of a given
+	 * format which images can be filled with.
+	 * @param format	The VkFormat of the texels or blocks
+	 * @return	The amount of channels or zero for unsupported formats
+	 */
+	static int getFormatChannels(int format) {
+		switch (format) {
+			case VK_FORMAT_R8_UNORM:
+			case VK_FORMAT_R16_UNORM:
+			case VK_FORMAT_R32_UINT:
+			case VK_FORMAT_R32_SFLOAT:
+			case VK_FORMAT_BC4_UNORM_BLOCK:
+			case VK_FORMAT_BC4_SNORM_BLOCK:
+			case VK_FORMAT_EAC_R11_UNORM_BLOCK:
+			case VK_FORMAT_EAC_R11_SNORM_BLOCK:
+				return 1;
+			case VK_FORMAT_R8G8_UNORM:
+			case VK_FORMAT_BC5_UNORM_BLOCK:
+			case VK_FORMAT_BC5_SNORM_BLOCK:
+			case VK_FORMAT_EAC_R11G11_UNORM_BLOCK:
+			case VK_FORMAT_EAC_R11G11_SNORM_BLOCK:
+				return 2;
+			case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+			case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+			case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+			case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+			case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+			case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+				return 3;
+			case VK_FORMAT_R8G8B8A8_UNORM:
+			case VK_FORMAT_R8G8B8A8_SRGB:
+			case VK_FORMAT_B8G8R8A8_UNORM:
+			case VK_FORMAT_B8G8R8A8_SRGB:
+			case VK_FORMAT_R16G16B16A16_UNORM:
+			case VK_FORMAT_R16G16B16A16_SFLOAT:
+			case VK_FORMAT_R32G32B32A32_SFLOAT:
+			case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+			case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+			case VK_FORMAT_BC2_UNORM_BLOCK:
+			case VK_FORMAT_BC2_SRGB_BLOCK:
+			case VK_FORMAT_BC3_UNORM_BLOCK:
+			case VK_FORMAT_BC3_SRGB_BLOCK:
+			case VK_FORMAT_BC7_UNORM_BLOCK:
+			case VK_FORMAT_BC7_SRGB_BLOCK:
+			case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
+			case VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:
+			case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+			case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+			case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+			case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:
+			case VK_FORMAT_ASTC_5x4_UNORM_BLOCK:
+			case VK_FORMAT_ASTC_5x4_SRGB_BLOCK:
+			case VK_FORMAT_ASTC_5x5_UNORM_BLOCK:
+			case VK_FORMAT_ASTC_5x5_SRGB_BLOCK:
+			case VK_FORMAT_ASTC_6x5_UNORM_BLOCK:
+			case VK_FORMAT_ASTC_6x5_SRGB_BLOCK:
+			case VK_FORMAT_ASTC_6x6_UNORM_BLOCK:
+			case VK_FORMAT_ASTC_6x6_SRGB_BLOCK:
+			case VK_FORMAT_ASTC_8x5_UNORM_BLOCK:
+			case VK_FORMAT_ASTC_8x5_SRGB_BLOCK:
+			case VK_FORMAT_ASTC_8x6_UNORM_BLOCK:
+			case VK_FORMAT_ASTC_8x6_SRGB_BLOCK:
+			case VK_FORMAT_ASTC_8x8_UNORM_BLOCK:
+			case VK_FORMAT_ASTC_8x8_SRGB_BLOCK:
+			case VK_FORMAT_ASTC_10x5_UNORM_BLOCK:
+			case VK_FORMAT_ASTC_10x5_SRGB_BLOCK:
+			case VK_FORMAT_ASTC_10x6_UNORM_BLOCK:
+			case VK_FORMAT_ASTC_10x6_SRGB_BLOCK:
+			case VK_FORMAT_ASTC_10x8_UNORM_BLOCK:
+			case VK_FORMAT_ASTC_10x8_SRGB_BLOCK:
+			case VK_FORMAT_ASTC_10x10_UNORM_BLOCK:
+			case VK_FORMAT_ASTC_10x10_SRGB_BLOCK:
+			case VK_FORMAT_ASTC_12x10_UNORM_BLOCK:
+			case VK_FORMAT_ASTC_12x10_SRGB_BLOCK:
+			case VK_FORMAT_ASTC_12x12_UNORM_BLOCK:
+			case VK_FORMAT_ASTC_12x12_SRGB_BLOCK:
+				return 4;
+			default:
+				return 0;
+		}
+	}
+	
+	/**
+	 * Returns the amount of mip levels of a full mip chain for a given extent.
+	 * @param width	The width of the largest mip level
+	 * @param height	The height of the largest mip level
+	 * @return	The amount of mip levels
+	 */
+	static uint32_t getMaxLevels(uint32_t width, uint32_t height) {
+		return static_cast<uint32_t>(std::bit_width(std::max<uint32_t>(std::max(width, height), 1)));
+	}
+	
+	/**
+	 * Returns the size in bytes of a mip level with a given extent stored in
+	 * a given format which can be loaded from DDS-files.
+	 * @param format	The VkFormat of the mip level
+	 * @param width	The width of the mip level
+	 * @param height	The height of the mip level
+	 * @return	The size of the mip level in bytes or zero for unknown formats
+	 */
+	static size_t getDDSLevelSize(int format, uint32_t width, uint32_t height) {
+		const size_t blocks = (
+				static_cast<size_t>((width + 3) / 4) *
+				static_cast<size_t>((height + 3) / 4)
+		);
+		
+		switch (format) {
+			case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+			case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+			case VK_FORMAT_BC4_UNORM_BLOCK:
+			case VK_FORMAT_BC4_SNORM_BLOCK:
+				return blocks * 8;
+			case VK_FORMAT_BC2_UNORM_BLOCK:
+			case VK_FORMAT_BC2_SRGB_BLOCK:
+			case VK_FORMAT_BC3_UNORM_BLOCK:
+			case VK_FORMAT_BC3_SRGB_BLOCK:
+			case VK_FORMAT_BC5_UNORM_BLOCK:
+			case VK_FORMAT_BC5_SNORM_BLOCK:
+			case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+			case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+			case VK_FORMAT_BC7_UNORM_BLOCK:
+			case VK_FORMAT_BC7_SRGB_BLOCK:
+				return blocks * 16;
+			case VK_FORMAT_R8G8B8A8_UNORM:
+			case VK_FORMAT_R8G8B8A8_SRGB:
+			case VK_FORMAT_B8G8R8A8_UNORM:
+			case VK_FORMAT_B8G8R8A8_SRGB:
+				return static_cast<size_t>(width) * height * 4;
+			case VK_FORMAT_R16G16B16A16_SFLOAT:
+				return static_cast<size_t>(width) * height * 8;
+			case VK_FORMAT_R32G32B32A32_SFLOAT:
+				return static_cast<size_t>(width) * height * 16;
+			default:
+				return 0;
+		}
+	}
+	
+	/**
+	 * Translates a DXGI format from the extended header of a DDS-file.
+	 * @param dxgiFormat	The DXGI format
+	 * @return	The matching VkFormat or VK_FORMAT_UNDEFINED
+	 */
+	static int getFormatFromDXGI(uint32_t dxgiFormat) {
+		switch (dxgiFormat) {
+			case 2:
+				return VK_FORMAT_R32G32B32A32_SFLOAT;
+			case 10:
+				return VK_FORMAT_R16G16B16A16_SFLOAT;
+			case 28:
+				return VK_FORMAT_R8G8B8A8_UNORM;
+			case 29:
+				return VK_FORMAT_R8G8B8A8_SRGB;
+			case 71:
+				return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+			case 72:
+				return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+			case 74:
+				return VK_FORMAT_BC2_UNORM_BLOCK;
+			case 75:
+				return VK_FORMAT_BC2_SRGB_BLOCK;
+			case 77:
+				return VK_FORMAT_BC3_UNORM_BLOCK;
+			case 78:
+				return VK_FORMAT_BC3_SRGB_BLOCK;
+			case 80:
+				return VK_FORMAT_BC4_UNORM_BLOCK;
+			case 81:
+				return VK_FORMAT_BC4_SNORM_BLOCK;
+			case 83:
+				return VK_FORMAT_BC5_UNORM_BLOCK;
+			case 84:
+				return VK_FORMAT_BC5_SNORM_BLOCK;
+			case 87:
+				return VK_FORMAT_B8G8R8A8_UNORM;
+			case 91:
+				return VK_FORMAT_B8G8R8A8_SRGB;
+			case 95:
+				return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+			case 96:
+				return VK_FORMAT_BC6H_SFLOAT_BLOCK;
+			case 98:
+				return VK_FORMAT_BC7_UNORM_BLOCK;
+			case 99:
+				return VK_FORMAT_BC7_SRGB_BLOCK;
+			default:
+				return VK_FORMAT_UNDEFINED;
+		}
+	}
+	
+	/**
+	 * Translates the legacy pixel format from the header of a DDS-file.
+	 * @param header	The header of the DDS-file
+	 * @return	The matching VkFormat or VK_FORMAT_UNDEFINED
+	 */
+	static int getFormatFromDDS(const uint8_t* header) {
+		const uint32_t flags = readUint32(header, 80);
+		
+		if (flags & DDS_PIXEL_FORMAT_FOURCC) {
+			switch (readUint32(header, 84)) {
+				case makeFourCC('D', 'X', 'T', '1'):
+					return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+				case makeFourCC('D', 'X', 'T', '2'):
+				case makeFourCC('D', 'X', 'T', '3'):
+					return VK_FORMAT_BC2_UNORM_BLOCK;
+				case makeFourCC('D', 'X', 'T', '4'):
+				case makeFourCC('D', 'X', 'T', '5'):
+					return VK_FORMAT_BC3_UNORM_BLOCK;
+				case makeFourCC('A', 'T', 'I', '1'):
+				case makeFourCC('B', 'C', '4', 'U'):
+					return VK_FORMAT_BC4_UNORM_BLOCK;
+				case makeFourCC('B', 'C', '4', 'S'):
+					return VK_FORMAT_BC4_SNORM_BLOCK;
+				case makeFourCC('A', 'T', 'I', '2'):
+				case makeFourCC('B', 'C', '5', 'U'):
+					return VK_FORMAT_BC5_UNORM_BLOCK;
+				case makeFourCC('B', 'C', '5', 'S'):
+					return VK_FORMAT_BC5_SNORM_BLOCK;
+				default:
+					return VK_FORMAT_UNDEFINED;
+			}
+		}
+		
+		if ((flags & DDS_PIXEL_FORMAT_RGB) && (readUint32(header, 88) == 32)) {
+			const uint32_t redMask = readUint32(header, 92);
+			const uint32_t blueMask = readUint32(header, 100);
+			
+			if ((redMask == 0x000000FF) && (blueMask == 0x00FF0000)) {
+				return VK_FORMAT_R8G8B8A8_UNORM;
+			} else
+			if ((redMask == 0x00FF0000) && (blueMask == 0x000000FF)) {
+				return VK_FORMAT_B8G8R8A8_UNORM;
+			}
+		}
+		
+		return VK_FORMAT_UNDEFINED;
+	}
+	
+	static int loadDDS(Texture &texture, std::span<const uint8_t> data) {
+		if (data.size() < DDS_HEADER_SIZE) {
+			vkcv_log(LogLevel::ERROR, "DDS header is incomplete (%s)",
+					 texture.path.string().c_str());
+			return ASSET_ERROR;
+		}
+		
+		const uint8_t* header = data.data();
+		
+		const uint32_t height = readUint32(header, 12);
+		const uint32_t width = readUint32(header, 16);
+		const uint32_t depth = readUint32(header, 24);
+		const uint32_t levels = std::max<uint32_t>(readUint32(header, 28), 1);
+		const uint32_t caps2 = readUint32(header, 112);
+		
+		size_t offset = DDS_HEADER_SIZE;
+		int format;
+		
+		if ((readUint32(header, 80) & DDS_PIXEL_FORMAT_FOURCC) &&
+			(readUint32(header, 84) == makeFourCC('D', 'X', '1', '0'))) {
+			if (data.size() < DDS_HEADER_SIZE + DDS_HEADER_DX10_SIZE) {
+				vkcv_log(LogLevel::ERROR, "DDS header is incomplete (%s)",
+						 texture.path.string().c_str());
+				return ASSET_ERROR;
+			}
+			
+			if ((readUint32(header, DDS_HEADER_SIZE + 8) & DDS_DX10_MISC_CUBEMAP) ||
+				(readUint32(header, DDS_HEADER_SIZE + 12) > 1)) {
+				vkcv_log(LogLevel::ERROR, "Only 2D textures are supported from DDS (%s)",
+						 texture.path.string().c_str());
+				return ASSET_ERROR;
+			}
+			
+			format = getFormatFromDXGI(readUint32(header, DDS_HEADER_SIZE));
+			offset += DDS_HEADER_DX10_SIZE;
+		} else {
+			format = getFormatFromDDS(header);
+		}
+		
+		if ((depth > 1) || (caps2 & DDS_CAPS2_CUBEMAP)) {
+			vkcv_log(LogLevel::ERROR, "Only 2D textures are supported from DDS (%s)",
+					 texture.path.string().c_str());
+			return ASSET_ERROR;
+		}
+		
+		if ((width == 0) || (height == 0) || (format == VK_FORMAT_UNDEFINED)) {
+			vkcv_log(LogLevel::ERROR, "DDS texture format is not supported (%s)",
+					 texture.path.string().c_str());
+			return ASSET_ERROR;
+		}
+		
+		if (levels > getMaxLevels(width, height)) {
+			vkcv_log(LogLevel::ERROR, "DDS header is invalid (%s)",
+					 texture.path.string().c_str());
+			return ASSET_ERROR;
+		}
+		
+		// the mip levels of a single 2D texture are already stored after another
+		size_t size = 0;
+		for (uint32_t i = 0; i < levels; i++) {
+			size += getDDSLevelSize(
+					format,
+					std::max<uint32_t>(width >> i, 1),
+					std::max<uint32_t>(height >> i, 1)
+			);
+		}
+		
+		if (offset + size > data.size()) {
+			vkcv_log(LogLevel::ERROR, "DDS texture data is incomplete (%s)",
+					 texture.path.string().c_str());
+			return ASSET_ERROR;
+		}
+		
+		texture.width = static_cast<int>(width);
+		texture.height = static_cast<int>(height);
+		texture.channels = getFormatChannels(format);
+		texture.format = format;
+		texture.levels = static_cast<int>(levels);
+		texture.data.assign(data.begin() + offset, data.begin() + offset + size);
+		return ASSET_SUCCESS;
+	}
+	
+#ifdef VKCV_ASSET_LOADER_BASISU
+	/**
+	 * Selects the format to transcode a texture with Basis Universal
+	 * compression into.
+	 * @param transcodeFormats	The supported VkFormats in order of preference
+	 * @param format	The selected VkFormat, VK_FORMAT_UNDEFINED for RGBA pixels
+	 * @return	The matching target format of the transcoder
+	 */
+	static basist::transcoder_texture_format selectTranscodeFormat(
+			const std::vector<int> &transcodeFormats, int &format) {
+		for (const auto& transcodeFormat : transcodeFormats) {
+			format = transcodeFormat;
+			
+			switch (transcodeFormat) {
+				case VK_FORMAT_BC7_UNORM_BLOCK:
+				case VK_FORMAT_BC7_SRGB_BLOCK:
+					return basist::transcoder_texture_format::cTFBC7_RGBA;
+				case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+				case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:
+					return basist::transcoder_texture_format::cTFASTC_4x4_RGBA;
+				case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+				case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+					return basist::transcoder_texture_format::cTFETC2_RGBA;
+				case VK_FORMAT_BC3_UNORM_BLOCK:
+				case VK_FORMAT_BC3_SRGB_BLOCK:
+					return basist::transcoder_texture_format::cTFBC3_RGBA;
+				default:
+					break;
+			}
+		}
+		
+		format = VK_FORMAT_UNDEFINED;
+		return basist::transcoder_texture_format::cTFRGBA32;
+	}
+	
+	static int transcodeKTX2(Texture &texture, std::span<const uint8_t> data,
+							 const std::vector<int> &transcodeFormats) {
+		static std::once_flag initialized;
+		std::call_once(initialized, basist::basisu_transcoder_init);
+		
+		basist::ktx2_transcoder transcoder;
+		
+		if ((!transcoder.init(data.data(), static_cast<uint32_t>(data.size()))) ||
+			(!transcoder.start_transcoding())) {
+			vkcv_log(LogLevel::ERROR, "KTX2 texture could not be transcoded (%s)",
+					 texture.path.string().c_str());
+			return ASSET_ERROR;
+		}
+		
+		if ((transcoder.get_layers() > 1) || (transcoder.get_faces() > 1)) {
+			vkcv_log(LogLevel::ERROR, "Only 2D textures are supported from KTX2 (%s)",
+					 texture.path.string().c_str());
+			return ASSET_ERROR;
+		}
+		
+		int format;
+		const auto target = selectTranscodeFormat(transcodeFormats, format);
+		const uint32_t unitSize = basist::basis_get_bytes_per_block_or_pixel(target);
+		const uint32_t levels = std::max<uint32_t>(transcoder.get_levels(), 1);
+		
+		std::vector<uint8_t> levelData;
+		
+		for (uint32_t i = 0; i < levels; i++) {
+			basist::ktx2_image_level_info info;
+			
+			if (!transcoder.get_image_level_info(info, i, 0, 0)) {
+				vkcv_log(LogLevel::ERROR, "KTX2 texture level %u is missing (%s)",
+						 i, texture.path.string().c_str());
+				return ASSET_ERROR;
+			}
+			
+			const uint32_t units = basist::basis_transcoder_format_is_uncompressed(target)?
+					info.m_orig_width * info.m_orig_height : info.m_total_blocks;
+			
+			const size_t offset = levelData.size();
+			levelData.resize(offset + static_cast<size_t>(units) * unitSize);
+			
+			if (!transcoder.transcode_image_level(i, 0, 0, levelData.data() + offset,
+												  units, target)) {
+				vkcv_log(LogLevel::ERROR, "KTX2 texture level %u could not be transcoded (%s)",
+						 i, texture.path.string().c_str());
+				return ASSET_ERROR;
+			}
+		}
+		
+		texture.width = static_cast<int>(transcoder.get_width());
+		texture.height = static_cast<int>(transcoder.get_height());
+		texture.channels = transcoder.get_has_alpha()? 4 : 3;
+		texture.format = format;
+		texture.levels = static_cast<int>(levels);
+		texture.data = std::move(levelData);
+		return ASSET_SUCCESS;
+	}
+#endif
+	
+	static int loadKTX2(Texture &texture, std::span<const uint8_t> data,
+						const std::vector<int> &transcodeFormats) {
+		if (data.size() < KTX2_HEADER_SIZE) {
+			vkcv_log(LogLevel::ERROR, "KTX2 header is incomplete (%s)",
+					 texture.path.string().c_str());
+			return ASSET_ERROR;
+		}
+		
+		const uint8_t* header = data.data();
+		
+		const auto format = static_cast<int>(readUint32(header, 12));
+		const uint32_t width = readUint32(header, 20);
+		const uint32_t height = readUint32(header, 24);
+		const uint32_t depth = readUint32(header, 28);
+		const uint32_t layers = readUint32(header, 32);
+		const uint32_t faces = readUint32(header, 36);
+		const uint32_t levels = std::max<uint32_t>(readUint32(header, 40), 1);
+		const uint32_t supercompression = readUint32(header, 44);
+		
+		// textures with Basis Universal compression have an undefined format
+		if (format == VK_FORMAT_UNDEFINED) {
+#ifdef VKCV_ASSET_LOADER_BASISU
+			return transcodeKTX2(texture, data, transcodeFormats);
+#else
+			vkcv_log(LogLevel::ERROR, "KTX2 texture requires the Basis Universal transcoder (%s)",
+					 texture.path.string().c_str());
+			return ASSET_ERROR;
+#endif
+		}
+		
+		if (supercompression != KTX2_SUPERCOMPRESSION_NONE) {
+			vkcv_log(LogLevel::ERROR, "KTX2 supercompression is not supported (%s)",
+					 texture.path.string().c_str());
+			return ASSET_ERROR;
+		}
+		
+		if ((depth > 1) || (layers > 1) || (faces > 1)) {
+			vkcv_log(LogLevel::ERROR, "Only 2D textures are supported from KTX2 (%s)",
+					 texture.path.string().c_str());
+			return ASSET_ERROR;
+		}
+		
+		// the format needs to be known to split the data into mip levels for uploading
+		if (getFormatChannels(format) == 0) {
+			vkcv_log(LogLevel::ERROR, "KTX2 texture format is not supported (%s)",
+					 texture.path.string().c_str());
+			return ASSET_ERROR;
+		}
+		
+		if ((width == 0) || (height == 0) || (levels > getMaxLevels(width, height)) ||
+			(KTX2_HEADER_SIZE + levels * KTX2_LEVEL_SIZE > data.size())) {
+			vkcv_log(LogLevel::ERROR, "KTX2 header is invalid (%s)",
+					 texture.path.string().c_str());
+			return ASSET_ERROR;
+		}
+		
+		// the level index starts with the largest mip level while the data ends with it
+		std::vector<uint8_t> levelData;
+		
+		for (uint32_t i = 0; i < levels; i++) {
+			const size_t levelIndex = KTX2_HEADER_SIZE + i * KTX2_LEVEL_SIZE;
+			const uint64_t offset = readUint64(header, levelIndex);
+			const uint64_t length = readUint64(header, levelIndex + 8);
+			
+			if ((offset > data.size()) || (length > data.size() - offset)) {
+				vkcv_log(LogLevel::ERROR, "KTX2 texture level %u is out of bounds (%s)",
+						 i, texture.path.string().c_str());
+				return ASSET_ERROR;
+			}
+			
+			levelData.insert(levelData.end(), data.begin() + offset, data.begin() + offset + length);
+		}
+		
+		texture.width = static_cast<int>(width);
+		texture.height = static_cast<int>(height);
+		texture.channels = getFormatChannels(format);
+		texture.format = format;
+		texture.levels = static_cast<int>(levels);
+		texture.data = std::move(levelData);
+		return ASSET_SUCCESS;
+	}
+	
+	int loadCompressedTexture(Texture &texture, const std::vector<int> &transcodeFormats) {
+		Vector<char> content;
+		std::span<const uint8_t> data;
+		
+		if (texture.path.empty()) {
+			data = std::span<const uint8_t>(texture.data);
+		} else
+		if (readContentFromFile(texture.path, content)) {
+			data = std::span<const uint8_t>(
+					reinterpret_cast<const uint8_t*>(content.data()),
+					content.size()
+			);
+		} else {
+			return ASSET_ERROR;
+		}
+		
+		// the texture data gets replaced, so the embedded data needs to stay valid meanwhile
+		Texture loaded;
+		loaded.path = texture.path;
+		loaded.sampler = texture.sampler;
+		
+		int result;
+		
+		if (hasIdentifier(data, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER))) {
+			result = loadKTX2(loaded, data, transcodeFormats);
+		} else
+		if (hasIdentifier(data, DDS_IDENTIFIER, sizeof(DDS_IDENTIFIER))) {
+			result = loadDDS(loaded, data);
+		} else {
+			vkcv_log(LogLevel::ERROR, "Texture is neither a KTX2- nor a DDS-file (%s)",
+					 texture.path.string().c_str());
+			result = ASSET_ERROR;
+		}
+		
+		if (result == ASSET_SUCCESS) {
+			texture = std::move(loaded);
+		}
+		
+		return result;
+	}
+
+}
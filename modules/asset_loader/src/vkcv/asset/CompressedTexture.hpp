@@ -0,0 +1,35 @@
+#pragma once
+/**
+ * @authors Tobias Frisch
+ * @file src/vkcv/asset/CompressedTexture.hpp
+ * @brief Loading of block-compressed textures from KTX2- and DDS-files.
+ */
+
+#include <vector>
+
+#include "vkcv/asset/asset_loader.hpp"
+
+namespace vkcv::asset {
+
+	/**
+	 * Returns whether a texture is stored in a KTX2- or DDS-file judging by
+	 * the extension of its path or the identifier at the start of its data.
+	 *
+	 * @param[in] texture Texture struct describing the texture
+	 * @return True if the texture is stored in a KTX2- or DDS-file, otherwise false
+	 */
+	bool isCompressedTexture(const Texture &texture);
+
+	/**
+	 * Loads all mip levels of a texture from a KTX2- or DDS-file without
+	 * decoding its blocks. Textures of KTX2-files with Basis Universal
+	 * compression get transcoded into the first of the given formats they
+	 * can be transcoded into, otherwise into RGBA pixels.
+	 *
+	 * @param[in,out] texture Texture struct describing the texture
+	 * @param[in] transcodeFormats Supported VkFormats to transcode into in order of preference
+	 * @return ASSET_ERROR on failure, otherwise ASSET_SUCCESS
+	 */
+	int loadCompressedTexture(Texture &texture, const std::vector<int> &transcodeFormats);
+
+}
@@ -0,0 +1,195 @@
+
+#include "vkcv/asset/TextureLoader.hpp"
+#include "CompressedTexture.hpp"
+
+#include <algorithm>
+#include <vulkan/vulkan.hpp>
+#include <vkcv/Logger.hpp>
+
+// the implementation of stb_image is already compiled with the asset loader
+#undef STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+namespace vkcv::asset {
+	
+	/**
+	 * Decodes a texture from its path or from its encoded data into RGBA
+	 * pixels owned by the returned struct. Textures from KTX2- or DDS-files
+	 * are loaded with their compressed blocks instead.
+	 * @param index	The index of the requested texture
+	 * @param texture	The texture to decode
+	 * @param transcodeFormats	The supported formats to transcode into
+	 * @return	The decoded texture without pixels on failure
+	 */
+	static DecodedTexture decodeTexture(size_t index, Texture &texture,
+										const std::vector<int> &transcodeFormats) {
+		DecodedTexture decoded {};
+		decoded.index = index;
+		
+		if (isCompressedTexture(texture)) {
+			if (loadCompressedTexture(texture, transcodeFormats) != ASSET_SUCCESS) {
+				return decoded;
+			}
+			
+			auto data = std::make_shared<std::vector<uint8_t>>(std::move(texture.data));
+			
+			decoded.width = texture.width;
+			decoded.height = texture.height;
+			decoded.channels = texture.channels;
+			decoded.format = texture.format;
+			decoded.levels = texture.levels;
+			decoded.size = data->size();
+			
+			// the pixels share the ownership of the vector containing them
+			decoded.pixels = std::shared_ptr<uint8_t>(data, data->data());
+			return decoded;
+		}
+		
+		uint8_t* pixels;
+		
+		if (texture.path.empty()) {
+			pixels = stbi_load_from_memory(
+					texture.data.data(),
+					static_cast<int>(texture.data.size()),
+					&decoded.width,
+					&decoded.height,
+					&decoded.channels, 4
+			);
+		} else {
+			pixels = stbi_load(
+					texture.path.string().c_str(),
+					&decoded.width,
+					&decoded.height,
+					&decoded.channels, 4
+			);
+		}
+		
+		if (!pixels) {
+			vkcv_log(LogLevel::ERROR, "Texture could not be loaded from '%s'",
+					 texture.path.string().c_str());
+			
+			decoded.width = 0;
+			decoded.height = 0;
+			decoded.channels = 0;
+			return decoded;
+		}
+		
+		decoded.format = VK_FORMAT_UNDEFINED;
+		decoded.levels = 1;
+		decoded.size = static_cast<size_t>(decoded.width) * decoded.height * 4;
+		
+		// the pixels stay in the memory allocated while decoding to avoid a copy
+		decoded.pixels = std::shared_ptr<uint8_t>(pixels, stbi_image_free);
+		return decoded;
+	}
+	
+	TextureLoader::TextureLoader(size_t threadCount, size_t maxDecoded,
+								 std::vector<int> transcodeFormats) :
+	m_threads(),
+	m_mutex(),
+	m_requested(),
+	m_requests(),
+	m_decoded(),
+	m_transcodeFormats(std::move(transcodeFormats)),
+	m_maxDecoded(std::max<size_t>(maxDecoded, 1)),
+	m_decoding(0),
+	m_running(true) {
+		if (threadCount == 0) {
+			threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 2) - 1;
+		}
+		
+		m_threads.reserve(threadCount);
+		
+		for (size_t i = 0; i < threadCount; i++) {
+			m_threads.emplace_back(&TextureLoader::work, this);
+		}
+	}
+	
+	TextureLoader::~TextureLoader() {
+		{
+			std::lock_guard<std::mutex> lock (m_mutex);
+			m_running = false;
+			m_requests.clear();
+		}
+		
+		m_requested.notify_all();
+		
+		for (auto& thread : m_threads) {
+			thread.join();
+		}
+	}
+	
+	void TextureLoader::work() {
+		std::unique_lock<std::mutex> lock (m_mutex);
+		
+		while (true) {
+			m_requested.wait(lock, [this]() {
+				return (!m_running) || ((!m_requests.empty()) &&
+						(m_decoded.size() + m_decoding < m_maxDecoded));
+			});
+			
+			if (!m_running) {
+				break;
+			}
+			
+			auto next = std::min_element(m_requests.begin(), m_requests.end(),
+										 [](const Request& first, const Request& second) {
+				return first.priority < second.priority;
+			});
+			
+			Request request = std::move(*next);
+			m_requests.erase(next);
+			m_decoding++;
+			
+			lock.unlock();
+			DecodedTexture decoded = decodeTexture(request.index, request.texture,
+												   m_transcodeFormats);
+			lock.lock();
+			
+			m_decoding--;
+			m_decoded.push_back(std::move(decoded));
+		}
+	}
+	
+	void TextureLoader::request(size_t index, Texture texture, float priority) {
+		{
+			std::lock_guard<std::mutex> lock (m_mutex);
+			m_requests.push_back({ index, priority, std::move(texture) });
+		}
+		
+		m_requested.notify_one();
+	}
+	
+	void TextureLoader::prioritize(size_t index, float priority) {
+		std::lock_guard<std::mutex> lock (m_mutex);
+		
+		for (auto& request : m_requests) {
+			if (request.index == index) {
+				request.priority = priority;
+			}
+		}
+	}
+	
+	bool TextureLoader::poll(DecodedTexture &texture) {
+		{
+			std::lock_guard<std::mutex> lock (m_mutex);
+			
+			if (m_decoded.empty()) {
+				return false;
+			}
+			
+			texture = std::move(m_decoded.front());
+			m_decoded.pop_front();
+		}
+		
+		// a worker can continue decoding since the amount of decoded textures decreased
+		m_requested.notify_one();
+		return true;
+	}
+	
+	size_t TextureLoader::getPendingCount() const {
+		std::lock_guard<std::mutex> lock (m_mutex);
+		return m_requests.size() + m_decoding + m_decoded.size();
+	}
+	
+}
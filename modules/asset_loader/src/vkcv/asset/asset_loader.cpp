@@ -1,4 +1,5 @@
 #include "vkcv/asset/asset_loader.hpp"
+#include "CompressedTexture.hpp"
 #include <iostream>
 #include <cstring>	// memcpy(3)
 #include <set>
@@ -9,7 +10,140 @@
 #include <vkcv/Logger.hpp>
 #include <algorithm>
 
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace vkcv::asset {
+	
+	/**
+	 * A file mapped read-only into memory, which gets unmapped on destruction.
+	 */
+	struct MappedFile {
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+		
+#ifdef _WIN32
+		HANDLE file = INVALID_HANDLE_VALUE;
+		HANDLE mapping = nullptr;
+#endif
+		
+		MappedFile() = default;
+		MappedFile(const MappedFile &other) = delete;
+		MappedFile& operator=(const MappedFile &other) = delete;
+		
+		~MappedFile() {
+#ifdef _WIN32
+			if (data) {
+				UnmapViewOfFile(data);
+			}
+			
+			if (mapping) {
+				CloseHandle(mapping);
+			}
+			
+			if (file != INVALID_HANDLE_VALUE) {
+				CloseHandle(file);
+			}
+#else
+			if (data) {
+				munmap(const_cast<uint8_t*>(data), size);
+			}
+#endif
+		}
+	};
+	
+	/**
+	 * Maps the file at the given path read-only into memory.
+	 * @param path	The path to the file
+	 * @return	The mapped file or nullptr on failure
+	 */
+	static std::shared_ptr<MappedFile> mapFile(const std::filesystem::path &path) {
+		auto file = std::make_shared<MappedFile>();
+		
+#ifdef _WIN32
+		file->file = CreateFileW(
+				path.c_str(),
+				GENERIC_READ,
+				FILE_SHARE_READ,
+				nullptr,
+				OPEN_EXISTING,
+				FILE_ATTRIBUTE_NORMAL,
+				nullptr
+		);
+		
+		LARGE_INTEGER size;
+		if ((file->file == INVALID_HANDLE_VALUE) || (!GetFileSizeEx(file->file, &size)) ||
+			(size.QuadPart <= 0)) {
+			vkcv_log(LogLevel::ERROR, "File could not be opened (%s)",
+					 path.string().c_str());
+			return nullptr;
+		}
+		
+		file->mapping = CreateFileMappingW(file->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		
+		if (file->mapping) {
+			file->data = static_cast<const uint8_t*>(
+					MapViewOfFile(file->mapping, FILE_MAP_READ, 0, 0, 0)
+			);
+		}
+		
+		if (!file->data) {
+			vkcv_log(LogLevel::ERROR, "File could not be mapped (%s)",
+					 path.string().c_str());
+			return nullptr;
+		}
+		
+		file->size = static_cast<size_t>(size.QuadPart);
+#else
+		const int fd = open(path.c_str(), O_RDONLY);
+		
+		struct stat status {};
+		if ((fd == -1) || (fstat(fd, &status) != 0) || (status.st_size <= 0)) {
+			vkcv_log(LogLevel::ERROR, "File could not be opened (%s)",
+					 path.string().c_str());
+			
+			if (fd != -1) {
+				close(fd);
+			}
+			
+			return nullptr;
+		}
+		
+		void* data = mmap(
+				nullptr,
+				static_cast<size_t>(status.st_size),
+				PROT_READ,
+				MAP_PRIVATE,
+				fd,
+				0
+		);
+		
+		close(fd);
+		
+		if (data == MAP_FAILED) {
+			vkcv_log(LogLevel::ERROR, "File could not be mapped (%s)",
+					 path.string().c_str());
+			return nullptr;
+		}
+		
+		file->data = static_cast<const uint8_t*>(data);
+		file->size = static_cast<size_t>(status.st_size);
+#endif
+		
+		return file;
+	}
 
 	/**
 	 * This function unrolls nested exceptions via recursion and prints them
@@ -239,6 +373,22 @@ namespace vkcv::asset {
 	bool Material::hasTexture(const PBRTextureTarget target) const {
 		return textureMask & bitflag(target);
 	}
+	
+	std::span<const uint8_t> VertexGroup::getIndexData() const {
+		if (indexBuffer.data.empty()) {
+			return indexBuffer.mapped;
+		}
+		
+		return indexBuffer.data;
+	}
+	
+	std::span<const uint8_t> VertexGroup::getVertexData() const {
+		if (vertexBuffer.data.empty()) {
+			return vertexBuffer.mapped;
+		}
+		
+		return vertexBuffer.data;
+	}
 
 	/**
 	 * This function translates a given fx-gltf-sampler-wrapping-mode-enum to its vulkan sampler-adress-mode counterpart.
@@ -364,14 +514,40 @@ namespace vkcv::asset {
 		
 		return dst;
 	}
-
+	
+	/**
+	 * Returns the index of the image used as source of a texture. Images
+	 * in KTX2- or DDS-files referenced by the extensions KHR_texture_basisu
+	 * or MSFT_texture_dds are preferred over the fallback source.
+	 */
+	static int getTextureSource(const fx::gltf::Texture &texture) {
+		const auto extensions = texture.extensionsAndExtras.find("extensions");
+		
+		if ((extensions == texture.extensionsAndExtras.end()) || (!extensions->is_object())) {
+			return texture.source;
+		}
+		
+		for (const auto& name : { "KHR_texture_basisu", "MSFT_texture_dds" }) {
+			const auto extension = extensions->find(name);
+			
+			if ((extension != extensions->end()) && (extension->is_object()) &&
+				(extension->contains("source"))) {
+				return extension->at("source").get<int>();
+			}
+		}
+		
+		return texture.source;
+	}
+	
 	/**
 	 * Initializes vertex groups of a Mesh, including copying the data to
-	 * index- and vertex-buffers.
+	 * index- and vertex-buffers. If the buffers are mapped, the vertex groups
+	 * only reference the data inside of them instead.
 	 */
 	static int loadVertexGroups(const fx::gltf::Mesh &objectMesh,
 								const fx::gltf::Document &sceneObjects,
-								Scene &scene, Mesh &mesh) {
+								const std::vector<std::span<const uint8_t>> &buffers,
+								bool mapped, Scene &scene, Mesh &mesh) {
 		mesh.vertexGroups.reserve(objectMesh.primitives.size());
 	
 		for (const auto &objectPrimitive : objectMesh.primitives) {
@@ -418,14 +594,27 @@ namespace vkcv::asset {
 			int indexBufferURI;
 			if (objectPrimitive.indices >= 0) { // if there is no index buffer, -1 is returned from fx-gltf
 				const fx::gltf::BufferView& indexBufferView = sceneObjects.bufferViews[indexAccessor.bufferView];
-				const fx::gltf::Buffer& indexBuffer = sceneObjects.buffers[indexBufferView.buffer];
+				
+				if ((indexBufferView.buffer >= buffers.size()) ||
+					(indexBufferView.byteOffset + indexBufferView.byteLength >
+					 buffers[indexBufferView.buffer].size())) {
+					vkcv_log(LogLevel::ERROR, "Access to index buffer out of bounds: %d",
+							 indexBufferView.buffer);
+					return ASSET_ERROR;
+				}
+				
+				const auto indexData = buffers[indexBufferView.buffer].subspan(
+						indexBufferView.byteOffset,
+						indexBufferView.byteLength
+				);
 				
 				// Because the buffers are already preloaded into the memory by the gltf-library,
 				// it makes no sense to load them later on manually again into memory.
-				vertexGroup.indexBuffer.data.resize(indexBufferView.byteLength);
-				memcpy(vertexGroup.indexBuffer.data.data(),
-					   indexBuffer.data.data() + indexBufferView.byteOffset,
-					   indexBufferView.byteLength);
+				if (mapped) {
+					vertexGroup.indexBuffer.mapped = indexData;
+				} else {
+					vertexGroup.indexBuffer.data.assign(indexData.begin(), indexData.end());
+				}
 			} else {
 				indexBufferURI = -1;
 			}
@@ -443,12 +632,12 @@ namespace vkcv::asset {
 				return ASSET_ERROR;
 			}
 			const fx::gltf::BufferView& vertexBufferView = sceneObjects.bufferViews[posAccessor.bufferView];
-			if (vertexBufferView.buffer >= sceneObjects.buffers.size()) {
+			if (vertexBufferView.buffer >= buffers.size()) {
 				vkcv_log(LogLevel::ERROR, "Access to buffer out of bounds: %d",
 						vertexBufferView.buffer);
 				return ASSET_ERROR;
 			}
-			const fx::gltf::Buffer& vertexBuffer = sceneObjects.buffers[vertexBufferView.buffer];
+			const std::span<const uint8_t>& vertexBuffer = buffers[vertexBufferView.buffer];
 			
 			// only copy relevant part of vertex data
 			uint32_t relevantBufferOffset = std::numeric_limits<uint32_t>::max();
@@ -459,12 +648,20 @@ namespace vkcv::asset {
 				relevantBufferEnd = std::max(relevantBufferEnd, attribute.offset + attribute.length);
 			}
 			
+			if (relevantBufferEnd > vertexBuffer.size()) {
+				vkcv_log(LogLevel::ERROR, "Access to vertex buffer out of bounds: %d",
+						vertexBufferView.buffer);
+				return ASSET_ERROR;
+			}
+			
 			const uint32_t relevantBufferSize = relevantBufferEnd - relevantBufferOffset;
+			const auto vertexData = vertexBuffer.subspan(relevantBufferOffset, relevantBufferSize);
 			
-			vertexGroup.vertexBuffer.data.resize(relevantBufferSize);
-			memcpy(vertexGroup.vertexBuffer.data.data(),
-				   vertexBuffer.data.data() + relevantBufferOffset,
-				   relevantBufferSize);
+			if (mapped) {
+				vertexGroup.vertexBuffer.mapped = vertexData;
+			} else {
+				vertexGroup.vertexBuffer.data.assign(vertexData.begin(), vertexData.end());
+			}
 			
 			// make vertex attributes relative to copied section
 			for (auto& attribute : vertexGroup.vertexBuffer.attributes) {
@@ -515,9 +712,141 @@ namespace vkcv::asset {
 		return textureMask;
 	}
 
-	int probeScene(const std::filesystem::path& path, Scene& scene) {
-		fx::gltf::Document sceneObjects;
+	static constexpr uint32_t GLB_MAGIC = 0x46546C67;		// "glTF"
+	static constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;	// "JSON"
+	static constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;	// "BIN\0"
+	
+	static uint32_t readUint32(const uint8_t* data) {
+		uint32_t value;
+		memcpy(&value, data, sizeof(value));
+		return value;
+	}
 	
+	/**
+	 * Parses the glTF document from a glTF- or glb-file without loading its
+	 * binary buffers. Instead the glb-file and the files of external buffers
+	 * get mapped into memory and the buffers reference their data inside of
+	 * those mappings.
+	 *
+	 * @param path	The path to the glTF- or glb-file
+	 * @param sceneObjects	The parsed glTF document
+	 * @param files	The mapped files
+	 * @param buffers	The data of each buffer inside the mapped files
+	 * @return	ASSET_ERROR if the document could not be parsed or any buffer
+	 * 		could not be mapped, otherwise ASSET_SUCCESS
+	 */
+	static int loadMappedDocument(const std::filesystem::path &path,
+								  fx::gltf::Document &sceneObjects,
+								  std::vector<std::shared_ptr<MappedFile>> &files,
+								  std::vector<std::span<const uint8_t>> &buffers) {
+		const auto file = mapFile(path);
+		
+		if (!file) {
+			return ASSET_ERROR;
+		}
+		
+		std::span<const uint8_t> json (file->data, file->size);
+		std::span<const uint8_t> binary;
+		
+		if (path.extension() == ".glb") {
+			if ((file->size < 20) ||
+				(readUint32(file->data) != GLB_MAGIC) ||
+				(readUint32(file->data + 4) != 2) ||
+				(readUint32(file->data + 8) > file->size) ||
+				(readUint32(file->data + 16) != GLB_CHUNK_JSON)) {
+				vkcv_log(LogLevel::ERROR, "Invalid glb header (%s)",
+						 path.string().c_str());
+				return ASSET_ERROR;
+			}
+			
+			const size_t length = readUint32(file->data + 8);
+			const size_t jsonLength = readUint32(file->data + 12);
+			
+			if (20 + jsonLength > length) {
+				vkcv_log(LogLevel::ERROR, "Invalid glb chunk (%s)",
+						 path.string().c_str());
+				return ASSET_ERROR;
+			}
+			
+			json = json.subspan(20, jsonLength);
+			
+			const size_t binaryOffset = 20 + ((jsonLength + 3) & ~static_cast<size_t>(3));
+			
+			if ((binaryOffset + 8 <= length) &&
+				(readUint32(file->data + binaryOffset + 4) == GLB_CHUNK_BIN)) {
+				const size_t binaryLength = readUint32(file->data + binaryOffset);
+				
+				if (binaryOffset + 8 + binaryLength > length) {
+					vkcv_log(LogLevel::ERROR, "Invalid glb chunk (%s)",
+							 path.string().c_str());
+					return ASSET_ERROR;
+				}
+				
+				binary = std::span<const uint8_t>(file->data + binaryOffset + 8, binaryLength);
+			}
+		}
+		
+		try {
+			const auto text = reinterpret_cast<const char*>(json.data());
+			sceneObjects = nlohmann::json::parse(text, text + json.size()).get<fx::gltf::Document>();
+		} catch (const std::exception& e) {
+			recurseExceptionPrint(e, path);
+			return ASSET_ERROR;
+		}
+		
+		if (!binary.empty()) {
+			files.push_back(file);
+		}
+		
+		const auto directory = path.parent_path();
+		buffers.reserve(sceneObjects.buffers.size());
+		
+		for (const auto& buffer : sceneObjects.buffers) {
+			std::span<const uint8_t> data;
+			
+			if (buffer.uri.empty()) {
+				data = binary;
+			} else
+			if (buffer.uri.rfind("data:", 0) == 0) {
+				vkcv_log(LogLevel::WARNING, "Embedded buffers can not be mapped (%s)",
+						 path.string().c_str());
+				return ASSET_ERROR;
+			} else {
+				const auto bufferFile = mapFile(directory / buffer.uri);
+				
+				if (!bufferFile) {
+					return ASSET_ERROR;
+				}
+				
+				files.push_back(bufferFile);
+				data = std::span<const uint8_t>(bufferFile->data, bufferFile->size);
+			}
+			
+			if (buffer.byteLength > data.size()) {
+				vkcv_log(LogLevel::ERROR, "Buffer '%s' exceeds its data (%s)",
+						 buffer.name.c_str(), path.string().c_str());
+				return ASSET_ERROR;
+			}
+			
+			buffers.push_back(data.first(buffer.byteLength));
+		}
+		
+		return ASSET_SUCCESS;
+	}
+	
+	/**
+	 * Parses the glTF document from a glTF- or glb-file and loads all of its
+	 * binary buffers into memory.
+	 *
+	 * @param path	The path to the glTF- or glb-file
+	 * @param sceneObjects	The parsed glTF document
+	 * @param buffers	The data of each loaded buffer
+	 * @return	ASSET_ERROR if the document could not be loaded, otherwise
+	 * 		ASSET_SUCCESS
+	 */
+	static int loadDocument(const std::filesystem::path &path,
+							fx::gltf::Document &sceneObjects,
+							std::vector<std::span<const uint8_t>> &buffers) {
 		try {
 			if (path.extension() == ".glb") {
 				sceneObjects = fx::gltf::LoadFromBinary(
@@ -546,6 +875,35 @@ namespace vkcv::asset {
 			return ASSET_ERROR;
 		}
 		
+		buffers.reserve(sceneObjects.buffers.size());
+		
+		for (const auto& buffer : sceneObjects.buffers) {
+			buffers.emplace_back(buffer.data.data(), buffer.data.size());
+		}
+		
+		return ASSET_SUCCESS;
+	}
+
+	int probeScene(const std::filesystem::path& path, Scene& scene, bool mapBuffers) {
+		fx::gltf::Document sceneObjects;
+		std::vector<std::shared_ptr<MappedFile>> files;
+		std::vector<std::span<const uint8_t>> buffers;
+		
+		if ((mapBuffers) &&
+			(loadMappedDocument(path, sceneObjects, files, buffers) != ASSET_SUCCESS)) {
+			vkcv_log(LogLevel::WARNING, "Mapping buffers failed, loading them instead (%s)",
+					 path.string().c_str());
+			
+			sceneObjects = fx::gltf::Document();
+			files.clear();
+			buffers.clear();
+			mapBuffers = false;
+		}
+		
+		if ((!mapBuffers) && (loadDocument(path, sceneObjects, buffers) != ASSET_SUCCESS)) {
+			return ASSET_ERROR;
+		}
+		
 		const auto directory = path.parent_path();
 		
 		scene.meshes.clear();
@@ -553,6 +911,7 @@ namespace vkcv::asset {
 		scene.materials.clear();
 		scene.textures.clear();
 		scene.samplers.clear();
+		scene.files = files;
 	
 		// file has to contain at least one mesh
 		if (sceneObjects.meshes.empty()) {
@@ -565,7 +924,8 @@ namespace vkcv::asset {
 				Mesh mesh;
 				mesh.name = sceneObjects.meshes[i].name;
 				
-				if (loadVertexGroups(sceneObjects.meshes[i], sceneObjects, scene, mesh) != ASSET_SUCCESS) {
+				if (loadVertexGroups(sceneObjects.meshes[i], sceneObjects, buffers, mapBuffers,
+									 scene, mesh) != ASSET_SUCCESS) {
 					vkcv_log(LogLevel::ERROR, "Failed to load vertex groups of '%s'! (%s)",
 							 mesh.name.c_str(), path.string().c_str());
 					return ASSET_ERROR;
@@ -657,23 +1017,33 @@ namespace vkcv::asset {
 					texture.sampler = textureObject.sampler;
 				}
 				
-				if ((textureObject.source < 0) ||
-					(static_cast<size_t>(textureObject.source) >= sceneObjects.images.size())) {
+				const int source = getTextureSource(textureObject);
+				
+				if ((source < 0) || (static_cast<size_t>(source) >= sceneObjects.images.size())) {
 					vkcv_log(LogLevel::ERROR, "Failed to load texture '%s' (%s)",
 							 textureObject.name.c_str(), path.string().c_str());
 					return ASSET_ERROR;
 				}
 				
-				const auto& image = sceneObjects.images[textureObject.source];
+				const auto& image = sceneObjects.images[source];
 				
 				if (image.uri.empty()) {
 					const fx::gltf::BufferView bufferView = sceneObjects.bufferViews[image.bufferView];
 					
+					if ((bufferView.buffer >= buffers.size()) ||
+						(bufferView.byteOffset + bufferView.byteLength > buffers[bufferView.buffer].size())) {
+						vkcv_log(LogLevel::ERROR, "Data of texture '%s' out of bounds (%s)",
+								 textureObject.name.c_str(), path.string().c_str());
+						return ASSET_ERROR;
+					}
+					
+					const auto data = buffers[bufferView.buffer].subspan(
+							bufferView.byteOffset,
+							bufferView.byteLength
+					);
+					
 					texture.path.clear();
-					texture.data.resize(bufferView.byteLength);
-					memcpy(texture.data.data(),
-						   sceneObjects.buffers[bufferView.buffer].data.data() + bufferView.byteOffset,
-						   bufferView.byteLength);
+					texture.data.assign(data.begin(), data.end());
 				} else {
 					texture.path = directory / image.uri;
 				}
@@ -723,13 +1093,18 @@ namespace vkcv::asset {
 	 * The path member is the only one that has to be initialized before
 	 * calling this function, the others (width, height, channels, data)
 	 * are set by this function and the sampler is of no concern here.
+	 * Textures from KTX2- or DDS-files keep their compressed blocks.
 	 */
-	static int loadTextureData(Texture& texture) {
+	static int loadTextureData(Texture& texture, const std::vector<int> &transcodeFormats) {
 		if ((texture.width > 0) && (texture.height > 0) && (texture.channels > 0) &&
 			(!texture.data.empty())) {
 			return ASSET_SUCCESS; // Texture data was loaded already!
 		}
 		
+		if (isCompressedTexture(texture)) {
+			return loadCompressedTexture(texture, transcodeFormats);
+		}
+		
 		uint8_t* data;
 		
 		if (texture.path.empty()) {
@@ -759,6 +1134,8 @@ namespace vkcv::asset {
 			return ASSET_ERROR;
 		}
 		
+		texture.format = VK_FORMAT_UNDEFINED;
+		texture.levels = 1;
 		texture.data.resize(texture.width * texture.height * 4);
 		memcpy(texture.data.data(), data, texture.data.size());
 		stbi_image_free(data);
@@ -766,7 +1143,7 @@ namespace vkcv::asset {
 		return ASSET_SUCCESS;
 	}
 
-	int loadMesh(Scene &scene, int index) {
+	int loadMesh(Scene &scene, int index, const std::vector<int> &transcodeFormats) {
 		if ((index < 0) || (static_cast<size_t>(index) >= scene.meshes.size())) {
 			vkcv_log(LogLevel::ERROR, "Mesh index out of range: %d", index);
 			return ASSET_ERROR;
@@ -779,7 +1156,7 @@ namespace vkcv::asset {
 			const Material& material = scene.materials[vertexGroup.materialIndex];
 			
 			if (material.hasTexture(PBRTextureTarget::baseColor)) {
-				const int result = loadTextureData(scene.textures[material.baseColor]);
+				const int result = loadTextureData(scene.textures[material.baseColor], transcodeFormats);
 				if (ASSET_SUCCESS != result) {
 					vkcv_log(LogLevel::ERROR, "Failed loading baseColor texture of mesh '%s'",
 									 mesh.name.c_str())
@@ -788,7 +1165,7 @@ namespace vkcv::asset {
 			}
 			
 			if (material.hasTexture(PBRTextureTarget::metalRough)) {
-				const int result = loadTextureData(scene.textures[material.metalRough]);
+				const int result = loadTextureData(scene.textures[material.metalRough], transcodeFormats);
 				if (ASSET_SUCCESS != result) {
 					vkcv_log(LogLevel::ERROR, "Failed loading metalRough texture of mesh '%s'",
 									 mesh.name.c_str())
@@ -797,7 +1174,7 @@ namespace vkcv::asset {
 			}
 			
 			if (material.hasTexture(PBRTextureTarget::normal)) {
-				const int result = loadTextureData(scene.textures[material.normal]);
+				const int result = loadTextureData(scene.textures[material.normal], transcodeFormats);
 				if (ASSET_SUCCESS != result) {
 					vkcv_log(LogLevel::ERROR, "Failed loading normal texture of mesh '%s'",
 									 mesh.name.c_str())
@@ -806,7 +1183,7 @@ namespace vkcv::asset {
 			}
 			
 			if (material.hasTexture(PBRTextureTarget::occlusion)) {
-				const int result = loadTextureData(scene.textures[material.occlusion]);
+				const int result = loadTextureData(scene.textures[material.occlusion], transcodeFormats);
 				if (ASSET_SUCCESS != result) {
 					vkcv_log(LogLevel::ERROR, "Failed loading occlusion texture of mesh '%s'",
 									 mesh.name.c_str())
@@ -815,7 +1192,7 @@ namespace vkcv::asset {
 			}
 			
 			if (material.hasTexture(PBRTextureTarget::emissive)) {
-				const int result = loadTextureData(scene.textures[material.emissive]);
+				const int result = loadTextureData(scene.textures[material.emissive], transcodeFormats);
 				if (ASSET_SUCCESS != result) {
 					vkcv_log(LogLevel::ERROR, "Failed loading emissive texture of mesh '%s'",
 									 mesh.name.c_str())
@@ -827,8 +1204,9 @@ namespace vkcv::asset {
 		return ASSET_SUCCESS;
 	}
 	
-	int loadScene(const std::filesystem::path &path, Scene &scene) {
-		int result = probeScene(path, scene);
+	int loadScene(const std::filesystem::path &path, Scene &scene, bool mapBuffers,
+				  const std::vector<int> &transcodeFormats) {
+		int result = probeScene(path, scene, mapBuffers);
 		size_t i;
 		
 		if (result != ASSET_SUCCESS) {
@@ -840,11 +1218,11 @@ namespace vkcv::asset {
 		/* Preloading the textures of the scene to improve performance */
 		#pragma omp parallel for shared(scene.textures) private(i)
 		for (i = 0; i < scene.textures.size(); i++) {
-			loadTextureData(scene.textures[i]);
+			loadTextureData(scene.textures[i], transcodeFormats);
 		}
 		
 		for (i = 0; i < scene.meshes.size(); i++) {
-			result = loadMesh(scene, static_cast<int>(i));
+			result = loadMesh(scene, static_cast<int>(i), transcodeFormats);
 			
 			if (result != ASSET_SUCCESS) {
 				vkcv_log(LogLevel::ERROR, "Loading mesh with index %d failed '%s'",
@@ -856,12 +1234,13 @@ namespace vkcv::asset {
 		return ASSET_SUCCESS;
 	}
 	
-	Texture loadTexture(const std::filesystem::path& path) {
+	Texture loadTexture(const std::filesystem::path& path,
+						const std::vector<int> &transcodeFormats) {
 		Texture texture;
 		texture.path = path;
 		texture.sampler = -1;
 		
-		if (loadTextureData(texture) != ASSET_SUCCESS) {
+		if (loadTextureData(texture, transcodeFormats) != ASSET_SUCCESS) {
 			texture.path.clear();
 			texture.w = texture.h = texture.channels = 0;
 			texture.data.clear();
@@ -871,7 +1250,8 @@ namespace vkcv::asset {
 	
 	VertexBufferBindings loadVertexBufferBindings(const std::vector<VertexAttribute> &attributes,
 												  const BufferHandle &buffer,
-												  const std::vector<PrimitiveType> &types) {
+												  const std::vector<PrimitiveType> &types,
+												  size_t offset) {
 		VertexBufferBindings bindings;
 		
 		for (const auto& type : types) {
@@ -892,7 +1272,7 @@ namespace vkcv::asset {
 			bindings.push_back(vkcv::vertexBufferBinding(
 					buffer,
 					attribute->stride,
-					attribute->offset
+					offset + attribute->offset
 			));
 		}
 		
@@ -151,8 +151,8 @@ namespace vkcv::effects {
 		compiler.compileSource(
 				vkcv::ShaderStage::COMPUTE,
 				shaderSource,
-				[&](vkcv::ShaderStage shaderStage, const std::filesystem::path& path) {
-					program.addShader(shaderStage, path);
+				[&](vkcv::ShaderStage shaderStage, const Vector<uint32_t>& binary) {
+					program.addShader(shaderStage, binary);
 				},
 				""
 		);
@@ -487,6 +487,8 @@ namespace vkcv::effects {
 					true
 			);
 			
+			m_core.setDebugLabel(m_blurImage, "vkcv::effects::BloomAndFlaresEffect");
+			
 			m_downsampleDescriptorSets.clear();
 			m_upsampleDescriptorSets.clear();
 			
@@ -514,6 +516,8 @@ namespace vkcv::effects {
 					true
 			);
 			
+			m_core.setDebugLabel(m_flaresImage, "vkcv::effects::BloomAndFlaresEffect");
+			
 			m_flaresDescriptorSets.clear();
 			
 			const uint32_t mipLevels = m_core.getImageMipLevels(m_flaresImage);
@@ -42,8 +42,8 @@ namespace vkcv::effects {
 		compiler.compileSource(
 			ShaderStage::COMPUTE,
 			GAMMACORRECTION_COMP_SHADER,
-			[&program](ShaderStage stage, const std::filesystem::path &path) {
-				program.addShader(stage, path);
+			[&program](ShaderStage stage, const Vector<uint32_t>& binary) {
+				program.addShader(stage, binary);
 			}
 		);
 		
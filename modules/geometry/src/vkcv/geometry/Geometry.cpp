@@ -49,7 +49,8 @@ namespace vkcv::geometry {
 				GeometryVertexType::POSITION_FLOAT3
 		);
 		
-		data.setIndexBuffer(vertexData.getIndexBuffer(), vertexData.getIndexBitCount());
+		data.setIndexBuffer(vertexData.getIndexBuffer(), vertexData.getIndexBitCount(),
+							vertexData.getIndexOffset());
 		data.setCount(vertexData.getCount());
 		
 		return data;
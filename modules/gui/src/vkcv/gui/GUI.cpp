@@ -245,11 +245,12 @@ namespace vkcv::gui {
 			// therefore the layout must be updated manually
 			m_core.updateImageLayoutManual(vkcv::ImageHandle::createSwapchainImageHandle(), finalImageLayout);
 
-		}, [&]() {
+		}, [this, framebuffer]() {
 			m_context.getDevice().destroyFramebuffer(framebuffer);
 		});
 		
-		m_core.submitCommandStream(stream, false);
+		// the presentation of the frame waits for the interface to be rendered
+		m_core.submitCommandStreamAsync(stream, true);
 	}
 	
 }
@@ -156,6 +156,14 @@ namespace vkcv::material {
 		 */
 		void recordMipChainGeneration(const vkcv::CommandStreamHandle& cmdStream,
 									  Downsampler &downsampler);
+		
+		/**
+		 * @brief Records mip chain generation of the whole material into the
+		 * pending uploads of the core, so it runs right after them.
+		 *
+		 * @param[in,out] core Core instance to record the uploads with
+		 */
+		void recordMipChainGenerationToUploads(Core &core);
 
         /**
          * Returns the descriptor bindings required by a given material
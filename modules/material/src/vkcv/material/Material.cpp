@@ -37,6 +37,12 @@ namespace vkcv::material {
 		}
 	}
 	
+	void Material::recordMipChainGenerationToUploads(Core &core) {
+		for (auto& texture : m_Textures) {
+			core.recordMipChainGenerationToUploads(texture.m_Image);
+		}
+	}
+	
 	const DescriptorBindings& Material::getDescriptorBindings(MaterialType type)
 	{
 		static DescriptorBindings pbr_bindings = {};
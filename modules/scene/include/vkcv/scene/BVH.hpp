@@ -0,0 +1,133 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+
+#include "Bounds.hpp"
+#include "BoundsArray.hpp"
+
+namespace vkcv::scene {
+
+    /**
+     * @addtogroup vkcv_scene
+     * @{
+     */
+
+	/**
+	 * The default maximum amount of primitives per leaf node of a bounding volume hierarchy.
+	 */
+	constexpr size_t BVH_DEFAULT_LEAF_SIZE = 4;
+
+    /**
+     * A structure to represent a node of a bounding volume hierarchy in its flat array.
+     * The first child of an inner node directly follows its parent in the array while
+     * the index of its second child is stored in the node.
+     */
+	struct BVHNode {
+        /**
+         * Axis aligned bounding box of the node.
+         */
+		Bounds bounds;
+
+        /**
+         * Index of the second child node for inner nodes or the offset of the first
+         * primitive index for leaf nodes.
+         */
+		uint32_t offset;
+
+        /**
+         * Amount of primitives in a leaf node or zero for inner nodes.
+         */
+		uint32_t count;
+	};
+
+    /**
+     * A class to build a bounding volume hierarchy over a list of axis aligned bounding
+     * boxes by splitting them with the surface area heuristic. The nodes are stored in
+     * depth-first order as flat array for cache friendly traversal.
+     */
+	class BVH {
+	private:
+        /**
+         * List of nodes in depth-first order with the root node first.
+         */
+		std::vector<BVHNode> m_nodes;
+
+        /**
+         * List of primitive indices in the order of the leaf nodes referencing them.
+         */
+		std::vector<uint32_t> m_indices;
+
+        /**
+         * List of primitive bounds in the order of the primitive indices.
+         */
+		std::vector<Bounds> m_primitives;
+
+	public:
+        /**
+         * Constructor of an empty bounding volume hierarchy.
+         */
+		BVH();
+
+		BVH(const BVH& other) = default;
+		BVH(BVH&& other) = default;
+
+		~BVH() = default;
+
+		BVH& operator=(const BVH& other) = default;
+		BVH& operator=(BVH&& other) = default;
+
+        /**
+         * Build the hierarchy over a given array of axis aligned bounding boxes, while
+         * nodes get split until each leaf contains at most a given amount of boxes.
+         *
+         * @param[in] bounds Array of axis aligned bounding boxes
+         * @param[in] leafSize Maximum amount of boxes per leaf node
+         */
+		void build(const BoundsArray& bounds, size_t leafSize = BVH_DEFAULT_LEAF_SIZE);
+
+        /**
+         * Remove all nodes from the hierarchy.
+         */
+		void clear();
+
+        /**
+         * Return the status if the hierarchy does not contain any nodes.
+         *
+         * @return true if the hierarchy is empty, otherwise false
+         */
+		[[nodiscard]]
+		bool empty() const;
+
+        /**
+         * Check which primitives of the hierarchy are intersecting a given frustum
+         * defined by a 4x4 transformation matrix. Subtrees outside of the frustum get
+         * skipped and subtrees fully inside of it are accepted without further tests.
+         *
+         * @param[in] transform Frustum defining 4x4 matrix
+         * @param[out] visibility List of flags per primitive, 1 if intersecting, otherwise 0
+         */
+		void cull(const glm::mat4& transform, std::vector<uint8_t>& visibility) const;
+
+        /**
+         * Return the list of nodes in depth-first order.
+         *
+         * @return List of nodes
+         */
+		[[nodiscard]]
+		const std::vector<BVHNode>& getNodes() const;
+
+        /**
+         * Return the list of primitive indices in the order of the leaf nodes.
+         *
+         * @return List of primitive indices
+         */
+		[[nodiscard]]
+		const std::vector<uint32_t>& getIndices() const;
+
+	};
+
+    /** @} */
+
+}
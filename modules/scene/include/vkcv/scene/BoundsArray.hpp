@@ -0,0 +1,178 @@
+#pragma once
+
+#include <vector>
+
+#include "Bounds.hpp"
+
+namespace vkcv::scene {
+
+    /**
+     * @addtogroup vkcv_scene
+     * @{
+     */
+
+	/**
+	 * The amount of axis aligned bounding boxes being processed together
+	 * in a batch. The arrays of bounds are padded to a multiple of it.
+	 */
+	constexpr size_t BOUNDS_BATCH_SIZE = 16;
+
+    /**
+     * A class to store a list of axis aligned bounding boxes as structure of
+     * arrays with separate center and extent coordinates to process multiple
+     * boxes at once with vectorized instructions.
+     */
+	class BoundsArray {
+	private:
+        /**
+         * The x-coordinates of the centers.
+         */
+		std::vector<float> m_centerX;
+
+        /**
+         * The y-coordinates of the centers.
+         */
+		std::vector<float> m_centerY;
+
+        /**
+         * The z-coordinates of the centers.
+         */
+		std::vector<float> m_centerZ;
+
+        /**
+         * The x-coordinates of the extents (half sizes).
+         */
+		std::vector<float> m_extentX;
+
+        /**
+         * The y-coordinates of the extents (half sizes).
+         */
+		std::vector<float> m_extentY;
+
+        /**
+         * The z-coordinates of the extents (half sizes).
+         */
+		std::vector<float> m_extentZ;
+
+        /**
+         * The amount of bounds in the arrays without padding.
+         */
+		size_t m_count;
+
+	public:
+        /**
+         * Constructor of an empty array of bounds.
+         */
+		BoundsArray();
+
+		BoundsArray(const BoundsArray& other) = default;
+		BoundsArray(BoundsArray&& other) = default;
+
+		~BoundsArray() = default;
+
+		BoundsArray& operator=(const BoundsArray& other) = default;
+		BoundsArray& operator=(BoundsArray&& other) = default;
+
+        /**
+         * Reserve memory for a given amount of bounds.
+         *
+         * @param[in] count Amount of bounds
+         */
+		void reserve(size_t count);
+
+        /**
+         * Remove all bounds from the array.
+         */
+		void clear();
+
+        /**
+         * Add an axis aligned bounding box to the end of the array.
+         *
+         * @param[in] bounds Axis aligned bounding box
+         */
+		void add(const Bounds& bounds);
+
+        /**
+         * Return the axis aligned bounding box with a given index.
+         *
+         * @param[in] index Valid index of bounds
+         * @return Axis aligned bounding box
+         */
+		[[nodiscard]]
+		Bounds get(size_t index) const;
+
+        /**
+         * Return the amount of bounds in the array.
+         *
+         * @return Amount of bounds
+         */
+		[[nodiscard]]
+		size_t size() const;
+
+        /**
+         * Return the status if the array does not contain any bounds.
+         *
+         * @return true if the array is empty, otherwise false
+         */
+		[[nodiscard]]
+		bool empty() const;
+
+        /**
+         * Return a pointer to the x-coordinates of the centers which can be
+         * read in batches up to the padded size of the array.
+         *
+         * @return Pointer to x-coordinates of centers
+         */
+		[[nodiscard]]
+		const float* getCenterX() const;
+
+        /**
+         * Return a pointer to the y-coordinates of the centers which can be
+         * read in batches up to the padded size of the array.
+         *
+         * @return Pointer to y-coordinates of centers
+         */
+		[[nodiscard]]
+		const float* getCenterY() const;
+
+        /**
+         * Return a pointer to the z-coordinates of the centers which can be
+         * read in batches up to the padded size of the array.
+         *
+         * @return Pointer to z-coordinates of centers
+         */
+		[[nodiscard]]
+		const float* getCenterZ() const;
+
+        /**
+         * Return a pointer to the x-coordinates of the extents which can be
+         * read in batches up to the padded size of the array.
+         *
+         * @return Pointer to x-coordinates of extents
+         */
+		[[nodiscard]]
+		const float* getExtentX() const;
+
+        /**
+         * Return a pointer to the y-coordinates of the extents which can be
+         * read in batches up to the padded size of the array.
+         *
+         * @return Pointer to y-coordinates of extents
+         */
+		[[nodiscard]]
+		const float* getExtentY() const;
+
+        /**
+         * Return a pointer to the z-coordinates of the extents which can be
+         * read in batches up to the padded size of the array.
+         *
+         * @return Pointer to z-coordinates of extents
+         */
+		[[nodiscard]]
+		const float* getExtentZ() const;
+
+	};
+
+    /** @} */
+
+}
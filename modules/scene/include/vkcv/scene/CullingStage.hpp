@@ -0,0 +1,190 @@
+#pragma once
+
+#include <vector>
+
+#include <vkcv/Core.hpp>
+#include <vkcv/camera/Camera.hpp>
+
+namespace vkcv::scene {
+
+    /**
+     * @addtogroup vkcv_scene
+     * @{
+     */
+
+	class Scene;
+
+    /**
+     * A class to cull packed mesh parts of a scene on the GPU via frustum culling and
+     * occlusion culling against a hierarchical depth buffer of the previous frame. The
+     * resulting indirect draw commands and counts can be used to render the batches of
+     * the scene without any work per mesh part on the CPU.
+     */
+	class CullingStage {
+	private:
+        /**
+         * Reference to the current Core instance.
+         */
+		Core& m_core;
+
+        /**
+         * Flag to compact the draw commands of visible mesh parts, which requires
+         * draw count buffers to be supported.
+         */
+		bool m_compact;
+
+        /**
+         * Flag to enable occlusion culling against the depth pyramid.
+         */
+		bool m_occlusion;
+
+        /**
+         * The compute pipeline to cull the mesh parts.
+         */
+		ComputePipelineHandle m_cullingPipeline;
+
+        /**
+         * The descriptor set layout of the culling pipeline.
+         */
+		DescriptorSetLayoutHandle m_cullingDescriptorSetLayout;
+
+        /**
+         * The descriptor sets used for culling per frame in flight.
+         */
+		std::vector<DescriptorSetHandle> m_cullingDescriptorSets;
+
+        /**
+         * The compute pipeline to generate the depth pyramid.
+         */
+		ComputePipelineHandle m_pyramidPipeline;
+
+        /**
+         * The descriptor set layout of the depth pyramid pipeline.
+         */
+		DescriptorSetLayoutHandle m_pyramidDescriptorSetLayout;
+
+        /**
+         * The descriptor sets used to generate each level of the depth pyramid
+         * per frame in flight.
+         */
+		std::vector<std::vector<DescriptorSetHandle>> m_pyramidDescriptorSets;
+
+        /**
+         * The sampler to read depth values.
+         */
+		SamplerHandle m_sampler;
+
+        /**
+         * The depth pyramid storing the maximum depth of each region in its mip levels.
+         */
+		ImageHandle m_depthPyramid;
+
+        /**
+         * Flag to indicate that the depth pyramid contains depth values.
+         */
+		bool m_depthPyramidValid;
+
+        /**
+         * The buffer containing the resulting draw commands.
+         */
+		BufferHandle m_drawBuffer;
+
+        /**
+         * The buffer containing the resulting amount of draw commands per batch.
+         */
+		BufferHandle m_drawCountBuffer;
+
+        /**
+         * The capacity of draw commands in the draw buffer.
+         */
+		size_t m_drawCapacity;
+
+        /**
+         * The capacity of batches in the draw count buffer.
+         */
+		size_t m_batchCapacity;
+
+	public:
+        /**
+         * Constructor of a culling stage with a given Core instance.
+         *
+         * @param[in,out] core Core instance
+         */
+		explicit CullingStage(Core& core);
+
+		CullingStage(const CullingStage& other) = delete;
+		CullingStage(CullingStage&& other) = delete;
+
+		~CullingStage() = default;
+
+		CullingStage& operator=(const CullingStage& other) = delete;
+		CullingStage& operator=(CullingStage&& other) = delete;
+
+        /**
+         * Record the culling of all packed mesh parts of a scene from the view of
+         * a camera into a command stream.
+         *
+         * @param[in] cmdStream Command stream handle
+         * @param[in] scene Scene with packed mesh parts
+         * @param[in] camera Scene viewing camera
+         */
+		void recordCulling(const CommandStreamHandle& cmdStream,
+						   const Scene& scene,
+						   const camera::Camera& camera);
+
+        /**
+         * Record the generation of the depth pyramid from a depth image into a
+         * command stream to use it for occlusion culling in the next frame.
+         *
+         * @param[in] cmdStream Command stream handle
+         * @param[in] depthImage Depth image handle
+         */
+		void recordDepthPyramid(const CommandStreamHandle& cmdStream,
+								const ImageHandle& depthImage);
+
+        /**
+         * Enable or disable occlusion culling against the depth pyramid.
+         *
+         * @param[in] occlusion Flag to enable occlusion culling
+         */
+		void setOcclusionCulling(bool occlusion);
+
+        /**
+         * Return the status if occlusion culling is enabled.
+         *
+         * @return true if occlusion culling is enabled, otherwise false
+         */
+		[[nodiscard]]
+		bool isOcclusionCulling() const;
+
+        /**
+         * Return the handle of the buffer containing the resulting draw commands.
+         *
+         * @return Draw buffer handle
+         */
+		[[nodiscard]]
+		const BufferHandle& getDrawBuffer() const;
+
+        /**
+         * Return the handle of the buffer containing the resulting amount of draw
+         * commands per batch. The handle is invalid if draw commands of culled mesh
+         * parts are not compacted but kept with zero instances.
+         *
+         * @return Draw count buffer handle
+         */
+		[[nodiscard]]
+		const BufferHandle& getDrawCountBuffer() const;
+
+        /**
+         * Return the handle of the depth pyramid.
+         *
+         * @return Depth pyramid handle
+         */
+		[[nodiscard]]
+		const ImageHandle& getDepthPyramid() const;
+
+	};
+
+    /** @} */
+
+}
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <vector>
+
 #include <glm/mat4x4.hpp>
 #include "vkcv/scene/Bounds.hpp"
+#include "vkcv/scene/BoundsArray.hpp"
 
 namespace vkcv::scene {
 
@@ -31,6 +34,15 @@ namespace vkcv::scene {
      */
 	Bounds transformBounds(const glm::mat4& transform, const Bounds& bounds, bool& negative_w);
 
+    /**
+     * Extract the six planes of a frustum defined by a 4x4 transformation matrix.
+     * Each plane is stored as normal and distance, so a point p is on the inner
+     * side of the plane if dot(normal, p) + distance is not negative.
+     * @param[in] transform Frustum defining 4x4 matrix
+     * @param[out] planes Array of planes as 4D vectors
+     */
+	void getFrustumPlanes(const glm::mat4& transform, glm::vec4 planes [6]);
+
     /**
      * Check if an axis aligned bounding box is intersecting a given frustum
      * defined by a 4x4 transformation matrix.
@@ -40,6 +52,20 @@ namespace vkcv::scene {
      */
 	bool checkFrustum(const glm::mat4& transform, const Bounds& bounds);
 
+    /**
+     * Check which axis aligned bounding boxes of an array are intersecting a given
+     * frustum defined by a 4x4 transformation matrix. The boxes get tested in batches
+     * against the planes of the frustum using vectorized instructions if available.
+     * The test is conservative, so boxes close to the edges of the frustum might be
+     * marked as visible even if they are not intersecting.
+     * @param[in] transform Frustum defining 4x4 matrix
+     * @param[in] bounds Array of axis aligned bounding boxes
+     * @param[out] visibility List of flags per box, 1 if intersecting, otherwise 0
+     */
+	void checkFrustum(const glm::mat4& transform,
+					  const BoundsArray& bounds,
+					  std::vector<uint8_t>& visibility);
+
     /** @} */
 	
 }
@@ -5,6 +5,7 @@
 #include <vkcv/asset/asset_loader.hpp>
 #include <vkcv/camera/Camera.hpp>
 
+#include "BoundsArray.hpp"
 #include "MeshPart.hpp"
 
 namespace vkcv::scene {
@@ -87,11 +88,27 @@ namespace vkcv::scene {
          * @param[out] pushConstants Structure to store push constants per drawcall
          * @param[out] drawcalls List of drawcall structures
          * @param[in] record Drawcall recording event function
+         * @param[in] visibility Visibility flags of the meshes drawcalls
          */
 		void recordDrawcalls(const glm::mat4& viewProjection,
 							 PushConstants& pushConstants,
 							 std::vector<InstanceDrawcall>& drawcalls,
-							 const RecordMeshDrawcallFunction& record);
+							 const RecordMeshDrawcallFunction& record,
+							 const uint8_t* visibility);
+		
+		/**
+		 * Append the axis aligned bounding boxes in world space of all
+		 * parts of the mesh to a given array in order of its drawcalls.
+		 *
+		 * @param[out] bounds Array of axis aligned bounding boxes
+		 */
+		void appendPartBounds(BoundsArray& bounds) const;
+		
+		/**
+		 * Update the drawcalls of all parts of the mesh to use the current
+		 * descriptor sets of their materials.
+		 */
+		void updateDrawcalls();
 		
 		/**
 		 * Creates acceleration structures for the whole geometry of this mesh and
@@ -6,6 +6,8 @@
 #include <vkcv/camera/Camera.hpp>
 
 #include "Bounds.hpp"
+#include "BoundsArray.hpp"
+#include "BVH.hpp"
 #include "Mesh.hpp"
 
 namespace vkcv::scene {
@@ -43,6 +45,24 @@ namespace vkcv::scene {
          * Axis aligned bounding box of the node.
          */
 		Bounds m_bounds;
+		
+		/**
+		 * Axis aligned bounding boxes in world space of all mesh parts
+		 * of the meshes added to the node.
+		 */
+		BoundsArray m_partBounds;
+		
+		/**
+		 * Visibility flags of all mesh parts of the meshes added to the
+		 * node from the last frustum culling.
+		 */
+		std::vector<uint8_t> m_partVisibility;
+		
+		/**
+		 * Bounding volume hierarchy over all mesh parts of the meshes
+		 * added to the node, which is empty until it gets built.
+		 */
+		BVH m_partHierarchy;
 
         /**
          * Constructor of a new node with a given scene as parent.
@@ -94,7 +114,9 @@ namespace vkcv::scene {
 					  const std::vector<asset::PrimitiveType>& types);
 
         /**
-         * Record drawcalls of all meshes of this node and its child nodes.
+         * Record drawcalls of all meshes of this node and its child nodes. The parts
+         * of all meshes of a node get culled together by traversing its bounding volume
+         * hierarchy if it was built, otherwise in batches.
          *
          * @param[in] viewProjection View-transformation and projection as 4x4 matrix
          * @param[out] pushConstants Structure to store push constants per drawcall
@@ -106,9 +128,16 @@ namespace vkcv::scene {
 							 std::vector<InstanceDrawcall>& drawcalls,
 							 const RecordMeshDrawcallFunction& record);
 		
+		/**
+		 * Update the drawcalls of all meshes of this node and its child nodes
+		 * to use the current descriptor sets of their materials.
+		 */
+		void updateDrawcalls();
+		
 		/**
 		 * Creates acceleration structures for all meshes of this node and its child
-		 * nodes to append them to a given list.
+		 * nodes to append them to a given list. The meshes of a node get appended in
+		 * the order of the leaves of its bounding volume hierarchy if it was built.
 		 *
 		 * @param[in,out] core Core instance
 		 * @param[out] accelerationStructures List of acceleration structures
@@ -119,13 +148,34 @@ namespace vkcv::scene {
 				const ProcessGeometryFunction &process) const;
 
         /**
-         * Splits child nodes into tree based graphs of nodes
-         * until all nodes contain an amount of meshes below
-         * a given maximum.
+         * Splits the meshes of this node into a binary tree of child nodes
+         * using a bounding volume hierarchy with the surface area heuristic
+         * until all nodes contain an amount of meshes below a given maximum.
          *
          * @param[in] maxMeshesPerNode Maximum amount of meshes per node
          */
 		void splitMeshesToSubNodes(size_t maxMeshesPerNode);
+		
+		/**
+		 * Adds child nodes and meshes to this node matching a given node of
+		 * a bounding volume hierarchy built over a list of meshes.
+		 *
+		 * @param[in] hierarchy Bounding volume hierarchy over meshes
+		 * @param[in] index Index of the node in the hierarchy
+		 * @param[in] meshes List of meshes
+		 */
+		void addHierarchyNodes(const BVH& hierarchy,
+							   size_t index,
+							   const std::vector<Mesh>& meshes);
+		
+		/**
+		 * Builds the bounding volume hierarchies over the mesh parts of this
+		 * node and its child nodes with a given maximum amount of mesh parts
+		 * per leaf.
+		 *
+		 * @param[in] leafSize Maximum amount of mesh parts per leaf
+		 */
+		void buildHierarchy(size_t leafSize);
 
         /**
          * Return the sum of drawcalls in the graph of this node.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
 #include <mutex>
 
 #include <vkcv/Core.hpp>
@@ -9,21 +10,31 @@
 #include <vkcv/camera/Camera.hpp>
 #include <vkcv/material/Material.hpp>
 
+#include "CullingStage.hpp"
 #include "Node.hpp"
 
 namespace vkcv::scene {
 
     /**
      * @defgroup vkcv_scene Scene Module
-     * A module to manage basic scene rendering with CPU-side frustum culling.
+     * A module to manage basic scene rendering with CPU-side frustum culling
+     * or batched indirect drawcalls with optional GPU-driven culling.
      * @{
      */
 
+	/**
+	 * An event function type to be called on per material batch recording level to adjust
+	 * data like push constants or descriptor sets with the provided view-projection matrix.
+	 */
+	typedef typename event_function<const glm::mat4&, PushConstants&, vkcv::IndirectDrawcall&>::type RecordBatchDrawcallFunction;
+
     /**
      * A class to represent a scene graph.
      */
 	class Scene {
+		friend class Mesh;
 		friend class MeshPart;
+		friend class CullingStage;
 		
 	private:
         /**
@@ -40,6 +51,33 @@ namespace vkcv::scene {
              */
 			material::Material m_data;
 		};
+		
+		/**
+		 * A nested structure to describe a batch of packed mesh parts
+		 * sharing the same material.
+		 */
+		struct Batch {
+			/**
+			 * The index of the material used to render the batch.
+			 */
+			size_t m_materialIndex;
+			
+			/**
+			 * The index of the first draw command of the batch.
+			 */
+			uint32_t m_firstDraw;
+			
+			/**
+			 * The amount of draw commands in the batch.
+			 */
+			uint32_t m_drawCount;
+		};
+		
+		/**
+		 * A nested structure to manage textures being decoded asynchronously
+		 * and uploaded incrementally into the materials of the scene.
+		 */
+		struct TextureStreaming;
 
         /**
          * A pointer to the current Core instance.
@@ -55,6 +93,49 @@ namespace vkcv::scene {
          * A list of nodes in the first level of the scene graph.
          */
 		std::vector<Node> m_nodes;
+		
+		/**
+		 * The vertex data of all mesh parts packed into shared buffers.
+		 */
+		VertexData m_packedData;
+		
+		/**
+		 * A buffer containing the indexed draw commands of all packed mesh parts.
+		 */
+		BufferHandle m_drawBuffer;
+		
+		/**
+		 * A buffer containing the amount of draw commands per batch.
+		 */
+		BufferHandle m_drawCountBuffer;
+		
+		/**
+		 * A buffer containing the transformation matrix of each packed mesh part.
+		 */
+		BufferHandle m_transformBuffer;
+		
+		/**
+		 * A buffer containing the axis aligned bounding box in world space and
+		 * the batch of each packed mesh part.
+		 */
+		BufferHandle m_boundsBuffer;
+		
+		/**
+		 * A list of batches of packed mesh parts grouped by material.
+		 */
+		std::vector<Batch> m_batches;
+		
+		/**
+		 * The state of streamed textures, which is only set if the scene
+		 * was loaded with streamed textures. Copies of the scene share it.
+		 */
+		std::shared_ptr<TextureStreaming> m_textureStreaming;
+		
+		/**
+		 * The generation of streamed textures the materials of the scene
+		 * were updated to last.
+		 */
+		size_t m_textureGeneration;
 
         /**
          * Constructor of a scene instance with a given Core instance.
@@ -113,6 +194,58 @@ namespace vkcv::scene {
 		void loadMaterial(size_t index, const asset::Scene& scene,
 						  const asset::Material& material);
 		
+		/**
+		 * Extend the axis aligned bounding box in world space of all mesh parts
+		 * using a certain material via its index to prioritize its streamed
+		 * textures.
+		 *
+		 * @param[in] index Index of a material
+		 * @param[in] bounds Axis aligned bounding box of a mesh part
+		 */
+		void extendMaterialBounds(size_t index, const Bounds& bounds);
+		
+		/**
+		 * Update the materials of the scene which got recreated with streamed
+		 * textures since the last update, even if the textures were uploaded
+		 * by another copy of the scene.
+		 */
+		void updateStreamedMaterials();
+		
+		/**
+		 * Pack the vertex and index data of all mesh parts with a loaded material
+		 * from a scene preloaded with the asset loader into shared buffers and
+		 * create the draw commands grouped into batches per material.
+		 *
+		 * @param[in] scene Scene structure from asset loader
+		 * @param[in] types Primitive type order of vertex attributes
+		 */
+		void loadBatches(const asset::Scene& scene,
+						 const std::vector<asset::PrimitiveType>& types);
+		
+		/**
+		 * Record one indirect drawcall per material batch using the given
+		 * buffers for the draw commands and the amount of draws per batch.
+		 *
+		 * @param cmdStream Command stream handle
+		 * @param camera Scene viewing camera
+		 * @param pipeline Graphics pipeline handle
+		 * @param pushConstantsSizePerDrawcall Size of push constants per drawcall
+		 * @param record Batch drawcall recording event function
+		 * @param renderTargets Actual render targets
+		 * @param windowHandle Window handle to use
+		 * @param drawBuffer Buffer containing the draw commands
+		 * @param drawCountBuffer Optional buffer containing the amount of draws per batch
+		 */
+		void recordBatches(CommandStreamHandle       		  &cmdStream,
+						   const camera::Camera			      &camera,
+						   const GraphicsPipelineHandle       &pipeline,
+						   size_t							  pushConstantsSizePerDrawcall,
+						   const RecordBatchDrawcallFunction  &record,
+						   const std::vector<ImageHandle>     &renderTargets,
+						   const WindowHandle                 &windowHandle,
+						   const BufferHandle                 &drawBuffer,
+						   const BufferHandle                 &drawCountBuffer);
+		
 	public:
         /**
          * Destructor of a scene instance.
@@ -172,6 +305,16 @@ namespace vkcv::scene {
 		 */
 		[[nodiscard]]
 		size_t getMeshPartCount() const;
+		
+		/**
+		 * Build the bounding volume hierarchies over the mesh parts of all nodes in
+		 * the scene with a given maximum amount of mesh parts per leaf. The hierarchies
+		 * get used for culling and to order acceleration structures until meshes are
+		 * added to a node.
+		 *
+		 * @param[in] leafSize Maximum amount of mesh parts per leaf
+		 */
+		void buildHierarchy(size_t leafSize = BVH_DEFAULT_LEAF_SIZE);
 
         /**
          * Return the amount of materials managed by this scene.
@@ -212,6 +355,69 @@ namespace vkcv::scene {
 							 const std::vector<ImageHandle>   &renderTargets,
 							 const WindowHandle               &windowHandle);
 		
+		/**
+		 * Return the amount of batches to render packed mesh parts. The scene only
+		 * contains batches if it was loaded with packing enabled.
+		 *
+		 * @return Amount of batches
+		 */
+		[[nodiscard]]
+		size_t getBatchCount() const;
+		
+		/**
+		 * Return the handle of the storage buffer containing the transformation
+		 * matrix of each packed mesh part. The matrix of a mesh part can be
+		 * accessed in shaders via its instance index.
+		 *
+		 * @return Transformation buffer handle
+		 */
+		[[nodiscard]]
+		const BufferHandle& getTransformBuffer() const;
+		
+		/**
+		 * Record drawcalls of all packed mesh parts of this scene with one
+		 * indirect drawcall per material batch. The transformation of each
+		 * mesh part has to be read from the transformation buffer.
+		 *
+		 * @param cmdStream Command stream handle
+		 * @param camera Scene viewing camera
+		 * @param pipeline Graphics pipeline handle
+		 * @param pushConstantsSizePerDrawcall Size of push constants per drawcall
+		 * @param record Batch drawcall recording event function
+		 * @param renderTargets Actual render targets
+		 * @param windowHandle Window handle to use
+		 */
+		void recordBatchDrawcalls(CommandStreamHandle       		 &cmdStream,
+								  const camera::Camera			     &camera,
+								  const GraphicsPipelineHandle       &pipeline,
+								  size_t							 pushConstantsSizePerDrawcall,
+								  const RecordBatchDrawcallFunction  &record,
+								  const std::vector<ImageHandle>     &renderTargets,
+								  const WindowHandle                 &windowHandle);
+		
+		/**
+		 * Record drawcalls of all packed mesh parts of this scene with one
+		 * indirect drawcall per material batch using the draw commands of
+		 * visible mesh parts written by a culling stage.
+		 *
+		 * @param cmdStream Command stream handle
+		 * @param camera Scene viewing camera
+		 * @param pipeline Graphics pipeline handle
+		 * @param pushConstantsSizePerDrawcall Size of push constants per drawcall
+		 * @param record Batch drawcall recording event function
+		 * @param renderTargets Actual render targets
+		 * @param windowHandle Window handle to use
+		 * @param culling Culling stage which recorded the culling of this scene
+		 */
+		void recordBatchDrawcalls(CommandStreamHandle       		 &cmdStream,
+								  const camera::Camera			     &camera,
+								  const GraphicsPipelineHandle       &pipeline,
+								  size_t							 pushConstantsSizePerDrawcall,
+								  const RecordBatchDrawcallFunction  &record,
+								  const std::vector<ImageHandle>     &renderTargets,
+								  const WindowHandle                 &windowHandle,
+								  const CullingStage                 &culling);
+		
 		/**
 		 * Create a top-level acceleration structure representing the scene in current state
 		 * which contains all of its meshes as bottom-level acceleration structures with
@@ -222,6 +428,29 @@ namespace vkcv::scene {
 		 */
 		AccelerationStructureHandle createAccelerationStructure(
 				const ProcessGeometryFunction &process = nullptr) const;
+		
+		/**
+		 * Return the amount of textures which are still being streamed. The
+		 * scene only streams textures if it was loaded with streaming enabled.
+		 *
+		 * @return Amount of pending textures
+		 */
+		[[nodiscard]]
+		size_t getPendingTextureCount() const;
+		
+		/**
+		 * Prioritize streamed textures of materials used by mesh parts which
+		 * are visible or near to a given camera and upload a limited amount of
+		 * textures being decoded already into the materials of the scene. This
+		 * should be called once per frame before recording drawcalls. Copies of
+		 * the scene share the streamed textures, so only one of them needs to
+		 * call this, while the others update their materials while recording.
+		 *
+		 * @param[in] camera Scene viewing camera
+		 * @param[in] maxUploads Maximum amount of textures to upload
+		 * @return Amount of uploaded textures
+		 */
+		size_t updateTextures(const camera::Camera& camera, size_t maxUploads = 4);
 
         /**
          * Instantiation function to create a new scene instance.
@@ -238,11 +467,15 @@ namespace vkcv::scene {
          * @param[in,out] core Current Core instance
          * @param[in] path Path of a valid file to load via asset loader
          * @param[in] types Primitive type order of vertex attributes
+         * @param[in] packed Flag to pack all mesh parts into batches per material
+         * @param[in] streamed Flag to stream textures asynchronously via updateTextures()
          * @return New scene instance
          */
 		static Scene load(Core& core,
 						  const std::filesystem::path &path,
-						  const std::vector<asset::PrimitiveType>& types);
+						  const std::vector<asset::PrimitiveType>& types,
+						  bool packed = false,
+						  bool streamed = false);
 		
 	};
 
@@ -0,0 +1,325 @@
+
+#include "vkcv/scene/BVH.hpp"
+#include "vkcv/scene/Frustum.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+namespace vkcv::scene {
+
+	/**
+	 * The amount of bins to evaluate possible splits per axis.
+	 */
+	constexpr size_t BVH_BIN_COUNT = 16;
+
+	struct BVHBin {
+		Bounds bounds;
+		size_t count;
+	};
+
+	enum class FrustumClassification {
+		OUTSIDE,
+		INTERSECTING,
+		INSIDE
+	};
+
+	static void extendBounds(Bounds& bounds, const Bounds& other) {
+		bounds.extend(other.getMin());
+		bounds.extend(other.getMax());
+	}
+
+	static float getSurfaceArea(const Bounds& bounds) {
+		const glm::vec3 size = bounds.getSize();
+		return 2.0f * (size[0] * size[1] + size[1] * size[2] + size[2] * size[0]);
+	}
+
+	static size_t getBinIndex(float centroid, float min, float scale) {
+		const auto bin = static_cast<size_t>(std::max((centroid - min) * scale, 0.0f));
+		return std::min(bin, BVH_BIN_COUNT - 1);
+	}
+
+	static void buildNode(std::vector<BVHNode>& nodes,
+						  std::vector<uint32_t>& indices,
+						  const std::vector<Bounds>& bounds,
+						  const std::vector<glm::vec3>& centroids,
+						  size_t begin,
+						  size_t end,
+						  size_t leafSize) {
+		const size_t nodeIndex = nodes.size();
+		const size_t count = end - begin;
+
+		Bounds nodeBounds = bounds[indices[begin]];
+		Bounds centroidBounds (centroids[indices[begin]]);
+
+		for (size_t i = begin + 1; i < end; i++) {
+			extendBounds(nodeBounds, bounds[indices[i]]);
+			centroidBounds.extend(centroids[indices[i]]);
+		}
+
+		nodes.push_back({
+			nodeBounds,
+			static_cast<uint32_t>(begin),
+			static_cast<uint32_t>(count)
+		});
+
+		if (count <= leafSize) {
+			return;
+		}
+
+		const glm::vec3 centroidMin = centroidBounds.getMin();
+		const glm::vec3 centroidSize = centroidBounds.getSize();
+
+		int bestAxis = -1;
+		size_t bestSplit = 0;
+		float bestCost = std::numeric_limits<float>::max();
+
+		for (int axis = 0; axis < 3; axis++) {
+			if (centroidSize[axis] <= 0.0f) {
+				continue;
+			}
+
+			const float scale = static_cast<float>(BVH_BIN_COUNT) / centroidSize[axis];
+
+			BVHBin bins [BVH_BIN_COUNT];
+
+			for (auto& bin : bins) {
+				bin.count = 0;
+			}
+
+			for (size_t i = begin; i < end; i++) {
+				const uint32_t index = indices[i];
+				auto& bin = bins[getBinIndex(centroids[index][axis], centroidMin[axis], scale)];
+
+				if (bin.count > 0) {
+					extendBounds(bin.bounds, bounds[index]);
+				} else {
+					bin.bounds = bounds[index];
+				}
+
+				bin.count++;
+			}
+
+			// sweep from the right to accumulate the costs of all right sides first
+			float rightAreas [BVH_BIN_COUNT];
+			size_t rightCounts [BVH_BIN_COUNT];
+
+			Bounds accumulated;
+			size_t accumulatedCount = 0;
+
+			for (size_t i = BVH_BIN_COUNT - 1; i > 0; i--) {
+				if (bins[i].count > 0) {
+					if (accumulatedCount > 0) {
+						extendBounds(accumulated, bins[i].bounds);
+					} else {
+						accumulated = bins[i].bounds;
+					}
+
+					accumulatedCount += bins[i].count;
+				}
+
+				rightAreas[i] = accumulatedCount > 0? getSurfaceArea(accumulated) : 0.0f;
+				rightCounts[i] = accumulatedCount;
+			}
+
+			accumulatedCount = 0;
+
+			for (size_t i = 0; i < BVH_BIN_COUNT - 1; i++) {
+				if (bins[i].count > 0) {
+					if (accumulatedCount > 0) {
+						extendBounds(accumulated, bins[i].bounds);
+					} else {
+						accumulated = bins[i].bounds;
+					}
+
+					accumulatedCount += bins[i].count;
+				}
+
+				if ((accumulatedCount == 0) || (rightCounts[i + 1] == 0)) {
+					continue;
+				}
+
+				const float cost = (
+						static_cast<float>(accumulatedCount) * getSurfaceArea(accumulated) +
+						static_cast<float>(rightCounts[i + 1]) * rightAreas[i + 1]
+				);
+
+				if (cost < bestCost) {
+					bestAxis = axis;
+					bestSplit = i + 1;
+					bestCost = cost;
+				}
+			}
+		}
+
+		size_t middle;
+
+		if (bestAxis >= 0) {
+			const float min = centroidMin[bestAxis];
+			const float scale = static_cast<float>(BVH_BIN_COUNT) / centroidSize[bestAxis];
+
+			const auto it = std::partition(
+					indices.begin() + static_cast<long>(begin),
+					indices.begin() + static_cast<long>(end),
+					[&centroids, bestAxis, bestSplit, min, scale](uint32_t index) {
+						return getBinIndex(centroids[index][bestAxis], min, scale) < bestSplit;
+					}
+			);
+
+			middle = static_cast<size_t>(it - indices.begin());
+		} else {
+			// all centroids are equal, so any split is as good as the median
+			middle = begin + count / 2;
+		}
+
+		buildNode(nodes, indices, bounds, centroids, begin, middle, leafSize);
+
+		nodes[nodeIndex].offset = static_cast<uint32_t>(nodes.size());
+		nodes[nodeIndex].count = 0;
+
+		buildNode(nodes, indices, bounds, centroids, middle, end, leafSize);
+	}
+
+	static FrustumClassification classifyBounds(const glm::vec4 planes [6], const Bounds& bounds) {
+		const glm::vec3 center = bounds.getCenter();
+		const glm::vec3 extent = bounds.getSize() * 0.5f;
+
+		bool inside = true;
+
+		for (size_t i = 0; i < 6; i++) {
+			const glm::vec3 normal (planes[i]);
+
+			const float distance = glm::dot(normal, center) + planes[i][3];
+			const float radius = glm::dot(glm::abs(normal), extent);
+
+			if (distance + radius < 0.0f) {
+				return FrustumClassification::OUTSIDE;
+			}
+
+			if (distance - radius < 0.0f) {
+				inside = false;
+			}
+		}
+
+		return inside? FrustumClassification::INSIDE : FrustumClassification::INTERSECTING;
+	}
+
+	BVH::BVH() :
+	m_nodes(),
+	m_indices(),
+	m_primitives() {}
+
+	void BVH::build(const BoundsArray &bounds, size_t leafSize) {
+		clear();
+
+		const size_t count = bounds.size();
+
+		if (count == 0) {
+			return;
+		}
+
+		std::vector<Bounds> primitives;
+		std::vector<glm::vec3> centroids;
+
+		primitives.reserve(count);
+		centroids.reserve(count);
+		m_indices.reserve(count);
+
+		for (size_t i = 0; i < count; i++) {
+			primitives.push_back(bounds.get(i));
+			centroids.push_back(primitives.back().getCenter());
+			m_indices.push_back(static_cast<uint32_t>(i));
+		}
+
+		m_nodes.reserve(2 * count);
+
+		buildNode(
+				m_nodes,
+				m_indices,
+				primitives,
+				centroids,
+				0,
+				count,
+				std::max<size_t>(leafSize, 1)
+		);
+
+		m_primitives.reserve(count);
+
+		for (const uint32_t index : m_indices) {
+			m_primitives.push_back(primitives[index]);
+		}
+	}
+
+	void BVH::clear() {
+		m_nodes.clear();
+		m_indices.clear();
+		m_primitives.clear();
+	}
+
+	bool BVH::empty() const {
+		return m_nodes.empty();
+	}
+
+	void BVH::cull(const glm::mat4 &transform, std::vector<uint8_t> &visibility) const {
+		visibility.assign(m_indices.size(), 0);
+
+		if (m_nodes.empty()) {
+			return;
+		}
+
+		glm::vec4 planes [6];
+		getFrustumPlanes(transform, planes);
+
+		struct StackEntry {
+			uint32_t node;
+			bool inside;
+		};
+
+		std::vector<StackEntry> stack;
+		stack.reserve(64);
+		stack.push_back({ 0, false });
+
+		while (!stack.empty()) {
+			const StackEntry entry = stack.back();
+			stack.pop_back();
+
+			const BVHNode& node = m_nodes[entry.node];
+			bool inside = entry.inside;
+
+			if (!inside) {
+				const auto classification = classifyBounds(planes, node.bounds);
+
+				if (FrustumClassification::OUTSIDE == classification) {
+					continue;
+				}
+
+				inside = (FrustumClassification::INSIDE == classification);
+			}
+
+			if (node.count > 0) {
+				for (uint32_t i = node.offset; i < node.offset + node.count; i++) {
+					if ((inside) || (FrustumClassification::OUTSIDE != classifyBounds(
+							planes, m_primitives[i]))) {
+						visibility[m_indices[i]] = 1;
+					}
+				}
+
+				continue;
+			}
+
+			stack.push_back({ node.offset, inside });
+			stack.push_back({ entry.node + 1, inside });
+		}
+	}
+
+	const std::vector<BVHNode> &BVH::getNodes() const {
+		return m_nodes;
+	}
+
+	const std::vector<uint32_t> &BVH::getIndices() const {
+		return m_indices;
+	}
+
+}
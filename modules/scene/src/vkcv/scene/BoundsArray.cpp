@@ -0,0 +1,103 @@
+
+#include "vkcv/scene/BoundsArray.hpp"
+
+namespace vkcv::scene {
+
+	static size_t getPaddedSize(size_t count) {
+		return (count + BOUNDS_BATCH_SIZE - 1) / BOUNDS_BATCH_SIZE * BOUNDS_BATCH_SIZE;
+	}
+
+	BoundsArray::BoundsArray() :
+	m_centerX(),
+	m_centerY(),
+	m_centerZ(),
+	m_extentX(),
+	m_extentY(),
+	m_extentZ(),
+	m_count(0) {}
+
+	void BoundsArray::reserve(size_t count) {
+		const size_t paddedSize = getPaddedSize(count);
+
+		m_centerX.reserve(paddedSize);
+		m_centerY.reserve(paddedSize);
+		m_centerZ.reserve(paddedSize);
+		m_extentX.reserve(paddedSize);
+		m_extentY.reserve(paddedSize);
+		m_extentZ.reserve(paddedSize);
+	}
+
+	void BoundsArray::clear() {
+		m_centerX.clear();
+		m_centerY.clear();
+		m_centerZ.clear();
+		m_extentX.clear();
+		m_extentY.clear();
+		m_extentZ.clear();
+		m_count = 0;
+	}
+
+	void BoundsArray::add(const Bounds &bounds) {
+		const glm::vec3 center = bounds.getCenter();
+		const glm::vec3 extent = bounds.getSize() * 0.5f;
+
+		// the padding gets filled with empty boxes at the origin
+		const size_t paddedSize = getPaddedSize(m_count + 1);
+
+		m_centerX.resize(paddedSize, 0.0f);
+		m_centerY.resize(paddedSize, 0.0f);
+		m_centerZ.resize(paddedSize, 0.0f);
+		m_extentX.resize(paddedSize, 0.0f);
+		m_extentY.resize(paddedSize, 0.0f);
+		m_extentZ.resize(paddedSize, 0.0f);
+
+		m_centerX[m_count] = center.x;
+		m_centerY[m_count] = center.y;
+		m_centerZ[m_count] = center.z;
+		m_extentX[m_count] = extent.x;
+		m_extentY[m_count] = extent.y;
+		m_extentZ[m_count] = extent.z;
+
+		m_count++;
+	}
+
+	Bounds BoundsArray::get(size_t index) const {
+		const glm::vec3 center (m_centerX[index], m_centerY[index], m_centerZ[index]);
+		const glm::vec3 extent (m_extentX[index], m_extentY[index], m_extentZ[index]);
+
+		return Bounds(center - extent, center + extent);
+	}
+
+	size_t BoundsArray::size() const {
+		return m_count;
+	}
+
+	bool BoundsArray::empty() const {
+		return (m_count == 0);
+	}
+
+	const float* BoundsArray::getCenterX() const {
+		return m_centerX.data();
+	}
+
+	const float* BoundsArray::getCenterY() const {
+		return m_centerY.data();
+	}
+
+	const float* BoundsArray::getCenterZ() const {
+		return m_centerZ.data();
+	}
+
+	const float* BoundsArray::getExtentX() const {
+		return m_extentX.data();
+	}
+
+	const float* BoundsArray::getExtentY() const {
+		return m_extentY.data();
+	}
+
+	const float* BoundsArray::getExtentZ() const {
+		return m_extentZ.data();
+	}
+
+}
@@ -0,0 +1,385 @@
+
+#include "vkcv/scene/CullingStage.hpp"
+#include "vkcv/scene/Scene.hpp"
+
+#include <vkcv/Buffer.hpp>
+#include <vkcv/Image.hpp>
+#include <vkcv/Logger.hpp>
+#include <vkcv/Sampler.hpp>
+#include <vkcv/shader/GLSLCompiler.hpp>
+
+#include "culling.comp.hxx"
+#include "depthPyramid.comp.hxx"
+
+namespace vkcv::scene {
+
+	/**
+	 * Flag to compact the draw commands of visible mesh parts per batch.
+	 */
+	const uint32_t CULLING_COMPACT = 1;
+
+	/**
+	 * Flag to cull mesh parts being occluded in the depth pyramid.
+	 */
+	const uint32_t CULLING_OCCLUSION = 2;
+
+	struct CullingConstants {
+		glm::mat4 viewProjection;
+		glm::vec2 pyramidSize;
+		uint32_t drawCount;
+		uint32_t flags;
+	};
+
+	static DescriptorBindings getCullingDescriptorBindings() {
+		DescriptorBindings descriptorBindings = {};
+
+		for (uint32_t i = 0; i < 4; i++) {
+			descriptorBindings.insert(std::make_pair(i, DescriptorBinding {
+					i,
+					DescriptorType::STORAGE_BUFFER,
+					1,
+					ShaderStage::COMPUTE,
+					false,
+					false
+			}));
+		}
+
+		descriptorBindings.insert(std::make_pair(4, DescriptorBinding {
+				4,
+				DescriptorType::IMAGE_SAMPLED,
+				1,
+				ShaderStage::COMPUTE,
+				false,
+				false
+		}));
+
+		descriptorBindings.insert(std::make_pair(5, DescriptorBinding {
+				5,
+				DescriptorType::SAMPLER,
+				1,
+				ShaderStage::COMPUTE,
+				false,
+				false
+		}));
+
+		return descriptorBindings;
+	}
+
+	static DescriptorBindings getPyramidDescriptorBindings() {
+		DescriptorBindings descriptorBindings = {};
+
+		auto binding_0 = DescriptorBinding {
+				0,
+				DescriptorType::IMAGE_SAMPLED,
+				1,
+				ShaderStage::COMPUTE,
+				false,
+				false
+		};
+
+		auto binding_1 = DescriptorBinding {
+				1,
+				DescriptorType::SAMPLER,
+				1,
+				ShaderStage::COMPUTE,
+				false,
+				false
+		};
+
+		auto binding_2 = DescriptorBinding {
+				2,
+				DescriptorType::IMAGE_STORAGE,
+				1,
+				ShaderStage::COMPUTE,
+				false,
+				false
+		};
+
+		descriptorBindings.insert(std::make_pair(0, binding_0));
+		descriptorBindings.insert(std::make_pair(1, binding_1));
+		descriptorBindings.insert(std::make_pair(2, binding_2));
+
+		return descriptorBindings;
+	}
+
+	static ComputePipelineHandle createComputePipeline(Core& core,
+													   const std::string& source,
+													   const DescriptorSetLayoutHandle& layout) {
+		vkcv::shader::GLSLCompiler compiler;
+		ShaderProgram program;
+
+		compiler.compileSource(
+				ShaderStage::COMPUTE,
+				source,
+				[&program](ShaderStage stage, const Vector<uint32_t>& binary) {
+					program.addShader(stage, binary);
+				}
+		);
+
+		return core.createComputePipeline({
+			program,
+			{ layout }
+		});
+	}
+
+	CullingStage::CullingStage(Core &core) :
+	m_core(core),
+	m_compact(false),
+	m_occlusion(true),
+	m_cullingPipeline(),
+	m_cullingDescriptorSetLayout(),
+	m_cullingDescriptorSets(),
+	m_pyramidPipeline(),
+	m_pyramidDescriptorSetLayout(),
+	m_pyramidDescriptorSets(),
+	m_sampler(),
+	m_depthPyramid(),
+	m_depthPyramidValid(false),
+	m_drawBuffer(),
+	m_drawCountBuffer(),
+	m_drawCapacity(0),
+	m_batchCapacity(0) {
+		const vkcv::FeatureManager& featureManager = m_core.getContext().getFeatureManager();
+
+		m_compact = featureManager.checkFeatures<vk::PhysicalDeviceVulkan12Features>(
+				vk::StructureType::ePhysicalDeviceVulkan12Features,
+				[](const vk::PhysicalDeviceVulkan12Features& features) {
+					return features.drawIndirectCount;
+				}
+		);
+
+		m_cullingDescriptorSetLayout = m_core.createDescriptorSetLayout(
+				getCullingDescriptorBindings()
+		);
+
+		// the descriptor sets get rewritten while previous frames are still in flight
+		for (uint32_t i = 0; i < m_core.getFramesInFlight(); i++) {
+			m_cullingDescriptorSets.push_back(
+					m_core.createDescriptorSet(m_cullingDescriptorSetLayout)
+			);
+		}
+
+		m_pyramidDescriptorSets.resize(m_core.getFramesInFlight());
+
+		m_cullingPipeline = createComputePipeline(
+				m_core,
+				CULLING_COMP_SHADER,
+				m_cullingDescriptorSetLayout
+		);
+
+		m_pyramidDescriptorSetLayout = m_core.createDescriptorSetLayout(
+				getPyramidDescriptorBindings()
+		);
+
+		m_pyramidPipeline = createComputePipeline(
+				m_core,
+				DEPTHPYRAMID_COMP_SHADER,
+				m_pyramidDescriptorSetLayout
+		);
+
+		m_sampler = samplerNearest(m_core, true);
+
+		// placeholder until the first depth pyramid gets generated
+		m_depthPyramid = image(m_core, vk::Format::eR32Sfloat, 1, 1, 1, false, true).getHandle();
+	}
+
+	void CullingStage::recordCulling(const CommandStreamHandle &cmdStream,
+									 const Scene &scene,
+									 const camera::Camera &camera) {
+		if (scene.m_batches.empty()) {
+			vkcv_log(LogLevel::WARNING, "Scene was not loaded with packed mesh parts");
+			return;
+		}
+
+		const auto& lastBatch = scene.m_batches.back();
+		const size_t drawCount = lastBatch.m_firstDraw + lastBatch.m_drawCount;
+		const size_t batchCount = scene.m_batches.size();
+
+		if (drawCount > m_drawCapacity) {
+			m_drawBuffer = buffer<vk::DrawIndexedIndirectCommand>(
+					m_core, BufferType::INDIRECT, drawCount
+			).getHandle();
+
+			m_drawCapacity = drawCount;
+		}
+
+		if (batchCount > m_batchCapacity) {
+			m_drawCountBuffer = buffer<uint32_t>(
+					m_core, BufferType::INDIRECT, batchCount
+			).getHandle();
+
+			m_batchCapacity = batchCount;
+		}
+
+		const DescriptorSetHandle &cullingDescriptorSet = m_cullingDescriptorSets[
+				m_core.getCurrentFrameInFlight()
+		];
+
+		DescriptorWrites writes;
+		writes.writeStorageBuffer(0, scene.m_drawBuffer);
+		writes.writeStorageBuffer(1, scene.m_boundsBuffer);
+		writes.writeStorageBuffer(2, m_drawBuffer);
+		writes.writeStorageBuffer(3, m_drawCountBuffer);
+		writes.writeSampledImage(4, m_depthPyramid, 0, false, 0,
+								 m_core.getImageMipLevels(m_depthPyramid));
+		writes.writeSampler(5, m_sampler);
+
+		m_core.writeDescriptorSet(cullingDescriptorSet, writes);
+
+		m_core.recordBeginDebugLabel(cmdStream, "vkcv::scene::CullingStage", {
+			0.0f, 0.5f, 1.0f, 1.0f
+		});
+
+		// the previous frame might still draw from the resulting buffers
+		m_core.recordBufferMemoryBarrier(cmdStream, m_drawBuffer);
+		m_core.recordBufferMemoryBarrier(cmdStream, m_drawCountBuffer);
+
+		if (m_compact) {
+			const BufferHandle drawCountBuffer = m_drawCountBuffer;
+
+			m_core.recordCommandsToStream(
+					cmdStream,
+					[this, drawCountBuffer](const vk::CommandBuffer &cmdBuffer) {
+						cmdBuffer.fillBuffer(
+								m_core.getVulkanBuffer(drawCountBuffer),
+								0,
+								VK_WHOLE_SIZE,
+								0
+						);
+					},
+					nullptr
+			);
+
+			m_core.recordMemoryBarrier(cmdStream);
+		}
+
+		m_core.prepareImageForSampling(cmdStream, m_depthPyramid);
+
+		CullingConstants constants;
+		constants.viewProjection = camera.getMVP();
+		constants.pyramidSize = glm::vec2(
+				m_core.getImageWidth(m_depthPyramid),
+				m_core.getImageHeight(m_depthPyramid)
+		);
+
+		constants.drawCount = static_cast<uint32_t>(drawCount);
+		constants.flags = 0;
+
+		if (m_compact) {
+			constants.flags |= CULLING_COMPACT;
+		}
+
+		if ((m_occlusion) && (m_depthPyramidValid)) {
+			constants.flags |= CULLING_OCCLUSION;
+		}
+
+		m_core.recordComputeDispatchToCmdStream(
+				cmdStream,
+				m_cullingPipeline,
+				dispatchInvocations(
+						DispatchSize(static_cast<uint32_t>(drawCount)),
+						DispatchSize(64)
+				),
+				{ useDescriptorSet(0, cullingDescriptorSet) },
+				pushConstants<CullingConstants>(constants)
+		);
+
+		m_core.recordBufferMemoryBarrier(cmdStream, m_drawBuffer);
+		m_core.recordBufferMemoryBarrier(cmdStream, m_drawCountBuffer);
+
+		m_core.recordEndDebugLabel(cmdStream);
+	}
+
+	void CullingStage::recordDepthPyramid(const CommandStreamHandle &cmdStream,
+										  const ImageHandle &depthImage) {
+		const uint32_t width = std::max(m_core.getImageWidth(depthImage) / 2, 1u);
+		const uint32_t height = std::max(m_core.getImageHeight(depthImage) / 2, 1u);
+
+		if ((!m_depthPyramidValid) ||
+			(m_core.getImageWidth(m_depthPyramid) != width) ||
+			(m_core.getImageHeight(m_depthPyramid) != height)) {
+			m_depthPyramid = image(
+					m_core, vk::Format::eR32Sfloat, width, height, 1, true, true
+			).getHandle();
+		}
+
+		const uint32_t levels = m_core.getImageMipLevels(m_depthPyramid);
+
+		auto& pyramidDescriptorSets = m_pyramidDescriptorSets[
+				m_core.getCurrentFrameInFlight()
+		];
+
+		while (pyramidDescriptorSets.size() < levels) {
+			pyramidDescriptorSets.push_back(
+					m_core.createDescriptorSet(m_pyramidDescriptorSetLayout)
+			);
+		}
+
+		m_core.recordBeginDebugLabel(cmdStream, "vkcv::scene::CullingStage", {
+			0.0f, 0.5f, 1.0f, 1.0f
+		});
+
+		m_core.prepareImageForSampling(cmdStream, depthImage);
+		m_core.prepareImageForStorage(cmdStream, m_depthPyramid);
+
+		for (uint32_t level = 0; level < levels; level++) {
+			DescriptorWrites writes;
+
+			if (level > 0) {
+				writes.writeSampledImage(0, m_depthPyramid, level - 1, true);
+			} else {
+				writes.writeSampledImage(0, depthImage);
+			}
+
+			writes.writeSampler(1, m_sampler);
+			writes.writeStorageImage(2, m_depthPyramid, level);
+
+			m_core.writeDescriptorSet(pyramidDescriptorSets[level], writes);
+
+			m_core.recordComputeDispatchToCmdStream(
+					cmdStream,
+					m_pyramidPipeline,
+					dispatchInvocations(
+							DispatchSize(std::max(width >> level, 1u), std::max(height >> level, 1u)),
+							DispatchSize(8, 8)
+					),
+					{ useDescriptorSet(0, pyramidDescriptorSets[level]) },
+					PushConstants(0)
+			);
+
+			m_core.recordImageMemoryBarrier(cmdStream, m_depthPyramid);
+		}
+
+		m_core.prepareImageForSampling(cmdStream, m_depthPyramid);
+		m_core.recordEndDebugLabel(cmdStream);
+
+		m_depthPyramidValid = true;
+	}
+
+	void CullingStage::setOcclusionCulling(bool occlusion) {
+		m_occlusion = occlusion;
+	}
+
+	bool CullingStage::isOcclusionCulling() const {
+		return m_occlusion;
+	}
+
+	const BufferHandle &CullingStage::getDrawBuffer() const {
+		return m_drawBuffer;
+	}
+
+	const BufferHandle &CullingStage::getDrawCountBuffer() const {
+		static BufferHandle noDrawCountBuffer;
+
+		if (!m_compact) {
+			return noDrawCountBuffer;
+		}
+
+		return m_drawCountBuffer;
+	}
+
+	const ImageHandle &CullingStage::getDepthPyramid() const {
+		return m_depthPyramid;
+	}
+
+}
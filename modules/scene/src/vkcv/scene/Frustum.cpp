@@ -1,8 +1,139 @@
 
 #include "vkcv/scene/Frustum.hpp"
 
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#include <emmintrin.h>
+#define VKCV_SCENE_SSE
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#endif
+
 namespace vkcv::scene {
 	
+#if defined(__AVX__)
+	typedef __m256 simd_float;
+	typedef __m256 simd_mask;
+	
+	constexpr size_t SIMD_WIDTH = 8;
+	
+	static inline simd_float simd_load(const float* data) {
+		return _mm256_loadu_ps(data);
+	}
+	
+	static inline simd_float simd_set(float value) {
+		return _mm256_set1_ps(value);
+	}
+	
+	static inline simd_float simd_mul_add(simd_float a, simd_float b, simd_float c) {
+		return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+	}
+	
+	static inline simd_mask simd_mask_all() {
+		return _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+	}
+	
+	static inline simd_mask simd_mask_positive(simd_mask mask, simd_float value) {
+		return _mm256_and_ps(mask, _mm256_cmp_ps(value, _mm256_setzero_ps(), _CMP_GE_OQ));
+	}
+	
+	static inline uint32_t simd_mask_bits(simd_mask mask) {
+		return static_cast<uint32_t>(_mm256_movemask_ps(mask));
+	}
+#elif defined(VKCV_SCENE_SSE)
+	typedef __m128 simd_float;
+	typedef __m128 simd_mask;
+	
+	constexpr size_t SIMD_WIDTH = 4;
+	
+	static inline simd_float simd_load(const float* data) {
+		return _mm_loadu_ps(data);
+	}
+	
+	static inline simd_float simd_set(float value) {
+		return _mm_set1_ps(value);
+	}
+	
+	static inline simd_float simd_mul_add(simd_float a, simd_float b, simd_float c) {
+		return _mm_add_ps(_mm_mul_ps(a, b), c);
+	}
+	
+	static inline simd_mask simd_mask_all() {
+		return _mm_castsi128_ps(_mm_set1_epi32(-1));
+	}
+	
+	static inline simd_mask simd_mask_positive(simd_mask mask, simd_float value) {
+		return _mm_and_ps(mask, _mm_cmpge_ps(value, _mm_setzero_ps()));
+	}
+	
+	static inline uint32_t simd_mask_bits(simd_mask mask) {
+		return static_cast<uint32_t>(_mm_movemask_ps(mask));
+	}
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__))
+	typedef float32x4_t simd_float;
+	typedef uint32x4_t simd_mask;
+	
+	constexpr size_t SIMD_WIDTH = 4;
+	
+	static inline simd_float simd_load(const float* data) {
+		return vld1q_f32(data);
+	}
+	
+	static inline simd_float simd_set(float value) {
+		return vdupq_n_f32(value);
+	}
+	
+	static inline simd_float simd_mul_add(simd_float a, simd_float b, simd_float c) {
+		return vmlaq_f32(c, a, b);
+	}
+	
+	static inline simd_mask simd_mask_all() {
+		return vdupq_n_u32(0xFFFFFFFF);
+	}
+	
+	static inline simd_mask simd_mask_positive(simd_mask mask, simd_float value) {
+		return vandq_u32(mask, vcgeq_f32(value, vdupq_n_f32(0.0f)));
+	}
+	
+	static inline uint32_t simd_mask_bits(simd_mask mask) {
+		static const uint32_t bits [4] = { 1, 2, 4, 8 };
+		return vaddvq_u32(vandq_u32(mask, vld1q_u32(bits)));
+	}
+#else
+	typedef float simd_float;
+	typedef bool simd_mask;
+	
+	constexpr size_t SIMD_WIDTH = 1;
+	
+	static inline simd_float simd_load(const float* data) {
+		return *data;
+	}
+	
+	static inline simd_float simd_set(float value) {
+		return value;
+	}
+	
+	static inline simd_float simd_mul_add(simd_float a, simd_float b, simd_float c) {
+		return a * b + c;
+	}
+	
+	static inline simd_mask simd_mask_all() {
+		return true;
+	}
+	
+	static inline simd_mask simd_mask_positive(simd_mask mask, simd_float value) {
+		return (mask) && (value >= 0.0f);
+	}
+	
+	static inline uint32_t simd_mask_bits(simd_mask mask) {
+		return mask? 1 : 0;
+	}
+#endif
+	
 	static glm::vec3 transformPoint(const glm::mat4& transform, const glm::vec3& point, bool& negative_w) {
 		const glm::vec4 position = transform * glm::vec4(point, 1.0f);
 		
@@ -65,4 +196,101 @@ namespace vkcv::scene {
 		}
 	}
 
+	
+	/**
+	 * Plane of a frustum with its coefficients broadcast to all lanes.
+	 */
+	struct FrustumPlane {
+		simd_float normal [3];
+		simd_float absNormal [3];
+		simd_float distance;
+	};
+	
+	void getFrustumPlanes(const glm::mat4& transform, glm::vec4 planes [6]) {
+		const glm::vec4 row [4] = {
+				glm::vec4(transform[0][0], transform[1][0], transform[2][0], transform[3][0]),
+				glm::vec4(transform[0][1], transform[1][1], transform[2][1], transform[3][1]),
+				glm::vec4(transform[0][2], transform[1][2], transform[2][2], transform[3][2]),
+				glm::vec4(transform[0][3], transform[1][3], transform[2][3], transform[3][3])
+		};
+		
+		// clip space is limited by -w <= x <= w, -w <= y <= w and 0 <= z <= w
+		planes[0] = row[3] + row[0];
+		planes[1] = row[3] - row[0];
+		planes[2] = row[3] + row[1];
+		planes[3] = row[3] - row[1];
+		planes[4] = row[2];
+		planes[5] = row[3] - row[2];
+	}
+	
+	static void loadFrustumPlanes(const glm::mat4& transform, FrustumPlane planes [6]) {
+		glm::vec4 equations [6];
+		getFrustumPlanes(transform, equations);
+		
+		for (size_t i = 0; i < 6; i++) {
+			for (int j = 0; j < 3; j++) {
+				planes[i].normal[j] = simd_set(equations[i][j]);
+				planes[i].absNormal[j] = simd_set(std::abs(equations[i][j]));
+			}
+			
+			planes[i].distance = simd_set(equations[i][3]);
+		}
+	}
+	
+	void checkFrustum(const glm::mat4& transform,
+					  const BoundsArray& bounds,
+					  std::vector<uint8_t>& visibility) {
+		const size_t count = bounds.size();
+		visibility.resize(count);
+		
+		if (count == 0) {
+			return;
+		}
+		
+		FrustumPlane planes [6];
+		loadFrustumPlanes(transform, planes);
+		
+		const float* centerX = bounds.getCenterX();
+		const float* centerY = bounds.getCenterY();
+		const float* centerZ = bounds.getCenterZ();
+		const float* extentX = bounds.getExtentX();
+		const float* extentY = bounds.getExtentY();
+		const float* extentZ = bounds.getExtentZ();
+		
+		// the arrays are padded, so full batches can be read safely
+		for (size_t i = 0; i < count; i += BOUNDS_BATCH_SIZE) {
+			const size_t batchCount = std::min(count - i, BOUNDS_BATCH_SIZE);
+			
+			for (size_t j = 0; j < BOUNDS_BATCH_SIZE; j += SIMD_WIDTH) {
+				const simd_float cx = simd_load(centerX + i + j);
+				const simd_float cy = simd_load(centerY + i + j);
+				const simd_float cz = simd_load(centerZ + i + j);
+				const simd_float ex = simd_load(extentX + i + j);
+				const simd_float ey = simd_load(extentY + i + j);
+				const simd_float ez = simd_load(extentZ + i + j);
+				
+				simd_mask mask = simd_mask_all();
+				
+				// a box is outside if its most positive corner is behind any plane
+				for (const auto& plane : planes) {
+					simd_float d = plane.distance;
+					d = simd_mul_add(plane.normal[0], cx, d);
+					d = simd_mul_add(plane.normal[1], cy, d);
+					d = simd_mul_add(plane.normal[2], cz, d);
+					d = simd_mul_add(plane.absNormal[0], ex, d);
+					d = simd_mul_add(plane.absNormal[1], ey, d);
+					d = simd_mul_add(plane.absNormal[2], ez, d);
+					
+					mask = simd_mask_positive(mask, d);
+				}
+				
+				const uint32_t bits = simd_mask_bits(mask);
+				
+				for (size_t k = 0; (k < SIMD_WIDTH) && (j + k < batchCount); k++) {
+					visibility[i + j + k] = static_cast<uint8_t>((bits >> k) & 1);
+				}
+			}
+		}
+	}
+
 }
@@ -3,6 +3,8 @@
 #include "vkcv/scene/Scene.hpp"
 #include "vkcv/scene/Frustum.hpp"
 
+#include <algorithm>
+
 namespace vkcv::scene {
 	
 	Mesh::Mesh(Scene& scene) :
@@ -41,6 +43,7 @@ namespace vkcv::scene {
 			}
 			
 			auto bounds = transformBounds(m_transform, part.getBounds());
+			m_scene.extendMaterialBounds(part.m_materialIndex, bounds);
 			
 			if (m_parts.empty()) {
 				m_bounds = bounds;
@@ -93,33 +96,36 @@ namespace vkcv::scene {
 	void Mesh::recordDrawcalls(const glm::mat4& viewProjection,
 							   PushConstants& pushConstants,
 							   std::vector<InstanceDrawcall>& drawcalls,
-							   const RecordMeshDrawcallFunction& record) {
+							   const RecordMeshDrawcallFunction& record,
+							   const uint8_t* visibility) {
 		const glm::mat4 transform = viewProjection * m_transform;
 		
-		if (!checkFrustum(viewProjection, m_bounds)) {
-			return;
-		}
-		
-		if (m_drawcalls.size() == 1) {
-			drawcalls.push_back(m_drawcalls[0]);
+		for (size_t i = 0; i < m_drawcalls.size(); i++) {
+			if (!visibility[i]) {
+				continue;
+			}
+			
+			drawcalls.push_back(m_drawcalls[i]);
 			
 			if (record) {
 				record(transform, m_transform, pushConstants, drawcalls.back());
 			}
-		} else {
-			for (size_t i = 0; i < m_parts.size(); i++) {
-				const MeshPart& part = m_parts[i];
-				
-				if (!checkFrustum(transform, part.getBounds())) {
-					continue;
-				}
-				
-				drawcalls.push_back(m_drawcalls[i]);
-				
-				if (record) {
-					record(transform, m_transform, pushConstants, drawcalls.back());
-				}
-			}
+		}
+	}
+	
+	void Mesh::appendPartBounds(BoundsArray &bounds) const {
+		for (const auto& part : m_parts) {
+			bounds.add(transformBounds(m_transform, part.getBounds()));
+		}
+	}
+	
+	void Mesh::updateDrawcalls() {
+		const size_t count = std::min(m_parts.size(), m_drawcalls.size());
+		
+		for (size_t i = 0; i < count; i++) {
+			InstanceDrawcall drawcall (m_parts[i].m_data);
+			drawcall.useDescriptorSet(0, m_parts[i].getMaterial().getDescriptorSet());
+			m_drawcalls[i] = drawcall;
 		}
 	}
 	
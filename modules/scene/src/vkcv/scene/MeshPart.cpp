@@ -2,8 +2,6 @@
 #include "vkcv/scene/MeshPart.hpp"
 #include "vkcv/scene/Scene.hpp"
 
-#include <vkcv/Buffer.hpp>
-
 namespace vkcv::scene {
 	
 	MeshPart::MeshPart(Scene& scene) :
@@ -19,17 +17,28 @@ namespace vkcv::scene {
 						std::vector<InstanceDrawcall>& drawcalls) {
 		Core& core = *(m_scene.m_core);
 		
-		auto vertexBuffer = buffer<uint8_t>(
-				core, BufferType::VERTEX, vertexGroup.vertexBuffer.data.size()
+		// the data might be mapped from file and gets staged without another copy
+		const auto vertexData = vertexGroup.getVertexData();
+		const auto indexData = vertexGroup.getIndexData();
+		
+		// mesh parts share pooled buffers to avoid an allocation per part
+		const BufferRange vertexRange = core.allocateBufferRange(
+				BufferType::VERTEX, vertexData.size()
 		);
 		
-		vertexBuffer.fill(vertexGroup.vertexBuffer.data);
+		core.fillBuffer(
+				vertexRange.m_buffer,
+				vertexData.data(),
+				vertexRange.m_size,
+				vertexRange.m_offset
+		);
 		
 		m_data = VertexData(
 				asset::loadVertexBufferBindings(
 						vertexGroup.vertexBuffer.attributes,
-						vertexBuffer.getHandle(),
-						types
+						vertexRange.m_buffer,
+						types,
+						vertexRange.m_offset
 				)
 		);
 		
@@ -49,12 +58,17 @@ namespace vkcv::scene {
 			);
 		}
 		
-		if (!vertexGroup.indexBuffer.data.empty()) {
-			auto indexBuffer = buffer<uint8_t>(
-					core, BufferType::INDEX, vertexGroup.indexBuffer.data.size()
+		if (!indexData.empty()) {
+			const BufferRange indexRange = core.allocateBufferRange(
+					BufferType::INDEX, indexData.size()
 			);
 			
-			indexBuffer.fill(vertexGroup.indexBuffer.data);
+			core.fillBuffer(
+					indexRange.m_buffer,
+					indexData.data(),
+					indexRange.m_size,
+					indexRange.m_offset
+			);
 			
 			IndexBitCount indexBitCount;
 			switch (vertexGroup.indexBuffer.type) {
@@ -73,11 +87,11 @@ namespace vkcv::scene {
 					break;
 			}
 			
-			m_data.setIndexBuffer(indexBuffer.getHandle(), indexBitCount);
+			m_data.setIndexBuffer(indexRange.m_buffer, indexBitCount, indexRange.m_offset);
 			m_data.setCount(vertexGroup.numIndices);
 			
 			if (m_geometry.isValid()) {
-				m_geometry.setIndexBuffer(indexBuffer.getHandle(), indexBitCount);
+				m_geometry.setIndexBuffer(indexRange.m_buffer, indexBitCount, indexRange.m_offset);
 				m_geometry.setCount(vertexGroup.numIndices);
 			}
 		} else {
@@ -11,7 +11,10 @@ namespace vkcv::scene {
 	m_scene(scene),
 	m_meshes(),
 	m_nodes(),
-	m_bounds() {}
+	m_bounds(),
+	m_partBounds(),
+	m_partVisibility(),
+	m_partHierarchy() {}
 	
 	Node::~Node() {
 		m_nodes.clear();
@@ -36,6 +39,8 @@ namespace vkcv::scene {
 		}
 		
 		m_bounds = other.m_bounds;
+		m_partBounds = other.m_partBounds;
+		m_partHierarchy = other.m_partHierarchy;
 		
 		return *this;
 	}
@@ -54,6 +59,8 @@ namespace vkcv::scene {
 		}
 		
 		m_bounds = other.m_bounds;
+		m_partBounds = std::move(other.m_partBounds);
+		m_partHierarchy = std::move(other.m_partHierarchy);
 		
 		return *this;
 	}
@@ -105,6 +112,10 @@ namespace vkcv::scene {
 		}
 		
 		m_meshes.push_back(mesh);
+		mesh.appendPartBounds(m_partBounds);
+		
+		// the hierarchy does not cover the new mesh parts anymore
+		m_partHierarchy.clear();
 	}
 	
 	void Node::loadMesh(const asset::Scene &asset_scene,
@@ -138,8 +149,18 @@ namespace vkcv::scene {
 			return;
 		}
 		
+		if (m_partHierarchy.empty()) {
+			checkFrustum(viewProjection, m_partBounds, m_partVisibility);
+		} else {
+			m_partHierarchy.cull(viewProjection, m_partVisibility);
+		}
+		
+		size_t offset = 0;
 		for (auto& mesh : m_meshes) {
-			mesh.recordDrawcalls(viewProjection, pushConstants, drawcalls, record);
+			mesh.recordDrawcalls(viewProjection, pushConstants, drawcalls, record,
+								 m_partVisibility.data() + offset);
+			
+			offset += mesh.getDrawcallCount();
 		}
 		
 		for (auto& node : m_nodes) {
@@ -147,11 +168,44 @@ namespace vkcv::scene {
 		}
 	}
 	
+	void Node::updateDrawcalls() {
+		for (auto& mesh : m_meshes) {
+			mesh.updateDrawcalls();
+		}
+		
+		for (auto& node : m_nodes) {
+			node.updateDrawcalls();
+		}
+	}
+	
 	void Node::appendAccelerationStructures(Core& core,
 			std::vector<AccelerationStructureHandle> &accelerationStructures,
 			const ProcessGeometryFunction &process) const {
-		for (auto& mesh : m_meshes) {
-			mesh.appendAccelerationStructures(core, accelerationStructures, process);
+		if (m_partHierarchy.empty()) {
+			for (auto& mesh : m_meshes) {
+				mesh.appendAccelerationStructures(core, accelerationStructures, process);
+			}
+		} else {
+			std::vector<size_t> partMeshes;
+			partMeshes.reserve(m_partBounds.size());
+			
+			for (size_t i = 0; i < m_meshes.size(); i++) {
+				partMeshes.insert(partMeshes.end(), m_meshes[i].getDrawcallCount(), i);
+			}
+			
+			// append neighbouring meshes next to each other for coherent instances
+			std::vector<bool> appended (m_meshes.size(), false);
+			
+			for (const uint32_t index : m_partHierarchy.getIndices()) {
+				const size_t meshIndex = partMeshes[index];
+				
+				if (appended[meshIndex]) {
+					continue;
+				}
+				
+				m_meshes[meshIndex].appendAccelerationStructures(core, accelerationStructures, process);
+				appended[meshIndex] = true;
+			}
 		}
 		
 		for (auto& node : m_nodes) {
@@ -164,60 +218,57 @@ namespace vkcv::scene {
 			return;
 		}
 		
-		const auto split = m_bounds.getCenter();
-		int axis = 0;
+		BoundsArray meshBounds;
+		meshBounds.reserve(m_meshes.size());
 		
-		const auto size = m_bounds.getSize();
-		
-		if (size[1] > size[0]) {
-			if (size[2] > size[1]) {
-				axis = 2;
-			} else {
-				axis = 1;
-			}
-		} else
-		if (size[2] > size[0]) {
-			axis = 2;
+		for (const auto& mesh : m_meshes) {
+			meshBounds.add(mesh.getBounds());
 		}
 		
-		std::vector<size_t> left_meshes;
-		std::vector<size_t> right_meshes;
+		BVH hierarchy;
+		hierarchy.build(meshBounds, maxMeshesPerNode);
 		
-		for (size_t i = 0; i < m_meshes.size(); i++) {
-			const auto& bounds = m_meshes[i].getBounds();
-			
-			if (bounds.getMax()[axis] <= split[axis]) {
-				left_meshes.push_back(i);
-			} else
-			if (bounds.getMin()[axis] >= split[axis]) {
-				right_meshes.push_back(i);
-			}
-		}
+		std::vector<Mesh> meshes;
+		meshes.swap(m_meshes);
 		
-		if ((left_meshes.empty()) || (right_meshes.empty())) {
-			return;
-		}
+		m_partBounds.clear();
+		m_partHierarchy.clear();
 		
-		const size_t left = addNode();
-		const size_t right = addNode();
+		addHierarchyNodes(hierarchy, 0, meshes);
+	}
+	
+	void Node::addHierarchyNodes(const BVH &hierarchy,
+								 size_t index,
+								 const std::vector<Mesh> &meshes) {
+		const auto& nodes = hierarchy.getNodes();
+		const auto& indices = hierarchy.getIndices();
 		
-		for (size_t i : left_meshes) {
-			getNode(left).addMesh(m_meshes[i]);
-		}
+		const BVHNode& node = nodes[index];
 		
-		for (size_t i : right_meshes) {
-			getNode(right).addMesh(m_meshes[i]);
-			left_meshes.push_back(i);
+		if (node.count > 0) {
+			for (uint32_t i = node.offset; i < node.offset + node.count; i++) {
+				addMesh(meshes[indices[i]]);
+			}
+			
+			return;
 		}
 		
-		std::sort(left_meshes.begin(), left_meshes.end(), std::greater());
+		const size_t children [2] = { index + 1, node.offset };
 		
-		for (size_t i : left_meshes) {
-			m_meshes.erase(m_meshes.begin() + static_cast<long>(i));
+		for (const size_t child : children) {
+			Node& subNode = getNode(addNode());
+			
+			subNode.m_bounds = nodes[child].bounds;
+			subNode.addHierarchyNodes(hierarchy, child, meshes);
 		}
+	}
+	
+	void Node::buildHierarchy(size_t leafSize) {
+		m_partHierarchy.build(m_partBounds, leafSize);
 		
-		getNode(left).splitMeshesToSubNodes(maxMeshesPerNode);
-		getNode(right).splitMeshesToSubNodes(maxMeshesPerNode);
+		for (auto& node : m_nodes) {
+			node.buildHierarchy(leafSize);
+		}
 	}
 	
 	size_t Node::getDrawcallCount() const {
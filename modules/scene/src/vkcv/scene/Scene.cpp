@@ -1,21 +1,39 @@
 
 #include "vkcv/scene/Scene.hpp"
+#include "vkcv/scene/Frustum.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtc/type_ptr.hpp>
 
 #include <vkcv/Image.hpp>
 #include <vkcv/Logger.hpp>
 #include <vkcv/Sampler.hpp>
 #include <vkcv/asset/asset_loader.hpp>
-
-#include <vkcv/algorithm/SinglePassDownsampler.hpp>
+#include <vkcv/asset/TextureLoader.hpp>
 
 namespace vkcv::scene {
 	
 	Scene::Scene(Core* core) :
 	m_core(core),
 	m_materials(),
-	m_nodes() {}
+	m_nodes(),
+	m_packedData(),
+	m_drawBuffer(),
+	m_drawCountBuffer(),
+	m_transformBuffer(),
+	m_boundsBuffer(),
+	m_batches(),
+	m_textureStreaming(),
+	m_textureGeneration(0) {}
 	
 	Scene::~Scene() {
+		m_batches.clear();
 		m_nodes.clear();
 		m_materials.clear();
 	}
@@ -23,7 +41,15 @@ namespace vkcv::scene {
 	Scene::Scene(const Scene &other) :
 	m_core(other.m_core),
 	m_materials(other.m_materials),
-	m_nodes() {
+	m_nodes(),
+	m_packedData(other.m_packedData),
+	m_drawBuffer(other.m_drawBuffer),
+	m_drawCountBuffer(other.m_drawCountBuffer),
+	m_transformBuffer(other.m_transformBuffer),
+	m_boundsBuffer(other.m_boundsBuffer),
+	m_batches(other.m_batches),
+	m_textureStreaming(other.m_textureStreaming),
+	m_textureGeneration(other.m_textureGeneration) {
 		m_nodes.resize(other.m_nodes.size(), Node(*this));
 		
 		for (size_t i = 0; i < m_nodes.size(); i++) {
@@ -34,7 +60,15 @@ namespace vkcv::scene {
 	Scene::Scene(Scene &&other) noexcept :
 	m_core(other.m_core),
 	m_materials(other.m_materials),
-	m_nodes() {
+	m_nodes(),
+	m_packedData(other.m_packedData),
+	m_drawBuffer(other.m_drawBuffer),
+	m_drawCountBuffer(other.m_drawCountBuffer),
+	m_transformBuffer(other.m_transformBuffer),
+	m_boundsBuffer(other.m_boundsBuffer),
+	m_batches(other.m_batches),
+	m_textureStreaming(other.m_textureStreaming),
+	m_textureGeneration(other.m_textureGeneration) {
 		m_nodes.resize(other.m_nodes.size(), Node(*this));
 		
 		for (size_t i = 0; i < m_nodes.size(); i++) {
@@ -50,6 +84,15 @@ namespace vkcv::scene {
 		m_core = other.m_core;
 		m_materials = std::vector<Material>(other.m_materials);
 		
+		m_packedData = other.m_packedData;
+		m_drawBuffer = other.m_drawBuffer;
+		m_drawCountBuffer = other.m_drawCountBuffer;
+		m_transformBuffer = other.m_transformBuffer;
+		m_boundsBuffer = other.m_boundsBuffer;
+		m_batches = std::vector<Batch>(other.m_batches);
+		m_textureStreaming = other.m_textureStreaming;
+		m_textureGeneration = other.m_textureGeneration;
+		
 		m_nodes.resize(other.m_nodes.size(), Node(*this));
 		
 		for (size_t i = 0; i < m_nodes.size(); i++) {
@@ -63,6 +106,15 @@ namespace vkcv::scene {
 		m_core = other.m_core;
 		m_materials = std::move(other.m_materials);
 		
+		m_packedData = other.m_packedData;
+		m_drawBuffer = other.m_drawBuffer;
+		m_drawCountBuffer = other.m_drawCountBuffer;
+		m_transformBuffer = other.m_transformBuffer;
+		m_boundsBuffer = other.m_boundsBuffer;
+		m_batches = std::move(other.m_batches);
+		m_textureStreaming = std::move(other.m_textureStreaming);
+		m_textureGeneration = other.m_textureGeneration;
+		
 		m_nodes.resize(other.m_nodes.size(), Node(*this));
 		
 		for (size_t i = 0; i < m_nodes.size(); i++) {
@@ -129,6 +181,12 @@ namespace vkcv::scene {
 		return count;
 	}
 	
+	void Scene::buildHierarchy(size_t leafSize) {
+		for (auto& node : m_nodes) {
+			node.buildHierarchy(leafSize);
+		}
+	}
+	
 	size_t Scene::getMaterialCount() const {
 		return m_materials.size();
 	}
@@ -151,6 +209,8 @@ namespace vkcv::scene {
 								const RecordMeshDrawcallFunction &record,
 								const std::vector<ImageHandle>   &renderTargets,
 								const WindowHandle               &windowHandle) {
+		updateStreamedMaterials();
+		
 		m_core->recordBeginDebugLabel(cmdStream, "vkcv::scene::Scene", {
 			0.0f, 1.0f, 0.0f, 1.0f
 		});
@@ -166,7 +226,7 @@ namespace vkcv::scene {
 			node.recordDrawcalls(viewProjection, pushConstants, drawcalls, record);
 		}
 		
-		vkcv_log(LogLevel::RAW_INFO, "Frustum culling: %lu / %lu", drawcalls.size(), count);
+		vkcv_log(LogLevel::RAW_INFO, "Frustum culling: %zu / %zu", drawcalls.size(), count);
 		
 		m_core->recordDrawcallsToCmdStream(
 				cmdStream,
@@ -180,6 +240,116 @@ namespace vkcv::scene {
 		m_core->recordEndDebugLabel(cmdStream);
 	}
 	
+	size_t Scene::getBatchCount() const {
+		return m_batches.size();
+	}
+	
+	const BufferHandle &Scene::getTransformBuffer() const {
+		return m_transformBuffer;
+	}
+	
+	void Scene::recordBatches(CommandStreamHandle       		&cmdStream,
+							  const camera::Camera			    &camera,
+							  const GraphicsPipelineHandle      &pipeline,
+							  size_t							pushConstantsSizePerDrawcall,
+							  const RecordBatchDrawcallFunction &record,
+							  const std::vector<ImageHandle>    &renderTargets,
+							  const WindowHandle                &windowHandle,
+							  const BufferHandle                &drawBuffer,
+							  const BufferHandle                &drawCountBuffer) {
+		if (m_batches.empty()) {
+			vkcv_log(LogLevel::WARNING, "Scene was not loaded with packed mesh parts");
+			return;
+		}
+		
+		updateStreamedMaterials();
+		
+		m_core->recordBeginDebugLabel(cmdStream, "vkcv::scene::Scene", {
+			0.0f, 1.0f, 0.0f, 1.0f
+		});
+		
+		PushConstants pushConstants (pushConstantsSizePerDrawcall);
+		std::vector<IndirectDrawcall> drawcalls;
+		drawcalls.reserve(m_batches.size());
+		
+		const glm::mat4 viewProjection = camera.getMVP();
+		
+		for (size_t i = 0; i < m_batches.size(); i++) {
+			const Batch& batch = m_batches[i];
+			
+			IndirectDrawcall drawcall (
+					drawBuffer,
+					m_packedData,
+					batch.m_drawCount,
+					batch.m_firstDraw * sizeof(vk::DrawIndexedIndirectCommand)
+			);
+			
+			if (drawCountBuffer) {
+				drawcall.useDrawCountBuffer(drawCountBuffer, i * sizeof(uint32_t));
+			}
+			
+			drawcall.useDescriptorSet(0, getMaterial(batch.m_materialIndex).getDescriptorSet());
+			
+			if (record) {
+				record(viewProjection, pushConstants, drawcall);
+			}
+			
+			drawcalls.push_back(drawcall);
+		}
+		
+		m_core->recordIndirectDrawcallsToCmdStream(
+				cmdStream,
+				pipeline,
+				pushConstants,
+				drawcalls,
+				renderTargets,
+				windowHandle
+		);
+		
+		m_core->recordEndDebugLabel(cmdStream);
+	}
+	
+	void Scene::recordBatchDrawcalls(CommandStreamHandle       		   &cmdStream,
+									 const camera::Camera			   &camera,
+									 const GraphicsPipelineHandle      &pipeline,
+									 size_t							   pushConstantsSizePerDrawcall,
+									 const RecordBatchDrawcallFunction &record,
+									 const std::vector<ImageHandle>    &renderTargets,
+									 const WindowHandle                &windowHandle) {
+		recordBatches(
+				cmdStream,
+				camera,
+				pipeline,
+				pushConstantsSizePerDrawcall,
+				record,
+				renderTargets,
+				windowHandle,
+				m_drawBuffer,
+				m_drawCountBuffer
+		);
+	}
+	
+	void Scene::recordBatchDrawcalls(CommandStreamHandle       		   &cmdStream,
+									 const camera::Camera			   &camera,
+									 const GraphicsPipelineHandle      &pipeline,
+									 size_t							   pushConstantsSizePerDrawcall,
+									 const RecordBatchDrawcallFunction &record,
+									 const std::vector<ImageHandle>    &renderTargets,
+									 const WindowHandle                &windowHandle,
+									 const CullingStage                &culling) {
+		recordBatches(
+				cmdStream,
+				camera,
+				pipeline,
+				pushConstantsSizePerDrawcall,
+				record,
+				renderTargets,
+				windowHandle,
+				culling.getDrawBuffer(),
+				culling.getDrawCountBuffer()
+		);
+	}
+	
 	AccelerationStructureHandle Scene::createAccelerationStructure(
 			const ProcessGeometryFunction &process) const {
 		std::vector<AccelerationStructureHandle> accelerationStructures;
@@ -195,20 +365,14 @@ namespace vkcv::scene {
 		return Scene(&core);
 	}
 	
-	static void loadImage(Core& core, const asset::Scene& asset_scene,
-						  const asset::Texture& asset_texture,
-						  const vk::Format& format,
-						  ImageHandle& image, SamplerHandle& sampler) {
+	static SamplerHandle loadSampler(Core& core, const asset::Scene& asset_scene,
+									 const asset::Texture& asset_texture) {
 		const asset::Sampler* asset_sampler = nullptr;
 		
 		if ((asset_texture.sampler >= 0) && (asset_texture.sampler < asset_scene.samplers.size())) {
 			asset_sampler = &(asset_scene.samplers[asset_texture.sampler]);
 		}
 		
-		Image img = vkcv::image(core, format, asset_texture.w, asset_texture.h, 1, true);
-		img.fill(asset_texture.data.data());
-		image = img.getHandle();
-		
 		SamplerFilterType magFilter = SamplerFilterType::LINEAR;
 		SamplerFilterType minFilter = SamplerFilterType::LINEAR;
 		SamplerMipmapMode mipmapMode = SamplerMipmapMode::LINEAR;
@@ -273,7 +437,7 @@ namespace vkcv::scene {
 			mipLodBias = asset_sampler->minLOD;
 		}
 		
-		sampler = core.createSampler(
+		return core.createSampler(
 				magFilter,
 				minFilter,
 				mipmapMode,
@@ -282,52 +446,180 @@ namespace vkcv::scene {
 		);
 	}
 	
-	void Scene::loadMaterial(size_t index, const asset::Scene& scene,
-							 const asset::Material& material) {
-		if (index >= m_materials.size()) {
-			return;
-		}
+	/**
+	 * Pairs of image formats storing the same blocks either with linear
+	 * or with sRGB encoded colors.
+	 */
+	static const std::pair<vk::Format, vk::Format> SRGB_FORMATS [] = {
+			{ vk::Format::eR8G8B8A8Unorm, vk::Format::eR8G8B8A8Srgb },
+			{ vk::Format::eB8G8R8A8Unorm, vk::Format::eB8G8R8A8Srgb },
+			{ vk::Format::eBc1RgbUnormBlock, vk::Format::eBc1RgbSrgbBlock },
+			{ vk::Format::eBc1RgbaUnormBlock, vk::Format::eBc1RgbaSrgbBlock },
+			{ vk::Format::eBc2UnormBlock, vk::Format::eBc2SrgbBlock },
+			{ vk::Format::eBc3UnormBlock, vk::Format::eBc3SrgbBlock },
+			{ vk::Format::eBc7UnormBlock, vk::Format::eBc7SrgbBlock },
+			{ vk::Format::eEtc2R8G8B8UnormBlock, vk::Format::eEtc2R8G8B8SrgbBlock },
+			{ vk::Format::eEtc2R8G8B8A1UnormBlock, vk::Format::eEtc2R8G8B8A1SrgbBlock },
+			{ vk::Format::eEtc2R8G8B8A8UnormBlock, vk::Format::eEtc2R8G8B8A8SrgbBlock },
+			{ vk::Format::eAstc4x4UnormBlock, vk::Format::eAstc4x4SrgbBlock },
+			{ vk::Format::eAstc5x4UnormBlock, vk::Format::eAstc5x4SrgbBlock },
+			{ vk::Format::eAstc5x5UnormBlock, vk::Format::eAstc5x5SrgbBlock },
+			{ vk::Format::eAstc6x5UnormBlock, vk::Format::eAstc6x5SrgbBlock },
+			{ vk::Format::eAstc6x6UnormBlock, vk::Format::eAstc6x6SrgbBlock },
+			{ vk::Format::eAstc8x5UnormBlock, vk::Format::eAstc8x5SrgbBlock },
+			{ vk::Format::eAstc8x6UnormBlock, vk::Format::eAstc8x6SrgbBlock },
+			{ vk::Format::eAstc8x8UnormBlock, vk::Format::eAstc8x8SrgbBlock },
+			{ vk::Format::eAstc10x5UnormBlock, vk::Format::eAstc10x5SrgbBlock },
+			{ vk::Format::eAstc10x6UnormBlock, vk::Format::eAstc10x6SrgbBlock },
+			{ vk::Format::eAstc10x8UnormBlock, vk::Format::eAstc10x8SrgbBlock },
+			{ vk::Format::eAstc10x10UnormBlock, vk::Format::eAstc10x10SrgbBlock },
+			{ vk::Format::eAstc12x10UnormBlock, vk::Format::eAstc12x10SrgbBlock },
+			{ vk::Format::eAstc12x12UnormBlock, vk::Format::eAstc12x12SrgbBlock }
+	};
+	
+	/**
+	 * The block-compressed formats to transcode universal textures into
+	 * in order of preference.
+	 */
+	static const vk::Format TRANSCODE_FORMATS [] = {
+			vk::Format::eBc7UnormBlock,
+			vk::Format::eAstc4x4UnormBlock,
+			vk::Format::eEtc2R8G8B8A8UnormBlock,
+			vk::Format::eBc3UnormBlock
+	};
+	
+	static bool isFormatSupported(Core& core, vk::Format format) {
+		const vk::PhysicalDevice& physicalDevice = core.getContext().getPhysicalDevice();
+		const vk::FormatProperties properties = physicalDevice.getFormatProperties(format);
 		
-		ImageHandle diffuseImg;
-		SamplerHandle diffuseSmp;
+		return static_cast<bool>(
+				properties.optimalTilingFeatures & vk::FormatFeatureFlagBits::eSampledImage
+		);
+	}
+	
+	static std::vector<int> getTranscodeFormats(Core& core) {
+		std::vector<int> formats;
 		
-		if ((material.baseColor >= 0) && (material.baseColor < scene.textures.size())) {
-			loadImage(*m_core, scene, scene.textures[material.baseColor], vk::Format::eR8G8B8A8Srgb,
-					  diffuseImg, diffuseSmp);
+		for (const auto& format : TRANSCODE_FORMATS) {
+			if (isFormatSupported(core, format)) {
+				formats.push_back(static_cast<int>(format));
+			}
 		}
 		
-		ImageHandle normalImg;
-		SamplerHandle normalSmp;
-		
-		if ((material.normal >= 0) && (material.normal < scene.textures.size())) {
-			loadImage(*m_core, scene, scene.textures[material.normal], vk::Format::eR8G8B8A8Unorm,
-					  normalImg, normalSmp);
+		return formats;
+	}
+	
+	/**
+	 * Returns the image format to upload a texture with, matching the color
+	 * encoding of the format the material expects for the texture.
+	 *
+	 * @param[in] format VkFormat of the texture data, undefined for RGBA pixels
+	 * @param[in] materialFormat Image format of the material texture
+	 * @return Image format of the texture
+	 */
+	static vk::Format getTextureFormat(int format, vk::Format materialFormat) {
+		if (format == VK_FORMAT_UNDEFINED) {
+			return materialFormat;
 		}
 		
-		ImageHandle metalRoughImg;
-		SamplerHandle metalRoughSmp;
+		const auto textureFormat = static_cast<vk::Format>(format);
+		const bool srgb = (materialFormat == vk::Format::eR8G8B8A8Srgb);
+		
+		for (const auto& formats : SRGB_FORMATS) {
+			if ((formats.first == textureFormat) || (formats.second == textureFormat)) {
+				return srgb? formats.second : formats.first;
+			}
+		}
 		
-		if ((material.metalRough >= 0) && (material.metalRough < scene.textures.size())) {
-			loadImage(*m_core, scene, scene.textures[material.metalRough], vk::Format::eR8G8B8A8Unorm,
-					  metalRoughImg, metalRoughSmp);
+		return textureFormat;
+	}
+	
+	/**
+	 * Creates an image and fills it with the data of a texture. Textures
+	 * with prebuilt mip levels only get as many mip levels as they provide.
+	 *
+	 * @param[in,out] core Core instance
+	 * @param[in] format Image format of the texture
+	 * @param[in] width Width of the texture
+	 * @param[in] height Height of the texture
+	 * @param[in] levels Amount of mip levels in the data
+	 * @param[in] data Data of the texture
+	 * @param[in] size Size of the data in bytes
+	 * @return Image handle or an invalid handle if the format is not supported
+	 */
+	static ImageHandle createTextureImage(Core& core, vk::Format format,
+										  uint32_t width, uint32_t height, uint32_t levels,
+										  const void* data, size_t size) {
+		if (!isFormatSupported(core, format)) {
+			vkcv_log(LogLevel::WARNING, "Texture format is not supported (%s)",
+					 vk::to_string(format).c_str());
+			return {};
 		}
 		
-		ImageHandle occlusionImg;
-		SamplerHandle occlusionSmp;
+		ImageConfig config (width, height);
 		
-		if ((material.occlusion >= 0) && (material.occlusion < scene.textures.size())) {
-			loadImage(*m_core, scene, scene.textures[material.occlusion], vk::Format::eR8G8B8A8Unorm,
-					  occlusionImg, occlusionSmp);
+		if ((levels > 1) || (isCompressedFormat(format))) {
+			config.setMipCount(levels);
 		}
 		
-		ImageHandle emissionImg;
-		SamplerHandle emissionSmp;
+		Image img = vkcv::image(core, format, config, true);
 		
-		if ((material.emissive >= 0) && (material.emissive < scene.textures.size())) {
-			loadImage(*m_core, scene, scene.textures[material.emissive], vk::Format::eR8G8B8A8Srgb,
-					  emissionImg, emissionSmp);
+		if (!img.getHandle()) {
+			return {};
 		}
 		
+		img.fillMipLevels(0, levels, data, size);
+		
+		core.setDebugLabel(img.getHandle(), "vkcv::scene::Scene");
+		return img.getHandle();
+	}
+	
+	static void loadImage(Core& core, const asset::Scene& asset_scene,
+						  const asset::Texture& asset_texture,
+						  const vk::Format& format,
+						  ImageHandle& image, SamplerHandle& sampler) {
+		image = createTextureImage(
+				core,
+				getTextureFormat(asset_texture.format, format),
+				asset_texture.w,
+				asset_texture.h,
+				asset_texture.levels,
+				asset_texture.data.data(),
+				asset_texture.data.size()
+		);
+		
+		sampler = loadSampler(core, asset_scene, asset_texture);
+	}
+	
+	/**
+	 * The amount of textures used by a material.
+	 */
+	constexpr size_t MATERIAL_TEXTURE_COUNT = 5;
+	
+	/**
+	 * The image formats of the textures used by a material in order of
+	 * base color, normal, metallic and roughness, occlusion and emission.
+	 */
+	static const vk::Format MATERIAL_TEXTURE_FORMATS [MATERIAL_TEXTURE_COUNT] = {
+			vk::Format::eR8G8B8A8Srgb,
+			vk::Format::eR8G8B8A8Unorm,
+			vk::Format::eR8G8B8A8Unorm,
+			vk::Format::eR8G8B8A8Unorm,
+			vk::Format::eR8G8B8A8Srgb
+	};
+	
+	static void getMaterialTextures(const asset::Material& material,
+									int textures [MATERIAL_TEXTURE_COUNT]) {
+		textures[0] = material.baseColor;
+		textures[1] = material.normal;
+		textures[2] = material.metalRough;
+		textures[3] = material.occlusion;
+		textures[4] = material.emissive;
+	}
+	
+	static material::Material createMaterial(Core& core, const asset::Material& material,
+											 const ImageHandle images [MATERIAL_TEXTURE_COUNT],
+											 const SamplerHandle samplers [MATERIAL_TEXTURE_COUNT]) {
 		const float colorFactors [4] = {
 				material.baseColorFactor.r,
 				material.baseColorFactor.g,
@@ -342,13 +634,13 @@ namespace vkcv::scene {
 				0.0f
 		};
 		
-		m_materials[index].m_data = material::Material::createPBR(
-				*m_core,
-				diffuseImg, diffuseSmp,
-				normalImg, normalSmp,
-				metalRoughImg, metalRoughSmp,
-				occlusionImg, occlusionSmp,
-				emissionImg, emissionSmp,
+		return material::Material::createPBR(
+				core,
+				images[0], samplers[0],
+				images[1], samplers[1],
+				images[2], samplers[2],
+				images[3], samplers[3],
+				images[4], samplers[4],
 				colorFactors,
 				material.normalScale,
 				material.metallicFactor,
@@ -358,12 +650,607 @@ namespace vkcv::scene {
 		);
 	}
 	
+	struct Scene::TextureStreaming {
+		/**
+		 * The texture loader decoding the requested textures.
+		 */
+		asset::TextureLoader m_loader;
+		
+		/**
+		 * The materials from the asset loader per material index.
+		 */
+		std::vector<asset::Material> m_materials;
+		
+		/**
+		 * The axis aligned bounding boxes in world space of all mesh parts
+		 * per material index.
+		 */
+		std::vector<Bounds> m_materialBounds;
+		
+		/**
+		 * The uploaded images per texture index.
+		 */
+		std::vector<ImageHandle> m_images;
+		
+		/**
+		 * The samplers per texture index.
+		 */
+		std::vector<SamplerHandle> m_samplers;
+		
+		/**
+		 * The image formats per texture index.
+		 */
+		std::vector<vk::Format> m_formats;
+		
+		/**
+		 * The indices of materials using a texture per texture index.
+		 */
+		std::vector<std::vector<size_t>> m_textureMaterials;
+		
+		/**
+		 * The materials recreated with uploaded textures per material index,
+		 * which all copies of the scene take over.
+		 */
+		std::vector<material::Material> m_streamedMaterials;
+		
+		/**
+		 * The generation each material was recreated in last per material index.
+		 */
+		std::vector<size_t> m_materialGenerations;
+		
+		/**
+		 * The generation of the latest uploads of textures.
+		 */
+		size_t m_generation;
+		
+		TextureStreaming(Core& core, const asset::Scene& scene) :
+		m_loader(0, 8, getTranscodeFormats(core)),
+		m_materials(scene.materials.size()),
+		m_materialBounds(scene.materials.size(), Bounds(
+				glm::vec3(std::numeric_limits<float>::max()),
+				glm::vec3(std::numeric_limits<float>::lowest())
+		)),
+		m_images(scene.textures.size()),
+		m_samplers(scene.textures.size()),
+		m_formats(scene.textures.size(), vk::Format::eUndefined),
+		m_textureMaterials(scene.textures.size()),
+		m_streamedMaterials(scene.materials.size()),
+		m_materialGenerations(scene.materials.size(), 0),
+		m_generation(0) {}
+		
+		/**
+		 * Request a texture used by a material to be decoded unless it was
+		 * requested already.
+		 *
+		 * @param[in,out] core Core instance
+		 * @param[in] scene Scene structure from asset loader
+		 * @param[in] texture Index of the texture
+		 * @param[in] material Index of the material
+		 * @param[in] format Image format of the texture
+		 */
+		void request(Core& core, const asset::Scene& scene,
+					 size_t texture, size_t material, vk::Format format) {
+			auto& materials = m_textureMaterials[texture];
+			
+			if (std::find(materials.begin(), materials.end(), material) == materials.end()) {
+				materials.push_back(material);
+			}
+			
+			if (m_formats[texture] != vk::Format::eUndefined) {
+				return;
+			}
+			
+			m_formats[texture] = format;
+			m_samplers[texture] = loadSampler(core, scene, scene.textures[texture]);
+			m_loader.request(texture, scene.textures[texture]);
+		}
+		
+		/**
+		 * Get the images uploaded so far and the samplers of all textures used
+		 * by a material. Images of textures which are still pending stay invalid.
+		 *
+		 * @param[in] material Material structure from asset loader
+		 * @param[out] images Images of the material
+		 * @param[out] samplers Samplers of the material
+		 */
+		void getTextures(const asset::Material& material,
+						 ImageHandle images [MATERIAL_TEXTURE_COUNT],
+						 SamplerHandle samplers [MATERIAL_TEXTURE_COUNT]) const {
+			int textures [MATERIAL_TEXTURE_COUNT];
+			getMaterialTextures(material, textures);
+			
+			for (size_t i = 0; i < MATERIAL_TEXTURE_COUNT; i++) {
+				if ((textures[i] < 0) || (textures[i] >= m_images.size())) {
+					continue;
+				}
+				
+				images[i] = m_images[textures[i]];
+				samplers[i] = m_samplers[textures[i]];
+			}
+		}
+	};
+	
+	void Scene::loadMaterial(size_t index, const asset::Scene& scene,
+							 const asset::Material& material) {
+		if (index >= m_materials.size()) {
+			return;
+		}
+		
+		int textures [MATERIAL_TEXTURE_COUNT];
+		getMaterialTextures(material, textures);
+		
+		ImageHandle images [MATERIAL_TEXTURE_COUNT];
+		SamplerHandle samplers [MATERIAL_TEXTURE_COUNT];
+		
+		for (size_t i = 0; i < MATERIAL_TEXTURE_COUNT; i++) {
+			if ((textures[i] < 0) || (textures[i] >= scene.textures.size())) {
+				continue;
+			}
+			
+			if (m_textureStreaming) {
+				m_textureStreaming->request(*m_core, scene, textures[i], index,
+											MATERIAL_TEXTURE_FORMATS[i]);
+			} else {
+				loadImage(*m_core, scene, scene.textures[textures[i]], MATERIAL_TEXTURE_FORMATS[i],
+						  images[i], samplers[i]);
+			}
+		}
+		
+		// streamed materials use default images until their textures get uploaded
+		if (m_textureStreaming) {
+			m_textureStreaming->m_materials[index] = material;
+			m_textureStreaming->getTextures(material, images, samplers);
+		}
+		
+		m_materials[index].m_data = createMaterial(*m_core, material, images, samplers);
+	}
+	
+	void Scene::extendMaterialBounds(size_t index, const Bounds& bounds) {
+		if ((!m_textureStreaming) || (index >= m_textureStreaming->m_materialBounds.size())) {
+			return;
+		}
+		
+		Bounds& materialBounds = m_textureStreaming->m_materialBounds[index];
+		
+		if (!materialBounds) {
+			materialBounds = bounds;
+		} else {
+			materialBounds.extend(bounds.getMin());
+			materialBounds.extend(bounds.getMax());
+		}
+	}
+	
+	void Scene::updateStreamedMaterials() {
+		if ((!m_textureStreaming) || (m_textureGeneration == m_textureStreaming->m_generation)) {
+			return;
+		}
+		
+		const TextureStreaming& streaming = *m_textureStreaming;
+		const size_t count = std::min(m_materials.size(), streaming.m_streamedMaterials.size());
+		
+		for (size_t i = 0; i < count; i++) {
+			if (streaming.m_materialGenerations[i] > m_textureGeneration) {
+				m_materials[i].m_data = streaming.m_streamedMaterials[i];
+			}
+		}
+		
+		m_textureGeneration = streaming.m_generation;
+		
+		for (auto& node : m_nodes) {
+			node.updateDrawcalls();
+		}
+	}
+	
+	size_t Scene::getPendingTextureCount() const {
+		if (!m_textureStreaming) {
+			return 0;
+		}
+		
+		return m_textureStreaming->m_loader.getPendingCount();
+	}
+	
+	size_t Scene::updateTextures(const camera::Camera& camera, size_t maxUploads) {
+		updateStreamedMaterials();
+		
+		if ((!m_textureStreaming) || (m_textureStreaming->m_loader.getPendingCount() == 0)) {
+			return 0;
+		}
+		
+		TextureStreaming& streaming = *m_textureStreaming;
+		const size_t generation = streaming.m_generation + 1;
+		
+		const glm::mat4 viewProjection = camera.getMVP();
+		const glm::vec3& position = camera.getPosition();
+		
+		std::vector<float> distances (streaming.m_materialBounds.size(), -1.0f);
+		std::vector<uint8_t> visibility (streaming.m_materialBounds.size(), 0);
+		float maxDistance = 0.0f;
+		
+		for (size_t i = 0; i < streaming.m_materialBounds.size(); i++) {
+			const Bounds& bounds = streaming.m_materialBounds[i];
+			
+			if (!bounds) {
+				continue;
+			}
+			
+			const glm::vec3 closest = glm::clamp(position, bounds.getMin(), bounds.getMax());
+			
+			distances[i] = glm::distance(position, closest);
+			visibility[i] = checkFrustum(viewProjection, bounds)? 1 : 0;
+			maxDistance = std::max(maxDistance, distances[i]);
+		}
+		
+		// textures of visible materials come first, each ordered by distance to the camera
+		for (size_t i = 0; i < streaming.m_textureMaterials.size(); i++) {
+			if ((streaming.m_formats[i] == vk::Format::eUndefined) || (streaming.m_images[i])) {
+				continue;
+			}
+			
+			float priority = std::numeric_limits<float>::max();
+			
+			for (const auto& material : streaming.m_textureMaterials[i]) {
+				if (distances[material] < 0.0f) {
+					continue;
+				}
+				
+				priority = std::min(priority, visibility[material]?
+						distances[material] : distances[material] + maxDistance + 1.0f);
+			}
+			
+			streaming.m_loader.prioritize(i, priority);
+		}
+		
+		asset::DecodedTexture texture;
+		size_t uploads = 0;
+		bool uploaded = false;
+		
+		while ((uploads < maxUploads) && (streaming.m_loader.poll(texture))) {
+			uploads++;
+			
+			if (!texture.pixels) {
+				continue;
+			}
+			
+			const vk::Format format = getTextureFormat(
+					texture.format, streaming.m_formats[texture.index]
+			);
+			
+			const ImageHandle image = createTextureImage(
+					*m_core,
+					format,
+					texture.width,
+					texture.height,
+					texture.levels,
+					texture.pixels.get(),
+					texture.size
+			);
+			
+			if (!image) {
+				continue;
+			}
+			
+			// prebuilt mip levels don't need to be generated
+			if ((texture.levels <= 1) && (!isCompressedFormat(format))) {
+				m_core->recordMipChainGenerationToUploads(image);
+			}
+			
+			uploaded = true;
+			
+			streaming.m_images[texture.index] = image;
+			
+			// the materials get recreated since their descriptor sets might be in use
+			for (const auto& material : streaming.m_textureMaterials[texture.index]) {
+				ImageHandle images [MATERIAL_TEXTURE_COUNT];
+				SamplerHandle samplers [MATERIAL_TEXTURE_COUNT];
+				
+				streaming.getTextures(streaming.m_materials[material], images, samplers);
+				
+				streaming.m_streamedMaterials[material] = createMaterial(
+						*m_core, streaming.m_materials[material], images, samplers
+				);
+				
+				streaming.m_materialGenerations[material] = generation;
+			}
+		}
+		
+		if (uploaded) {
+			m_core->flushUploads();
+			
+			// copies of the scene take over the recreated materials when recording
+			streaming.m_generation = generation;
+			updateStreamedMaterials();
+		}
+		
+		return uploads;
+	}
+	
+	static size_t getComponentSize(asset::ComponentType componentType) {
+		switch (componentType) {
+			case asset::ComponentType::INT8:
+			case asset::ComponentType::UINT8:
+				return 1;
+			case asset::ComponentType::INT16:
+			case asset::ComponentType::UINT16:
+				return 2;
+			case asset::ComponentType::UINT32:
+			case asset::ComponentType::FLOAT32:
+				return 4;
+			default:
+				return 0;
+		}
+	}
+	
+	static const asset::VertexAttribute* findVertexAttribute(const asset::VertexGroup& vertexGroup,
+															 asset::PrimitiveType type) {
+		for (const auto& attribute : vertexGroup.vertexBuffer.attributes) {
+			if (attribute.type == type) {
+				return &attribute;
+			}
+		}
+		
+		return nullptr;
+	}
+	
+	static uint32_t readIndex(const asset::VertexGroup& vertexGroup, size_t index) {
+		const uint8_t* data = vertexGroup.getIndexData().data();
+		
+		switch (vertexGroup.indexBuffer.type) {
+			case asset::IndexType::UINT8:
+				return data[index];
+			case asset::IndexType::UINT16:
+				return reinterpret_cast<const uint16_t*>(data)[index];
+			case asset::IndexType::UINT32:
+				return reinterpret_cast<const uint32_t*>(data)[index];
+			default:
+				return 0;
+		}
+	}
+	
+	void Scene::loadBatches(const asset::Scene& scene,
+							const std::vector<asset::PrimitiveType>& types) {
+		struct PackedPart {
+			const asset::VertexGroup* vertexGroup;
+			size_t materialIndex;
+			glm::mat4 transform;
+		};
+		
+		struct PackedBounds {
+			glm::vec3 min;
+			uint32_t batchIndex;
+			glm::vec3 max;
+			uint32_t batchOffset;
+		};
+		
+		std::vector<PackedPart> parts;
+		std::vector<const asset::VertexAttribute*> layout (types.size(), nullptr);
+		
+		for (const auto& mesh : scene.meshes) {
+			const glm::mat4 transform = glm::transpose(glm::make_mat4(mesh.modelMatrix.data()));
+			
+			for (const auto& vertexGroupIndex : mesh.vertexGroups) {
+				if ((vertexGroupIndex < 0) ||
+					(static_cast<size_t>(vertexGroupIndex) >= scene.vertexGroups.size())) {
+					continue;
+				}
+				
+				const asset::VertexGroup& vertexGroup = scene.vertexGroups[vertexGroupIndex];
+				
+				if ((vertexGroup.materialIndex < 0) || (!getMaterial(vertexGroup.materialIndex)) ||
+					(vertexGroup.numVertices == 0)) {
+					continue;
+				}
+				
+				std::vector<const asset::VertexAttribute*> attributes (types.size(), nullptr);
+				bool compatible = true;
+				
+				// all packed mesh parts need to share the same vertex layout
+				for (size_t i = 0; i < types.size(); i++) {
+					attributes[i] = findVertexAttribute(vertexGroup, types[i]);
+					
+					if ((!attributes[i]) || (getComponentSize(attributes[i]->componentType) == 0)) {
+						compatible = false;
+					} else if ((layout[i]) &&
+							   ((layout[i]->componentType != attributes[i]->componentType) ||
+							    (layout[i]->componentCount != attributes[i]->componentCount))) {
+						compatible = false;
+					}
+				}
+				
+				if (!compatible) {
+					vkcv_log(LogLevel::WARNING, "Mesh part with incompatible vertex layout skipped");
+					continue;
+				}
+				
+				// only accepted mesh parts define the layout for the following ones
+				for (size_t i = 0; i < types.size(); i++) {
+					if (!layout[i]) {
+						layout[i] = attributes[i];
+					}
+				}
+				
+				parts.push_back({ &vertexGroup, static_cast<size_t>(vertexGroup.materialIndex), transform });
+			}
+		}
+		
+		if (parts.empty()) {
+			return;
+		}
+		
+		std::stable_sort(parts.begin(), parts.end(), [](const PackedPart& first,
+														const PackedPart& second) {
+			return first.materialIndex < second.materialIndex;
+		});
+		
+		size_t vertexCount = 0;
+		size_t indexCount = 0;
+		
+		for (const auto& part : parts) {
+			vertexCount += part.vertexGroup->numVertices;
+			indexCount += part.vertexGroup->getIndexData().empty()?
+					part.vertexGroup->numVertices : part.vertexGroup->numIndices;
+		}
+		
+		// each vertex attribute gets its own tightly packed stream in the vertex buffer
+		std::vector<size_t> elementSizes (types.size());
+		std::vector<size_t> streamOffsets (types.size());
+		size_t vertexBufferSize = 0;
+		
+		for (size_t i = 0; i < types.size(); i++) {
+			elementSizes[i] = layout[i]->componentCount * getComponentSize(layout[i]->componentType);
+			streamOffsets[i] = vertexBufferSize;
+			vertexBufferSize += (vertexCount * elementSizes[i] + 15) & ~static_cast<size_t>(15);
+		}
+		
+		std::vector<uint8_t> vertices (vertexBufferSize);
+		std::vector<uint32_t> indices;
+		std::vector<vk::DrawIndexedIndirectCommand> drawCommands;
+		std::vector<glm::mat4> transforms;
+		std::vector<PackedBounds> bounds;
+		std::vector<uint32_t> drawCounts;
+		
+		indices.reserve(indexCount);
+		drawCommands.reserve(parts.size());
+		transforms.reserve(parts.size());
+		bounds.reserve(parts.size());
+		
+		m_batches.clear();
+		
+		size_t vertexOffset = 0;
+		
+		for (const auto& part : parts) {
+			const asset::VertexGroup& vertexGroup = *(part.vertexGroup);
+			
+			for (size_t i = 0; i < types.size(); i++) {
+				const asset::VertexAttribute* attribute = findVertexAttribute(vertexGroup, types[i]);
+				const size_t stride = attribute->stride > 0? attribute->stride : elementSizes[i];
+				
+				uint8_t* dst = vertices.data() + streamOffsets[i] + vertexOffset * elementSizes[i];
+				const uint8_t* src = vertexGroup.getVertexData().data() + attribute->offset;
+				
+				for (size_t j = 0; j < vertexGroup.numVertices; j++) {
+					memcpy(dst + j * elementSizes[i], src + j * stride, elementSizes[i]);
+				}
+			}
+			
+			const size_t firstIndex = indices.size();
+			
+			if (vertexGroup.getIndexData().empty()) {
+				for (size_t j = 0; j < vertexGroup.numVertices; j++) {
+					indices.push_back(static_cast<uint32_t>(j));
+				}
+			} else {
+				for (size_t j = 0; j < vertexGroup.numIndices; j++) {
+					indices.push_back(readIndex(vertexGroup, j));
+				}
+			}
+			
+			// the first instance identifies the draw to read its transformation in shaders
+			drawCommands.emplace_back(
+					static_cast<uint32_t>(indices.size() - firstIndex),
+					1,
+					static_cast<uint32_t>(firstIndex),
+					static_cast<int32_t>(vertexOffset),
+					static_cast<uint32_t>(drawCommands.size())
+			);
+			
+			transforms.push_back(part.transform);
+			vertexOffset += vertexGroup.numVertices;
+			
+			if ((m_batches.empty()) || (m_batches.back().m_materialIndex != part.materialIndex)) {
+				m_batches.push_back({
+					part.materialIndex,
+					static_cast<uint32_t>(drawCommands.size() - 1),
+					0
+				});
+			}
+			
+			m_batches.back().m_drawCount++;
+			
+			const Bounds partBounds = transformBounds(part.transform, Bounds(
+					glm::vec3(vertexGroup.min.x, vertexGroup.min.y, vertexGroup.min.z),
+					glm::vec3(vertexGroup.max.x, vertexGroup.max.y, vertexGroup.max.z)
+			));
+			
+			bounds.push_back({
+				partBounds.getMin(),
+				static_cast<uint32_t>(m_batches.size() - 1),
+				partBounds.getMax(),
+				m_batches.back().m_firstDraw
+			});
+		}
+		
+		auto vertexBuffer = buffer<uint8_t>(*m_core, BufferType::VERTEX, vertices.size());
+		vertexBuffer.fill(vertices);
+		
+		auto indexBuffer = buffer<uint32_t>(*m_core, BufferType::INDEX, indices.size());
+		indexBuffer.fill(indices);
+		
+		VertexBufferBindings bindings;
+		for (size_t i = 0; i < types.size(); i++) {
+			bindings.push_back(vertexBufferBinding(
+					vertexBuffer.getHandle(),
+					elementSizes[i],
+					streamOffsets[i]
+			));
+		}
+		
+		m_packedData = VertexData(bindings);
+		m_packedData.setIndexBuffer(indexBuffer.getHandle(), IndexBitCount::Bit32);
+		m_packedData.setCount(indices.size());
+		
+		auto drawBuffer = buffer<vk::DrawIndexedIndirectCommand>(
+				*m_core, BufferType::INDIRECT, drawCommands.size()
+		);
+		
+		drawBuffer.fill(drawCommands);
+		m_drawBuffer = drawBuffer.getHandle();
+		
+		auto transformBuffer = buffer<glm::mat4>(*m_core, BufferType::STORAGE, transforms.size());
+		transformBuffer.fill(transforms);
+		m_transformBuffer = transformBuffer.getHandle();
+		
+		auto boundsBuffer = buffer<PackedBounds>(*m_core, BufferType::STORAGE, bounds.size());
+		boundsBuffer.fill(bounds);
+		m_boundsBuffer = boundsBuffer.getHandle();
+		
+		const vkcv::FeatureManager& featureManager = m_core->getContext().getFeatureManager();
+		
+		const bool drawIndirectCount = featureManager.checkFeatures<vk::PhysicalDeviceVulkan12Features>(
+				vk::StructureType::ePhysicalDeviceVulkan12Features,
+				[](const vk::PhysicalDeviceVulkan12Features& features) {
+					return features.drawIndirectCount;
+				}
+		);
+		
+		if (drawIndirectCount) {
+			drawCounts.reserve(m_batches.size());
+			
+			for (const auto& batch : m_batches) {
+				drawCounts.push_back(batch.m_drawCount);
+			}
+			
+			auto drawCountBuffer = buffer<uint32_t>(*m_core, BufferType::INDIRECT, drawCounts.size());
+			drawCountBuffer.fill(drawCounts);
+			m_drawCountBuffer = drawCountBuffer.getHandle();
+		} else {
+			m_drawCountBuffer = BufferHandle();
+		}
+	}
+	
 	Scene Scene::load(Core& core,
 					  const std::filesystem::path &path,
-					  const std::vector<asset::PrimitiveType>& types) {
+					  const std::vector<asset::PrimitiveType>& types,
+					  bool packed,
+					  bool streamed) {
 		asset::Scene asset_scene;
 		
-		if (!asset::loadScene(path.string(), asset_scene)) {
+		// buffers are mapped since the asset scene is only needed during loading
+		// and streamed textures get decoded later instead of being loaded here
+		const int result = streamed?
+				asset::probeScene(path.string(), asset_scene, true) :
+				asset::loadScene(path.string(), asset_scene, true, getTranscodeFormats(core));
+		
+		if (!result) {
 			vkcv_log(LogLevel::ERROR, "Scene could not be loaded (%s)",
 							 path.string().c_str());
 			return create(core);
@@ -371,6 +1258,10 @@ namespace vkcv::scene {
 		
 		Scene scene = create(core);
 		
+		if (streamed) {
+			scene.m_textureStreaming = std::make_shared<TextureStreaming>(core, asset_scene);
+		}
+		
 		for (const auto& material : asset_scene.materials) {
 			scene.m_materials.push_back({
 				0, material::Material()
@@ -383,20 +1274,19 @@ namespace vkcv::scene {
 			scene.getNode(root).loadMesh(asset_scene, mesh, types);
 		}
 		
-		vkcv::SamplerHandle sampler = samplerLinear(core);
-		
-		const vkcv::FeatureManager& featureManager = core.getContext().getFeatureManager();
-		
-		vkcv::algorithm::SinglePassDownsampler spdDownsampler (core, sampler);
-		auto mipStream = core.createCommandStream(vkcv::QueueType::Graphics);
-		
+		// the mip chains get generated in the same batch as the texture uploads
 		for (auto& material : scene.m_materials) {
-			material.m_data.recordMipChainGeneration(mipStream, spdDownsampler);
+			material.m_data.recordMipChainGenerationToUploads(core);
 		}
 		
-		core.submitCommandStream(mipStream, false);
+		core.flushUploads();
+		
+		if (packed) {
+			scene.loadBatches(asset_scene, types);
+		}
 		
 		scene.getNode(root).splitMeshesToSubNodes(128);
+		scene.buildHierarchy();
 		return scene;
 	}
 	
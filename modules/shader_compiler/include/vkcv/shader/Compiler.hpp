@@ -21,6 +21,12 @@ namespace vkcv::shader {
      */
 	typedef typename event_function<ShaderStage, const std::filesystem::path&>::type ShaderCompiledFunction;
 	
+	/**
+     * An event function type to be called on compilation completion with the
+     * compiled SPIR-V binary in memory.
+     */
+	typedef typename event_function<ShaderStage, const Vector<uint32_t>&>::type ShaderBinaryCompiledFunction;
+	
 	/**
      * An event function type to be called on program compilation completion.
      */
@@ -37,30 +43,114 @@ namespace vkcv::shader {
          */
 		Dictionary<std::string, std::string> m_defines;
 		
+		/**
+		 * The directory to cache compiled shaders in.
+		 */
+		std::filesystem::path m_cacheDirectory;
+		
+		/**
+		 * Return a content-addressed key for caching the compilation of a
+		 * shader from its preprocessed source, the macros for shader
+		 * compilation and an identifier of the compiler.
+		 *
+		 * @param[in] shaderStage Shader pipeline stage
+		 * @param[in] preprocessedSource Preprocessed source of shader
+		 * @param[in] identifier Identifier of compiler, target and version
+		 * @return Cache key
+		 */
+		[[nodiscard]]
+		std::string getCacheKey(ShaderStage shaderStage,
+								const std::string& preprocessedSource,
+								const std::string& identifier) const;
+		
+		/**
+		 * Load a cached SPIR-V binary by its cache key.
+		 *
+		 * @param[in] cacheKey Cache key
+		 * @param[out] binary SPIR-V binary
+		 * @return True on a cache hit, false otherwise
+		 */
+		bool loadCachedBinary(const std::string& cacheKey,
+							  Vector<uint32_t>& binary) const;
+		
+		/**
+		 * Store a compiled SPIR-V binary in the cache with its cache key.
+		 *
+		 * @param[in] cacheKey Cache key
+		 * @param[in] binary SPIR-V binary
+		 */
+		void storeCachedBinary(const std::string& cacheKey,
+							   const Vector<uint32_t>& binary) const;
+		
+		/**
+		 * Compile a shader from source for a target stage into a SPIR-V binary in
+		 * memory with some virtual headers, a custom shader include path and an
+		 * event function called if the compilation completes.
+		 *
+		 * Includes get resolved from the virtual headers first, falling back to
+		 * the include path on disk.
+		 *
+		 * @param[in] shaderStage Shader pipeline stage
+		 * @param[in] shaderSource Source of shader
+		 * @param[in] shaderHeaders Virtual headers of shader
+		 * @param[in] compiled Shader binary compilation event
+		 * @param[in] includePath Include path for shaders
+		 * @return Result if the compilation succeeds
+		 */
+		virtual bool compileSourceToBinary(ShaderStage shaderStage,
+										   const std::string& shaderSource,
+										   const Dictionary<std::filesystem::path, std::string>& shaderHeaders,
+										   const ShaderBinaryCompiledFunction& compiled,
+										   const std::filesystem::path& includePath) = 0;
+		
 	public:
+		/**
+		 * The constructor of a runtime shader compiler instance.
+		 */
+		Compiler();
+		
         /**
          * Compile a shader from source for a target stage with a custom shader
          * include path and an event function called if the compilation completes.
          *
+         * The compiled SPIR-V binary gets stored temporarily as file for the
+         * event function.
+         *
          * @param[in] shaderStage Shader pipeline stage
          * @param[in] shaderSource Source of shader
          * @param[in] compiled Shader compilation event
          * @param[in] includePath Include path for shaders
          * @return Result if the compilation succeeds
          */
-		virtual bool compileSource(ShaderStage shaderStage,
-								   const std::string& shaderSource,
-								   const ShaderCompiledFunction& compiled,
-								   const std::filesystem::path& includePath) = 0;
+		bool compileSource(ShaderStage shaderStage,
+						   const std::string& shaderSource,
+						   const ShaderCompiledFunction& compiled,
+						   const std::filesystem::path& includePath = "");
+		
+		/**
+         * Compile a shader from source for a target stage with a custom shader
+         * include path and an event function called with the SPIR-V binary in
+         * memory if the compilation completes.
+         *
+         * @param[in] shaderStage Shader pipeline stage
+         * @param[in] shaderSource Source of shader
+         * @param[in] compiled Shader binary compilation event
+         * @param[in] includePath Include path for shaders
+         * @return Result if the compilation succeeds
+         */
+		bool compileSource(ShaderStage shaderStage,
+						   const std::string& shaderSource,
+						   const ShaderBinaryCompiledFunction& compiled,
+						   const std::filesystem::path& includePath = "");
 		
 		/**
 		 * Compile a shader from source for a target stage with some included headers
 		 * as source as well and an event function called if the compilation completes.
 		 *
-		 * The included shaders will be stored temporarily for shader compilation in
-		 * a directory which gets used as include path. So these files can be used via
-		 * include instructions in the shader source code as if they were stored in the
-		 * same directory.
+		 * The included headers get resolved from memory, so they can be used via
+		 * include instructions in the shader source code as if they were stored in
+		 * the same directory. The compiled SPIR-V binary gets stored temporarily as
+		 * file for the event function.
 		 *
 		 * @param[in] shaderStage Shader pipeline stage
 		 * @param[in] shaderSource Source of shader
@@ -72,6 +162,22 @@ namespace vkcv::shader {
 									  const std::string& shaderSource,
 									  const Dictionary<std::filesystem::path, std::string>& shaderHeaders,
 									  const ShaderCompiledFunction& compiled);
+		
+		/**
+		 * Compile a shader from source for a target stage with some included headers
+		 * as source as well and an event function called with the SPIR-V binary in
+		 * memory if the compilation completes.
+		 *
+		 * @param[in] shaderStage Shader pipeline stage
+		 * @param[in] shaderSource Source of shader
+		 * @param[in] shaderHeaders Headers of shader
+		 * @param[in] compiled Shader binary compilation event
+		 * @return Result if the compilation succeeds
+		 */
+		bool compileSourceWithHeaders(ShaderStage shaderStage,
+									  const std::string& shaderSource,
+									  const Dictionary<std::filesystem::path, std::string>& shaderHeaders,
+									  const ShaderBinaryCompiledFunction& compiled);
 
         /**
          * Compile a shader from a specific file path for a target stage with
@@ -90,6 +196,23 @@ namespace vkcv::shader {
 							 const std::filesystem::path& includePath = "",
 							 bool update = false);
 		
+		/**
+         * Compile a shader from a specific file path for a target stage with
+         * a custom shader include path and an event function called with the
+         * SPIR-V binary in memory if the compilation completes.
+         *
+         * @param[in] shaderStage Shader pipeline stage
+         * @param[in] shaderPath Filepath of shader
+         * @param[in] compiled Shader binary compilation event
+         * @param[in] includePath Include path for shaders
+         * @param[in] update Flag to update shaders during runtime
+         */
+		void compile(ShaderStage shaderStage,
+					 const std::filesystem::path& shaderPath,
+					 const ShaderBinaryCompiledFunction& compiled,
+					 const std::filesystem::path& includePath = "",
+					 bool update = false);
+		
 		/**
          * Compile a shader program from a specific map of given file paths for
          * target pipeline stages with a custom shader include path and an event
@@ -124,6 +247,22 @@ namespace vkcv::shader {
          */
 		void setDefine(const std::string& name, const std::string& value);
 		
+		/**
+		 * Return the directory used to cache compiled shaders.
+		 *
+		 * @return Cache directory
+		 */
+		[[nodiscard]]
+		const std::filesystem::path& getCacheDirectory() const;
+		
+		/**
+		 * Set the directory used to cache compiled shaders. An empty
+		 * path disables the cache.
+		 *
+		 * @param[in] directory Cache directory
+		 */
+		void setCacheDirectory(const std::filesystem::path& directory);
+		
 	};
 
     /** @} */
@@ -14,6 +14,15 @@ namespace vkcv::shader {
 	 * An abstract class to handle Glslang runtime shader compilation.
 	 */
 	class GlslangCompiler : public Compiler {
+	protected:
+		/**
+		 * Return the version of Glslang to identify compiled shaders by.
+		 *
+		 * @return Version of Glslang as string
+		 */
+		[[nodiscard]]
+		static std::string getGlslangVersion();
+		
 	public:
 		/**
 		 * The constructor of a runtime Glslang shader compiler instance.
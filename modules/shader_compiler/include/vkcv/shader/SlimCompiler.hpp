@@ -31,20 +31,24 @@ namespace vkcv::shader {
 		 */
 		explicit SlimCompiler(SlimCompileTarget target = SlimCompileTarget::UNKNOWN);
 		
+	protected:
 		/**
-		 * Compile a Slim shader from source for a target stage with a custom shader
-		 * include path and an event function called if the compilation completes.
+		 * Compile a Slim shader from source for a target stage into a SPIR-V binary
+		 * in memory with some virtual headers, a custom shader include path and an
+		 * event function called if the compilation completes.
 		 *
 		 * @param[in] shaderStage Shader pipeline stage
 		 * @param[in] shaderSource Source of shader
-		 * @param[in] compiled Shader compilation event
+		 * @param[in] shaderHeaders Virtual headers of shader
+		 * @param[in] compiled Shader binary compilation event
 		 * @param[in] includePath Include path for shaders
 		 * @return Result if the compilation succeeds
 		 */
-		bool compileSource(ShaderStage shaderStage,
-						   const std::string& shaderSource,
-						   const ShaderCompiledFunction& compiled,
-						   const std::filesystem::path& includePath = "") override;
+		bool compileSourceToBinary(ShaderStage shaderStage,
+								   const std::string& shaderSource,
+								   const Dictionary<std::filesystem::path, std::string>& shaderHeaders,
+								   const ShaderBinaryCompiledFunction& compiled,
+								   const std::filesystem::path& includePath) override;
 		
 	};
 	
@@ -1,53 +1,212 @@
 
 #include "vkcv/shader/Compiler.hpp"
 
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
 #include <vkcv/Container.hpp>
 #include <vkcv/File.hpp>
 #include <vkcv/Logger.hpp>
 
 namespace vkcv::shader {
 	
-	bool Compiler::compileSourceWithHeaders(ShaderStage shaderStage,
-											const std::string &shaderSource,
-											const Dictionary<std::filesystem::path, std::string> &shaderHeaders,
-											const ShaderCompiledFunction &compiled) {
-		const std::filesystem::path directory = generateTemporaryDirectoryPath();
+	/**
+	 * Return the default directory to cache compiled shaders in.
+	 *
+	 * @return Default cache directory or an empty path if unavailable
+	 */
+	static std::filesystem::path getDefaultCacheDirectory() {
+		std::error_code error;
+		const std::filesystem::path directory = std::filesystem::temp_directory_path(error);
+		
+		if (error) {
+			return {};
+		}
+		
+		return directory / "vkcv_shader_cache";
+	}
+	
+	Compiler::Compiler()
+	: m_defines(), m_cacheDirectory(getDefaultCacheDirectory()) {}
+	
+	/**
+	 * Hash data with the 64-bit FNV-1a function and a given offset basis.
+	 *
+	 * @param[in] data Data as string
+	 * @param[in] basis Offset basis
+	 * @return Hash value
+	 */
+	static uint64_t hashFNV1a(const std::string& data, uint64_t basis) {
+		uint64_t hash = basis;
+		
+		for (const char c : data) {
+			hash ^= static_cast<uint8_t>(c);
+			hash *= 0x100000001b3ULL;
+		}
+		
+		return hash;
+	}
+	
+	std::string Compiler::getCacheKey(ShaderStage shaderStage,
+									  const std::string& preprocessedSource,
+									  const std::string& identifier) const {
+		std::vector<std::pair<std::string, std::string>> defines (
+				m_defines.begin(), m_defines.end()
+		);
+		
+		// macros need a stable order independent of the dictionary
+		std::sort(defines.begin(), defines.end());
+		
+		std::ostringstream stream;
+		stream << identifier << '\n' << static_cast<uint32_t>(shaderStage) << '\n';
 		
-		if (!std::filesystem::create_directory(directory)) {
-			vkcv_log(LogLevel::ERROR, "The directory could not be created (%s)",
-							 directory.string().c_str());
+		for (const auto& define : defines) {
+			stream << define.first << '=' << define.second << '\n';
+		}
+		
+		stream << preprocessedSource;
+		
+		const std::string data = stream.str();
+		
+		std::ostringstream key;
+		key << std::hex << std::setfill('0')
+			<< std::setw(16) << hashFNV1a(data, 0xcbf29ce484222325ULL)
+			<< std::setw(16) << hashFNV1a(data, 0x84222325cbf29ce4ULL)
+			<< '-' << std::dec << data.length();
+		
+		return key.str();
+	}
+	
+	bool Compiler::loadCachedBinary(const std::string &cacheKey,
+									Vector<uint32_t> &binary) const {
+		if (m_cacheDirectory.empty()) {
 			return false;
 		}
 		
-		for (const auto& header : shaderHeaders) {
-			if (header.first.has_parent_path()) {
-				std::filesystem::create_directories(directory / header.first.parent_path());
+		const std::filesystem::path path = m_cacheDirectory / (cacheKey + ".spv");
+		
+		if (!std::filesystem::exists(path)) {
+			return false;
+		}
+		
+		// discard anything which is not a SPIR-V module by its magic number
+		return ((readBinaryFromFile(path, binary)) &&
+				(!binary.empty()) &&
+				(binary[0] == 0x07230203));
+	}
+	
+	void Compiler::storeCachedBinary(const std::string &cacheKey,
+									 const Vector<uint32_t> &binary) const {
+		if ((m_cacheDirectory.empty()) || (binary.empty())) {
+			return;
+		}
+		
+		std::error_code error;
+		std::filesystem::create_directories(m_cacheDirectory, error);
+		
+		if (error) {
+			return;
+		}
+		
+		const std::filesystem::path path = m_cacheDirectory / (cacheKey + ".spv");
+		
+		std::ostringstream tmp_name;
+		tmp_name << cacheKey << '.' << std::this_thread::get_id() << ".tmp";
+		
+		// write to a temporary file first since other compilers may read concurrently
+		const std::filesystem::path tmp_path = m_cacheDirectory / tmp_name.str();
+		
+		if (!writeBinaryToFile(tmp_path, binary)) {
+			return;
+		}
+		
+		std::filesystem::rename(tmp_path, path, error);
+		
+		if (error) {
+			std::filesystem::remove(tmp_path, error);
+		}
+	}
+	
+	/**
+	 * Wraps a shader compilation event to be called with the compiled SPIR-V
+	 * binary stored in a temporary file.
+	 *
+	 * @param[in] compiled Shader compilation event
+	 * @return Shader binary compilation event
+	 */
+	static ShaderBinaryCompiledFunction writeToTemporaryFile(const ShaderCompiledFunction &compiled) {
+		return [&compiled](ShaderStage shaderStage, const Vector<uint32_t>& binary) {
+			if (!compiled) {
+				return;
 			}
 			
-			if (!writeTextToFile(directory / header.first, header.second)) {
-				return false;
+			const std::filesystem::path tmp_path = generateTemporaryFilePath();
+			
+			if (!writeBinaryToFile(tmp_path, binary)) {
+				vkcv_log(LogLevel::ERROR, "Spir-V could not be written to disk");
+				return;
 			}
-		}
-		
-		return compileSource(
+			
+			compiled(shaderStage, tmp_path);
+			std::filesystem::remove(tmp_path);
+		};
+	}
+	
+	bool Compiler::compileSource(ShaderStage shaderStage,
+								 const std::string &shaderSource,
+								 const ShaderCompiledFunction &compiled,
+								 const std::filesystem::path &includePath) {
+		return compileSourceToBinary(
 				shaderStage,
 				shaderSource,
-				[&directory, &compiled] (vkcv::ShaderStage shaderStage,
-										 const std::filesystem::path& path) {
-					if (compiled) {
-						compiled(shaderStage, path);
-					}
-					
-					std::filesystem::remove_all(directory);
-				}, directory
+				{},
+				writeToTemporaryFile(compiled),
+				includePath
 		);
 	}
+	
+	bool Compiler::compileSource(ShaderStage shaderStage,
+								 const std::string &shaderSource,
+								 const ShaderBinaryCompiledFunction &compiled,
+								 const std::filesystem::path &includePath) {
+		return compileSourceToBinary(shaderStage, shaderSource, {}, compiled, includePath);
+	}
+	
+	bool Compiler::compileSourceWithHeaders(ShaderStage shaderStage,
+											const std::string &shaderSource,
+											const Dictionary<std::filesystem::path, std::string> &shaderHeaders,
+											const ShaderCompiledFunction &compiled) {
+		return compileSourceToBinary(
+				shaderStage,
+				shaderSource,
+				shaderHeaders,
+				writeToTemporaryFile(compiled),
+				""
+		);
+	}
+	
+	bool Compiler::compileSourceWithHeaders(ShaderStage shaderStage,
+											const std::string &shaderSource,
+											const Dictionary<std::filesystem::path, std::string> &shaderHeaders,
+											const ShaderBinaryCompiledFunction &compiled) {
+		return compileSourceToBinary(shaderStage, shaderSource, shaderHeaders, compiled, "");
+	}
 
 	void Compiler::compile(ShaderStage shaderStage,
 												 const std::filesystem::path &shaderPath,
 												 const ShaderCompiledFunction &compiled,
 												 const std::filesystem::path &includePath,
 												 bool update) {
+		compile(shaderStage, shaderPath, writeToTemporaryFile(compiled), includePath, update);
+	}
+	
+	void Compiler::compile(ShaderStage shaderStage,
+						   const std::filesystem::path &shaderPath,
+						   const ShaderBinaryCompiledFunction &compiled,
+						   const std::filesystem::path &includePath,
+						   bool update) {
 		std::string shaderCode;
 		bool result = readTextFromFile(shaderPath, shaderCode);
 		
@@ -92,9 +251,9 @@ namespace vkcv::shader {
 			compile(
 				stage.first,
 				stage.second,
-				[&program](ShaderStage shaderStage, const std::filesystem::path& path) {
+				[&program](ShaderStage shaderStage, const Vector<uint32_t>& binary) {
 					#pragma omp critical
-					program.addShader(shaderStage, path);
+					program.addShader(shaderStage, binary);
 				},
 				includePath,
 				update
@@ -114,4 +273,12 @@ namespace vkcv::shader {
 		m_defines[name] = value;
 	}
 	
+	const std::filesystem::path &Compiler::getCacheDirectory() const {
+		return m_cacheDirectory;
+	}
+	
+	void Compiler::setCacheDirectory(const std::filesystem::path &directory) {
+		m_cacheDirectory = directory;
+	}
+	
 }
@@ -1,9 +1,9 @@
 
 #include "vkcv/shader/GLSLCompiler.hpp"
+#include "GlslangIncluder.hpp"
 
 #include <sstream>
 #include <glslang/SPIRV/GlslangToSpv.h>
-#include <glslang/StandAlone/DirStackFileIncluder.h>
 
 #include <vkcv/File.hpp>
 #include <vkcv/Logger.hpp>
@@ -160,10 +160,11 @@ namespace vkcv::shader {
 		resources.limits.generalConstantMatrixVectorIndexing = true;
 	}
 	
-	bool GLSLCompiler::compileSource(ShaderStage shaderStage,
-									 const std::string& shaderSource,
-									 const ShaderCompiledFunction &compiled,
-									 const std::filesystem::path& includePath) {
+	bool GLSLCompiler::compileSourceToBinary(ShaderStage shaderStage,
+											 const std::string& shaderSource,
+											 const Dictionary<std::filesystem::path, std::string>& shaderHeaders,
+											 const ShaderBinaryCompiledFunction &compiled,
+											 const std::filesystem::path& includePath) {
 		const EShLanguage language = findShaderLanguage(shaderStage);
 		
 		if (language == EShLangCount) {
@@ -229,7 +230,7 @@ namespace vkcv::shader {
 
 		std::string preprocessedGLSL;
 
-		DirStackFileIncluder includer;
+		GlslangIncluder includer (shaderHeaders);
 		includer.pushExternalLocalDirectory(includePath.string());
 
 		if (!shader.preprocess(&resources, 100, ENoProfile,
@@ -240,6 +241,22 @@ namespace vkcv::shader {
 			return false;
 		}
 		
+		const std::string cacheKey = getCacheKey(
+				shaderStage,
+				preprocessedGLSL,
+				"glsl-" + std::to_string(static_cast<int>(m_target)) + "-" + getGlslangVersion()
+		);
+		
+		std::vector<uint32_t> spirv;
+		
+		if (loadCachedBinary(cacheKey, spirv)) {
+			if (compiled) {
+				compiled(shaderStage, spirv);
+			}
+			
+			return true;
+		}
+		
 		const char* preprocessedCString = preprocessedGLSL.c_str();
 		shader.setStrings(&preprocessedCString, 1);
 
@@ -264,21 +281,13 @@ namespace vkcv::shader {
 			return false;
 		}
 		
-		std::vector<uint32_t> spirv;
 		glslang::GlslangToSpv(*intermediate, spirv);
-		
-		const std::filesystem::path tmp_path = generateTemporaryFilePath();
-		
-		if (!writeBinaryToFile(tmp_path, spirv)) {
-			vkcv_log(LogLevel::ERROR, "Spir-V could not be written to disk");
-			return false;
-		}
+		storeCachedBinary(cacheKey, spirv);
 		
 		if (compiled) {
-			compiled(shaderStage, tmp_path);
+			compiled(shaderStage, spirv);
 		}
 		
-		std::filesystem::remove(tmp_path);
 		return true;
 	}
 	
@@ -31,6 +31,14 @@ namespace vkcv::shader {
 		}
 	}
 	
+	std::string GlslangCompiler::getGlslangVersion() {
+		const glslang::Version version = glslang::GetVersion();
+		
+		return std::to_string(version.major) + "." +
+			   std::to_string(version.minor) + "." +
+			   std::to_string(version.patch) + version.flavor;
+	}
+	
 	GlslangCompiler &GlslangCompiler::operator=(const GlslangCompiler &other) {
 		s_CompilerCount++;
 		return *this;
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+#include <glslang/StandAlone/DirStackFileIncluder.h>
+
+#include <vkcv/Container.hpp>
+
+namespace vkcv::shader {
+
+	/**
+	 * A virtual include resolver for Glslang which looks up headers in memory
+	 * first and falls back to the include directories on disk.
+	 */
+	class GlslangIncluder : public DirStackFileIncluder {
+	private:
+		const Dictionary<std::filesystem::path, std::string>& m_headers;
+
+		IncludeResult* includeVirtual(const char* headerName, const char* includerName) {
+			if (m_headers.empty()) {
+				return nullptr;
+			}
+
+			const std::filesystem::path relativePath = (
+					std::filesystem::path(includerName).parent_path() / headerName
+			).lexically_normal();
+
+			auto it = m_headers.find(relativePath);
+
+			if (it == m_headers.end()) {
+				it = m_headers.find(std::filesystem::path(headerName).lexically_normal());
+			}
+
+			if (it == m_headers.end()) {
+				return nullptr;
+			}
+
+			return new IncludeResult(
+					it->first.string(),
+					it->second.c_str(),
+					it->second.length(),
+					nullptr
+			);
+		}
+
+	public:
+		/**
+		 * The constructor of a virtual include resolver using a given
+		 * dictionary of headers.
+		 *
+		 * @param[in] headers Headers of shader
+		 */
+		explicit GlslangIncluder(const Dictionary<std::filesystem::path, std::string>& headers)
+		: DirStackFileIncluder(), m_headers(headers) {}
+
+		IncludeResult* includeLocal(const char* headerName,
+									const char* includerName,
+									size_t inclusionDepth) override {
+			IncludeResult* result = includeVirtual(headerName, includerName);
+
+			if (result) {
+				return result;
+			}
+
+			return DirStackFileIncluder::includeLocal(headerName, includerName, inclusionDepth);
+		}
+
+		IncludeResult* includeSystem(const char* headerName,
+									 const char* includerName,
+									 size_t inclusionDepth) override {
+			IncludeResult* result = includeVirtual(headerName, includerName);
+
+			if (result) {
+				return result;
+			}
+
+			return DirStackFileIncluder::includeSystem(headerName, includerName, inclusionDepth);
+		}
+
+	};
+
+}
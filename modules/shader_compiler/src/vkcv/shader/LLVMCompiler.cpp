@@ -17,7 +17,7 @@ namespace vkcv::shader {
 	static bool shadyCompileModule(Module* module,
 																 ShaderStage shaderStage,
 																 const std::string& shaderSource,
-																 const ShaderCompiledFunction &compiled,
+																 const ShaderBinaryCompiledFunction &compiled,
 																 const std::filesystem::path &includePath) {
 		CompilerConfig compiler = shd_default_compiler_config();
 		ShadyErrorCodes codes = shd_driver_load_source_file(
@@ -73,18 +73,27 @@ namespace vkcv::shader {
 				return false;
 		}
 
+		// the Shady driver only emits SPIR-V to files, so it gets read back here
+		Vector<uint32_t> spirv;
+		const bool result = readBinaryFromFile(tmp_path, spirv);
+		std::filesystem::remove(tmp_path);
+
+		if (!result) {
+			vkcv_log(LogLevel::ERROR, "Spir-V could not be read from disk");
+			return false;
+		}
+
 		if (compiled) {
-			compiled(shaderStage, tmp_path);
+			compiled(shaderStage, spirv);
 		}
 
-		std::filesystem::remove(tmp_path);
 		return true;
 	}
 
 	static bool shadyCompileArena(IrArena* arena,
 																ShaderStage shaderStage,
 																const std::string& shaderSource,
-																const ShaderCompiledFunction &compiled,
+																const ShaderBinaryCompiledFunction &compiled,
 																const std::filesystem::path &includePath) {
 		Module* module = shd_new_module(arena, "slim_module");
 
@@ -96,10 +105,11 @@ namespace vkcv::shader {
 		return shadyCompileModule(module, shaderStage, shaderSource, compiled, includePath);
 	}
 
-	bool LLVMCompiler::compileSource(ShaderStage shaderStage,
-																	 const std::string& shaderSource,
-																	 const ShaderCompiledFunction& compiled,
-																	 const std::filesystem::path& includePath) {
+	bool LLVMCompiler::compileSourceToBinary(ShaderStage shaderStage,
+											   const std::string& shaderSource,
+											   const Dictionary<std::filesystem::path, std::string>& shaderHeaders,
+											   const ShaderBinaryCompiledFunction& compiled,
+											   const std::filesystem::path& includePath) {
 		if (ShaderStage::COMPUTE != shaderStage) {
 			vkcv_log(LogLevel::ERROR, "Shader stage not supported");
 			return false;
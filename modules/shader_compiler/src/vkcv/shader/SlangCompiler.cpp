@@ -74,10 +74,57 @@ namespace vkcv::shader {
 		}
 	}
 
-	bool SlangCompiler::compileSource(ShaderStage shaderStage,
-																		const std::string& shaderSource,
-																		const ShaderCompiledFunction& compiled,
-																		const std::filesystem::path& includePath) {
+	/**
+	 * Writes virtual headers of a shader into a temporary directory since
+	 * Slang only resolves includes via its search paths.
+	 *
+	 * @param[in] shaderHeaders Virtual headers of shader
+	 * @return Path of the temporary directory or an empty path on failure
+	 */
+	static std::filesystem::path writeHeadersToDirectory(
+			const Dictionary<std::filesystem::path, std::string>& shaderHeaders) {
+		const std::filesystem::path directory = generateTemporaryDirectoryPath();
+		
+		if (!std::filesystem::create_directory(directory)) {
+			vkcv_log(LogLevel::ERROR, "The directory could not be created (%s)",
+							 directory.string().c_str());
+			return {};
+		}
+		
+		for (const auto& header : shaderHeaders) {
+			if (header.first.has_parent_path()) {
+				std::filesystem::create_directories(directory / header.first.parent_path());
+			}
+			
+			if (!writeTextToFile(directory / header.first, header.second)) {
+				std::filesystem::remove_all(directory);
+				return {};
+			}
+		}
+		
+		return directory;
+	}
+
+	bool SlangCompiler::compileSourceToBinary(ShaderStage shaderStage,
+											  const std::string& shaderSource,
+											  const Dictionary<std::filesystem::path, std::string>& shaderHeaders,
+											  const ShaderBinaryCompiledFunction& compiled,
+											  const std::filesystem::path& includePath) {
+		if (!shaderHeaders.empty()) {
+			const std::filesystem::path directory = writeHeadersToDirectory(shaderHeaders);
+			
+			if (directory.empty()) {
+				return false;
+			}
+			
+			const bool result = compileSourceToBinary(
+					shaderStage, shaderSource, {}, compiled, directory
+			);
+			
+			std::filesystem::remove_all(directory);
+			return result;
+		}
+		
 		slang::SessionDesc sessionDesc = {};
     slang::TargetDesc targetDesc = {};
 		SlangSourceLanguage lang;
@@ -109,7 +156,8 @@ namespace vkcv::shader {
 		sessionDesc.targets = &targetDesc;
 		sessionDesc.targetCount = 1;
 
-		const char *searchPath = includePath.string().c_str();
+		const std::string includePathString = includePath.string();
+		const char *searchPath = includePathString.c_str();
 		sessionDesc.searchPaths = &searchPath;
 		sessionDesc.searchPathCount = 1;
 
@@ -169,18 +217,10 @@ namespace vkcv::shader {
 		spirv.resize(size / sizeof(uint32_t));
 		memcpy(spirv.data(), code, spirv.size() * sizeof(uint32_t));
 
-		const std::filesystem::path tmp_path = generateTemporaryFilePath();
-
-		if (!writeBinaryToFile(tmp_path, spirv)) {
-			vkcv_log(LogLevel::ERROR, "Spir-V could not be written to disk");
-			return false;
-		}
-		
 		if (compiled) {
-			compiled(shaderStage, tmp_path);
+			compiled(shaderStage, spirv);
 		}
 		
-		std::filesystem::remove(tmp_path);
 		return true;
 	}
 	
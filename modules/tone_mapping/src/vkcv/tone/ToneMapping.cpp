@@ -66,8 +66,8 @@ namespace vkcv::tone {
 		compiler.compileSource(
 				ShaderStage::COMPUTE,
 				stream.str(),
-				[&](ShaderStage stage, const std::filesystem::path &path) {
-					program.addShader(stage, path);
+				[&](ShaderStage stage, const Vector<uint32_t>& binary) {
+					program.addShader(stage, binary);
 				}
 		);
 		
@@ -123,9 +123,9 @@ namespace vkcv::upscaling {
 		DescriptorSetLayoutHandle m_easuDescriptorSetLayout;
 
         /**
-         * The descriptor set for the EASU pipeline.
+         * The descriptor sets for the EASU pipeline per frame in flight.
          */
-		DescriptorSetHandle m_easuDescriptorSet;
+		Vector<DescriptorSetHandle> m_easuDescriptorSets;
 
         /**
          * The descriptor set layout of the RCAS pipeline.
@@ -133,21 +133,21 @@ namespace vkcv::upscaling {
 		DescriptorSetLayoutHandle m_rcasDescriptorSetLayout;
 
         /**
-         * The descriptor set for the RCAS pipeline.
+         * The descriptor sets for the RCAS pipeline per frame in flight.
          */
-		DescriptorSetHandle m_rcasDescriptorSet;
+		Vector<DescriptorSetHandle> m_rcasDescriptorSets;
 
         /**
-         * The buffer template to handle FSR constants for
-         * the EASU pipeline.
+         * The buffer templates to handle FSR constants for
+         * the EASU pipeline per frame in flight.
          */
-		Buffer<FSRConstants> m_easuConstants;
+		Vector<Buffer<FSRConstants>> m_easuConstants;
 
         /**
-         * The buffer template to handle FSR constants for
-         * the RCAS pipeline.
+         * The buffer templates to handle FSR constants for
+         * the RCAS pipeline per frame in flight.
          */
-		Buffer<FSRConstants> m_rcasConstants;
+		Vector<Buffer<FSRConstants>> m_rcasConstants;
 
         /**
          * The image handle to store the intermidiate state of
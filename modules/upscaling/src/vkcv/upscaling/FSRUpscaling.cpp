@@ -112,23 +112,13 @@ namespace vkcv::upscaling {
 	m_rcasPipeline(),
 
 	m_easuDescriptorSetLayout(m_core.createDescriptorSetLayout(getDescriptorBindings())),
-	m_easuDescriptorSet(m_core.createDescriptorSet(m_easuDescriptorSetLayout)),
+	m_easuDescriptorSets(),
 
 	m_rcasDescriptorSetLayout(m_core.createDescriptorSetLayout(getDescriptorBindings())),
-	m_rcasDescriptorSet(m_core.createDescriptorSet(m_rcasDescriptorSetLayout)),
+	m_rcasDescriptorSets(),
 
-	m_easuConstants(buffer<FSRConstants>(
-			m_core,
-			BufferType::UNIFORM,
-			1,
-			BufferMemoryType::HOST_VISIBLE
-	)),
-	m_rcasConstants(buffer<FSRConstants>(
-			m_core,
-			BufferType::UNIFORM,
-			1,
-			BufferMemoryType::HOST_VISIBLE
-	)),
+	m_easuConstants(),
+	m_rcasConstants(),
 	m_intermediateImage(),
 	m_sampler(m_core.createSampler(
 			SamplerFilterType::LINEAR,
@@ -177,24 +167,14 @@ namespace vkcv::upscaling {
 						{ "ffx_fsr1.h", FFX_FSR1_H_SHADER }
 					},
 					[&program](vkcv::ShaderStage shaderStage,
-							   const std::filesystem::path& path) {
-						program.addShader(shaderStage, path);
+							   const Vector<uint32_t>& binary) {
+						program.addShader(shaderStage, binary);
 					}
 			);
 
 			m_easuPipeline = m_core.createComputePipeline({ program, {
 				m_easuDescriptorSetLayout
 			}});
-
-			
-			DescriptorWrites writes;
-			writes.writeUniformBuffer(
-					0, m_easuConstants.getHandle(),true
-			);
-			
-			writes.writeSampler(3, m_sampler);
-			
-			m_core.writeDescriptorSet(m_easuDescriptorSet, writes);
 		}
 		
 		{
@@ -207,23 +187,56 @@ namespace vkcv::upscaling {
 							{ "ffx_fsr1.h", FFX_FSR1_H_SHADER }
 					},
 					[&program](vkcv::ShaderStage shaderStage,
-							   const std::filesystem::path& path) {
-						program.addShader(shaderStage, path);
+							   const Vector<uint32_t>& binary) {
+						program.addShader(shaderStage, binary);
 					}
 			);
 
 			m_rcasPipeline = m_core.createComputePipeline({ program, {
 				m_rcasDescriptorSetLayout
 			}});
-
-			DescriptorWrites writes;
-			writes.writeUniformBuffer(
-					0, m_rcasConstants.getHandle(),true
-			);
+		}
+		
+		// the constants and images get updated while previous frames are still in flight
+		for (uint32_t i = 0; i < m_core.getFramesInFlight(); i++) {
+			m_easuConstants.push_back(buffer<FSRConstants>(
+					m_core,
+					BufferType::UNIFORM,
+					1,
+					BufferMemoryType::HOST_VISIBLE
+			));
 			
-			writes.writeSampler(3, m_sampler);
+			m_rcasConstants.push_back(buffer<FSRConstants>(
+					m_core,
+					BufferType::UNIFORM,
+					1,
+					BufferMemoryType::HOST_VISIBLE
+			));
 			
-			m_core.writeDescriptorSet(m_rcasDescriptorSet, writes);
+			m_easuDescriptorSets.push_back(m_core.createDescriptorSet(m_easuDescriptorSetLayout));
+			m_rcasDescriptorSets.push_back(m_core.createDescriptorSet(m_rcasDescriptorSetLayout));
+			
+			{
+				DescriptorWrites writes;
+				writes.writeUniformBuffer(
+						0, m_easuConstants.back().getHandle(),true
+				);
+				
+				writes.writeSampler(3, m_sampler);
+				
+				m_core.writeDescriptorSet(m_easuDescriptorSets.back(), writes);
+			}
+			
+			{
+				DescriptorWrites writes;
+				writes.writeUniformBuffer(
+						0, m_rcasConstants.back().getHandle(),true
+				);
+				
+				writes.writeSampler(3, m_sampler);
+				
+				m_core.writeDescriptorSet(m_rcasDescriptorSets.back(), writes);
+			}
 		}
 	}
 	
@@ -234,6 +247,14 @@ namespace vkcv::upscaling {
 			1.0f, 0.0f, 0.0f, 1.0f
 		});
 		
+		const uint32_t frameIndex = m_core.getCurrentFrameInFlight();
+		
+		const DescriptorSetHandle &easuDescriptorSet = m_easuDescriptorSets[frameIndex];
+		const DescriptorSetHandle &rcasDescriptorSet = m_rcasDescriptorSets[frameIndex];
+		
+		auto &easuConstants = m_easuConstants[frameIndex];
+		auto &rcasConstants = m_rcasConstants[frameIndex];
+		
 		const uint32_t inputWidth = m_core.getImageWidth(input);
 		const uint32_t inputHeight = m_core.getImageHeight(input);
 		
@@ -251,6 +272,8 @@ namespace vkcv::upscaling {
 					imageConfig
 			);
 			
+			m_core.setDebugLabel(m_intermediateImage, "vkcv::upscaling::FSRUpscaling");
+			
 			m_core.prepareImageForStorage(cmdStream, m_intermediateImage);
 		}
 		
@@ -271,7 +294,7 @@ namespace vkcv::upscaling {
 			
 			consts.Sample[0] = (((m_hdr) && (!rcasEnabled)) ? 1 : 0);
 			
-			m_easuConstants.fill(&consts);
+			easuConstants.fill(&consts);
 		}
 		
 		static const uint32_t threadGroupWorkRegionDim = 16;
@@ -281,7 +304,7 @@ namespace vkcv::upscaling {
 				DispatchSize(threadGroupWorkRegionDim, threadGroupWorkRegionDim)
 		);
 		
-		m_core.recordBufferMemoryBarrier(cmdStream, m_easuConstants.getHandle());
+		m_core.recordBufferMemoryBarrier(cmdStream, easuConstants.getHandle());
 		
 		if (rcasEnabled) {
 			{
@@ -289,21 +312,21 @@ namespace vkcv::upscaling {
 				writes.writeSampledImage(1, input);
 				writes.writeStorageImage(2, m_intermediateImage);
 				
-				m_core.writeDescriptorSet(m_easuDescriptorSet, writes);
+				m_core.writeDescriptorSet(easuDescriptorSet, writes);
 			}
 			{
 				DescriptorWrites writes;
 				writes.writeSampledImage(1, m_intermediateImage);
 				writes.writeStorageImage(2, output);
 				
-				m_core.writeDescriptorSet(m_rcasDescriptorSet, writes);
+				m_core.writeDescriptorSet(rcasDescriptorSet, writes);
 			}
 			
 			m_core.recordComputeDispatchToCmdStream(
 					cmdStream,
 					m_easuPipeline,
 					dispatch,
-					{ useDescriptorSet(0, m_easuDescriptorSet, { 0 }) },
+					{ useDescriptorSet(0, easuDescriptorSet, { 0 }) },
 					PushConstants(0)
 			);
 			
@@ -313,17 +336,17 @@ namespace vkcv::upscaling {
 				FsrRcasCon(consts.Const0, (1.0f - m_sharpness) * 2.0f);
 				consts.Sample[0] = (m_hdr ? 1 : 0);
 				
-				m_rcasConstants.fill(&consts);
+				rcasConstants.fill(&consts);
 			}
 			
-			m_core.recordBufferMemoryBarrier(cmdStream, m_rcasConstants.getHandle());
+			m_core.recordBufferMemoryBarrier(cmdStream, rcasConstants.getHandle());
 			m_core.prepareImageForSampling(cmdStream, m_intermediateImage);
 			
 			m_core.recordComputeDispatchToCmdStream(
 					cmdStream,
 					m_rcasPipeline,
 					dispatch,
-					{ useDescriptorSet(0,m_rcasDescriptorSet, { 0 }) },
+					{ useDescriptorSet(0, rcasDescriptorSet, { 0 }) },
 					PushConstants(0)
 			);
 			
@@ -334,14 +357,14 @@ namespace vkcv::upscaling {
 				writes.writeSampledImage(1, input);
 				writes.writeStorageImage(2, output);
 				
-				m_core.writeDescriptorSet(m_easuDescriptorSet, writes);
+				m_core.writeDescriptorSet(easuDescriptorSet, writes);
 			}
 			
 			m_core.recordComputeDispatchToCmdStream(
 					cmdStream,
 					m_easuPipeline,
 					dispatch,
-					{ useDescriptorSet(0, m_easuDescriptorSet, { 0 }) },
+					{ useDescriptorSet(0, easuDescriptorSet, { 0 }) },
 					PushConstants(0)
 			);
 		}
@@ -143,8 +143,8 @@ namespace vkcv::upscaling {
 						{ "NIS_Scaler.h", NIS_SCALER_H_SHADER }
 					},
 					[&program](vkcv::ShaderStage shaderStage,
-							   const std::filesystem::path& path) {
-						program.addShader(shaderStage, path);
+							   const Vector<uint32_t>& binary) {
+						program.addShader(shaderStage, binary);
 					}
 			);
 			
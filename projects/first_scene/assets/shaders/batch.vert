@@ -0,0 +1,26 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inUV;
+
+layout(location = 0) out vec3 passNormal;
+layout(location = 1) out vec2 passUV;
+
+layout(set=1, binding=0) readonly buffer transformBuffer {
+    mat4 transforms [];
+};
+
+layout( push_constant ) uniform constants{
+    mat4 viewProjection;
+};
+
+void main()	{
+    // the first instance of each packed draw identifies its transformation
+    const mat4 model = transforms[gl_InstanceIndex];
+
+	gl_Position = viewProjection * model * vec4(inPosition, 1.0);
+	passNormal  = mat3(model) * inNormal;
+    passUV      = inUV;
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <thread>
 #include <vkcv/Core.hpp>
 #include <vkcv/Pass.hpp>
 #include <GLFW/glfw3.h>
@@ -7,6 +8,7 @@
 #include <vkcv/asset/asset_loader.hpp>
 #include <vkcv/shader/GLSLCompiler.hpp>
 #include <vkcv/scene/Scene.hpp>
+#include <vkcv/scene/CullingStage.hpp>
 #include <vkcv/Features.hpp>
 
 int main(int argc, const char** argv) {
@@ -25,6 +27,14 @@ int main(int argc, const char** argv) {
 			features
 	);
 	
+	// drawcalls of the scene without GPU culling get recorded in parallel
+	bool parallelRecording = true;
+	core.setRecordingThreadCount(std::thread::hardware_concurrency());
+	
+	// sorting the drawcalls by their resources skips redundant binds
+	bool drawcallSorting = true;
+	core.setDrawcallSorting(drawcallSorting);
+	
 	vkcv::WindowHandle windowHandle = core.createWindow(applicationName, windowWidth, windowHeight, true);
 	vkcv::Window& window = core.getWindow(windowHandle);
 	vkcv::camera::CameraManager cameraManager(window);
@@ -47,7 +57,9 @@ int main(int argc, const char** argv) {
 				vkcv::asset::PrimitiveType::POSITION,
 				vkcv::asset::PrimitiveType::NORMAL,
 				vkcv::asset::PrimitiveType::TEXCOORD_0
-			}
+			},
+			true,
+			true
 	);
 	
 	vkcv::PassHandle scenePass = vkcv::passSwapchain(
@@ -93,6 +105,43 @@ int main(int argc, const char** argv) {
 		return EXIT_FAILURE;
 	}
 	
+	vkcv::ShaderProgram batchShaderProgram;
+	
+	compiler.compileProgram(batchShaderProgram, {
+		{ vkcv::ShaderStage::VERTEX, "assets/shaders/batch.vert" },
+		{ vkcv::ShaderStage::FRAGMENT, "assets/shaders/shader.frag" }
+	}, nullptr);
+	
+	vkcv::DescriptorSetLayoutHandle transformSetLayout = core.createDescriptorSetLayout(
+			batchShaderProgram.getReflectedDescriptors().at(1)
+	);
+	
+	vkcv::DescriptorSetHandle transformSet = core.createDescriptorSet(transformSetLayout);
+	
+	{
+		vkcv::DescriptorWrites writes;
+		writes.writeStorageBuffer(0, scene.getTransformBuffer());
+		core.writeDescriptorSet(transformSet, writes);
+	}
+	
+	vkcv::GraphicsPipelineHandle batchPipeline = core.createGraphicsPipeline(
+			vkcv::GraphicsPipelineConfig(
+					batchShaderProgram,
+					scenePass,
+					{ sceneLayout },
+					{ material0.getDescriptorSetLayout(), transformSetLayout }
+			)
+	);
+	
+	if (!batchPipeline) {
+		std::cout << "Error. Could not create batch pipeline. Exiting." << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	vkcv::scene::CullingStage culling (core);
+	bool gpuCulling = true;
+	bool occlusionCulling = culling.isOcclusionCulling();
+	
 	vkcv::ImageHandle depthBuffer;
 
 	const vkcv::ImageHandle swapchainInput = vkcv::ImageHandle::createSwapchainImageHandle();
@@ -112,34 +161,82 @@ int main(int argc, const char** argv) {
 		}
 		
 		cameraManager.update(dt);
+		scene.updateTextures(cameraManager.getActiveCamera());
 
 		const std::vector<vkcv::ImageHandle> renderTargets = { swapchainInput, depthBuffer };
 		auto cmdStream = core.createCommandStream(vkcv::QueueType::Graphics);
 
-		auto recordMesh = [](const glm::mat4& MVP, const glm::mat4& M,
-							 vkcv::PushConstants &pushConstants,
-							 vkcv::Drawcall& drawcall) {
-			pushConstants.appendDrawcall(MVP);
-		};
-		
-		scene.recordDrawcalls(
-				cmdStream,
-				cameraManager.getActiveCamera(),
-				scenePass,
-				scenePipeline,
-				sizeof(glm::mat4),
-				recordMesh,
-				renderTargets,
-				windowHandle
-		);
+		if (gpuCulling) {
+			auto recordBatch = [&transformSet](const glm::mat4& VP,
+											   vkcv::PushConstants &pushConstants,
+											   vkcv::IndirectDrawcall& drawcall) {
+				pushConstants.appendDrawcall(VP);
+				drawcall.useDescriptorSet(1, transformSet);
+			};
+			
+			culling.setOcclusionCulling(occlusionCulling);
+			culling.recordCulling(cmdStream, scene, cameraManager.getActiveCamera());
+			
+			scene.recordBatchDrawcalls(
+					cmdStream,
+					cameraManager.getActiveCamera(),
+					batchPipeline,
+					sizeof(glm::mat4),
+					recordBatch,
+					renderTargets,
+					windowHandle,
+					culling
+			);
+			
+			// the depth of this frame occludes mesh parts in the next one
+			culling.recordDepthPyramid(cmdStream, depthBuffer);
+		} else {
+			auto recordMesh = [](const glm::mat4& MVP, const glm::mat4& M,
+								 vkcv::PushConstants &pushConstants,
+								 vkcv::Drawcall& drawcall) {
+				pushConstants.appendDrawcall(MVP);
+			};
+			
+			scene.recordDrawcalls(
+					cmdStream,
+					cameraManager.getActiveCamera(),
+					scenePass,
+					scenePipeline,
+					sizeof(glm::mat4),
+					recordMesh,
+					renderTargets,
+					windowHandle
+			);
+		}
 		
 		core.prepareSwapchainImageForPresent(cmdStream);
-		core.submitCommandStream(cmdStream);
+		core.submitCommandStreamAsync(cmdStream);
 
         gui.beginGUI();
 
         ImGui::Begin("Settings");
         ImGui::Text("Deltatime %fms, %f", dt * 1000, 1/dt);
+        ImGui::Checkbox("GPU culling", &gpuCulling);
+        ImGui::Checkbox("Occlusion culling", &occlusionCulling);
+
+        if (ImGui::Checkbox("Parallel recording", &parallelRecording)) {
+            core.setRecordingThreadCount(parallelRecording? std::thread::hardware_concurrency() : 1);
+        }
+
+        if (ImGui::Checkbox("Drawcall sorting", &drawcallSorting)) {
+            core.setDrawcallSorting(drawcallSorting);
+        }
+
+        const vkcv::DrawcallStatistics& statistics = core.getDrawcallStatistics();
+        ImGui::Text("Drawcalls %zu", statistics.drawcalls);
+        ImGui::Text("Descriptor set binds %zu (%zu skipped)",
+                    statistics.descriptorSetBinds, statistics.descriptorSetBindsSkipped);
+        ImGui::Text("Vertex buffer binds %zu (%zu skipped)",
+                    statistics.vertexBufferBinds, statistics.vertexBufferBindsSkipped);
+        ImGui::Text("Index buffer binds %zu (%zu skipped)",
+                    statistics.indexBufferBinds, statistics.indexBufferBindsSkipped);
+        core.resetDrawcallStatistics();
+
         ImGui::End();
 
         gui.endGUI();
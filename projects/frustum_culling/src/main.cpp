@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <vkcv/Logger.hpp>
+#include <vkcv/scene/Frustum.hpp>
+
+int main(int argc, const char** argv) {
+	const size_t boxCount = 100000;
+	const size_t iterations = 100;
+	
+	std::mt19937 generator (42);
+	std::uniform_real_distribution<float> position (-100.0f, +100.0f);
+	std::uniform_real_distribution<float> size (0.1f, 5.0f);
+	
+	std::vector<vkcv::scene::Bounds> boxes;
+	vkcv::scene::BoundsArray boundsArray;
+	
+	boxes.reserve(boxCount);
+	boundsArray.reserve(boxCount);
+	
+	for (size_t i = 0; i < boxCount; i++) {
+		const glm::vec3 center (position(generator), position(generator), position(generator));
+		const glm::vec3 extent (size(generator), size(generator), size(generator));
+		
+		const vkcv::scene::Bounds bounds (center - extent, center + extent);
+		
+		boxes.push_back(bounds);
+		boundsArray.add(bounds);
+	}
+	
+	const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 250.0f);
+	const glm::mat4 view = glm::lookAt(
+			glm::vec3(0.0f, 0.0f, -120.0f),
+			glm::vec3(0.0f, 0.0f, 0.0f),
+			glm::vec3(0.0f, 1.0f, 0.0f)
+	);
+	
+	const glm::mat4 viewProjection = projection * view;
+	
+	size_t visibleSingle = 0;
+	
+	auto start = std::chrono::high_resolution_clock::now();
+	
+	for (size_t j = 0; j < iterations; j++) {
+		visibleSingle = 0;
+		
+		for (const auto& bounds : boxes) {
+			if (vkcv::scene::checkFrustum(viewProjection, bounds)) {
+				visibleSingle++;
+			}
+		}
+	}
+	
+	auto end = std::chrono::high_resolution_clock::now();
+	
+	const auto timeSingle = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+	
+	std::vector<uint8_t> visibility;
+	size_t visibleBatched = 0;
+	
+	start = std::chrono::high_resolution_clock::now();
+	
+	for (size_t j = 0; j < iterations; j++) {
+		vkcv::scene::checkFrustum(viewProjection, boundsArray, visibility);
+	}
+	
+	end = std::chrono::high_resolution_clock::now();
+	
+	const auto timeBatched = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+	
+	for (const auto& visible : visibility) {
+		visibleBatched += visible;
+	}
+	
+	vkcv_log(vkcv::LogLevel::INFO, "Single: %zu / %zu visible in %.3f ms per iteration",
+			 visibleSingle, boxCount, timeSingle.count() * 0.001 / iterations);
+	
+	vkcv_log(vkcv::LogLevel::INFO, "Batched: %zu / %zu visible in %.3f ms per iteration",
+			 visibleBatched, boxCount, timeBatched.count() * 0.001 / iterations);
+	
+	vkcv_log(vkcv::LogLevel::INFO, "Speedup: %.2fx",
+			 static_cast<double>(timeSingle.count()) / std::max<double>(timeBatched.count(), 1.0));
+	
+	return 0;
+}
@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <GLFW/glfw3.h>
+
+#include <vkcv/Core.hpp>
+#include <vkcv/Logger.hpp>
+#include <vkcv/Sampler.hpp>
+
+/**
+ * Returns a buffer size unique to a given tag, so the buffer of a handle
+ * can be identified by its size.
+ */
+static size_t getTaggedSize(size_t tag) {
+	return (tag + 1) * sizeof(uint32_t);
+}
+
+int main(int argc, const char** argv) {
+	const std::string applicationName = "Handle stress";
+	
+#ifndef VKCV_ATOMIC_HANDLES
+	vkcv_log(vkcv::LogLevel::ERROR, "Handles are not thread-safe without BUILD_ATOMIC_HANDLES");
+	return EXIT_FAILURE;
+#endif
+	
+	const size_t threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+	const size_t handlesPerThread = 64;
+	const size_t persistentCount = 64;
+	const size_t frameCount = 200;
+	
+	vkcv::Core core = vkcv::Core::create(
+		applicationName,
+		VK_MAKE_VERSION(0, 0, 1),
+		{ vk::QueueFlagBits::eGraphics },
+		{ VK_KHR_SWAPCHAIN_EXTENSION_NAME }
+	);
+	
+	vkcv::WindowHandle windowHandle = core.createWindow(applicationName, 800, 600, false);
+	vkcv::Window& window = core.getWindow(windowHandle);
+	
+	// these buffers stay alive while the slots around them get reused
+	std::vector<vkcv::BufferHandle> persistentBuffers;
+	persistentBuffers.reserve(persistentCount);
+	
+	for (size_t i = 0; i < persistentCount; i++) {
+		persistentBuffers.push_back(core.createBuffer(
+				vkcv::BufferType::STORAGE,
+				getTaggedSize(i)
+		));
+	}
+	
+	std::atomic<size_t> errors = 0;
+	size_t frame = 0;
+	
+	core.run([&](const vkcv::WindowHandle &windowHandle, double t, double dt,
+				 uint32_t swapchainWidth, uint32_t swapchainHeight) {
+		std::vector<std::vector<vkcv::BufferHandle>> buffers (threadCount);
+		std::vector<std::thread> threads;
+		threads.reserve(threadCount);
+		
+		for (size_t i = 0; i < threadCount; i++) {
+			threads.emplace_back([&, i]() {
+				auto& ownBuffers = buffers[i];
+				ownBuffers.reserve(handlesPerThread);
+				
+				const size_t firstTag = persistentCount + i * handlesPerThread;
+				
+				for (size_t j = 0; j < handlesPerThread; j++) {
+					ownBuffers.push_back(core.createBuffer(
+							vkcv::BufferType::STORAGE,
+							getTaggedSize(firstTag + j)
+					));
+					
+					// samplers with equal parameters share one slot between all threads
+					const vkcv::SamplerHandle sampler = vkcv::samplerLinear(core, (j % 2) == 0);
+					
+					if (!core.getVulkanSampler(sampler)) {
+						errors++;
+					}
+				}
+				
+				for (size_t j = 0; j < handlesPerThread; j++) {
+					if (core.getBufferSize(ownBuffers[j]) != getTaggedSize(firstTag + j)) {
+						errors++;
+					}
+					
+					// half of the handles get released concurrently to the lookups of other threads
+					if (j % 2 == 1) {
+						ownBuffers[j] = vkcv::BufferHandle();
+					}
+				}
+			});
+		}
+		
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		
+		std::set<vk::Buffer> vulkanBuffers;
+		
+		for (size_t i = 0; i < persistentCount; i++) {
+			if ((core.getBufferSize(persistentBuffers[i]) != getTaggedSize(i)) ||
+				(!vulkanBuffers.insert(core.getBuffer(persistentBuffers[i])).second)) {
+				errors++;
+			}
+		}
+		
+		for (const auto& ownBuffers : buffers) {
+			for (const auto& buffer : ownBuffers) {
+				if ((buffer) && (!vulkanBuffers.insert(core.getBuffer(buffer)).second)) {
+					errors++;
+				}
+			}
+		}
+		
+		buffers.clear();
+		
+		auto cmdStream = core.createCommandStream(vkcv::QueueType::Graphics);
+		core.prepareSwapchainImageForPresent(cmdStream);
+		core.submitCommandStream(cmdStream);
+		
+		if (++frame >= frameCount) {
+			glfwSetWindowShouldClose(window.getWindow(), GLFW_TRUE);
+		}
+	});
+	
+	if (errors > 0) {
+		vkcv_log(vkcv::LogLevel::ERROR, "%zu handles aliased after %zu frames",
+				 errors.load(), frame);
+		return EXIT_FAILURE;
+	}
+	
+	vkcv_log(vkcv::LogLevel::INFO, "No handles aliased after %zu frames with %zu threads",
+			 frame, threadCount);
+	return EXIT_SUCCESS;
+}
@@ -506,18 +506,25 @@ int main(int argc, const char** argv) {
 
     vkcv::DescriptorBindings cullingBindings = cullingProgram.getReflectedDescriptors().at(0);
     vkcv::DescriptorSetLayoutHandle cullingSetLayout = core.createDescriptorSetLayout(cullingBindings);
-    vkcv::DescriptorSetHandle cullingDescSet = core.createDescriptorSet(cullingSetLayout);
 
-    vkcv::Buffer<CameraPlanes> cameraPlaneBuffer = vkcv::buffer<CameraPlanes>(
-			core,
-            vkcv::BufferType::UNIFORM,
-            1);
+    // the camera planes get updated every frame while previous frames are still in flight
+    std::vector<vkcv::Buffer<CameraPlanes>> cameraPlaneBuffers;
+    std::vector<vkcv::DescriptorSetHandle> cullingDescSets;
+
+    for (uint32_t i = 0; i < core.getFramesInFlight(); i++) {
+        cameraPlaneBuffers.push_back(vkcv::buffer<CameraPlanes>(
+				core,
+                vkcv::BufferType::UNIFORM,
+                1));
 
-    vkcv::DescriptorWrites cullingWrites;
-	cullingWrites.writeStorageBuffer(1, indirectBuffer.getHandle());
-	cullingWrites.writeStorageBuffer(2, boundingBoxBuffer.getHandle());
-    cullingWrites.writeUniformBuffer(0, cameraPlaneBuffer.getHandle());
-    core.writeDescriptorSet(cullingDescSet, cullingWrites);
+        cullingDescSets.push_back(core.createDescriptorSet(cullingSetLayout));
+
+        vkcv::DescriptorWrites cullingWrites;
+        cullingWrites.writeStorageBuffer(1, indirectBuffer.getHandle());
+        cullingWrites.writeStorageBuffer(2, boundingBoxBuffer.getHandle());
+        cullingWrites.writeUniformBuffer(0, cameraPlaneBuffers.back().getHandle());
+        core.writeDescriptorSet(cullingDescSets.back(), cullingWrites);
+    }
 
     vkcv_log(vkcv::LogLevel::TIME, "Culling descriptor set written");
 
@@ -547,10 +554,10 @@ int main(int argc, const char** argv) {
     ceiledDispatchCount = std::ceil(ceiledDispatchCount);
     const vkcv::DispatchSize dispatchCount = static_cast<uint32_t>(ceiledDispatchCount);
 
-    vkcv::DescriptorSetUsage cullingUsage = vkcv::useDescriptorSet(0, cullingDescSet);
     vkcv::PushConstants emptyPushConstant(0);
 
     bool updateFrustumPlanes    = true;
+    CameraPlanes cameraPlanes;
 	
 	core.run([&](const vkcv::WindowHandle &windowHandle, double t, double dt,
 				 uint32_t swapchainWidth, uint32_t swapchainHeight) {
@@ -573,18 +580,23 @@ int main(int argc, const char** argv) {
 		pushConstants.appendDrawcall(cam.getProjection() * cam.getView());
 
         if (updateFrustumPlanes) {
-            const CameraPlanes cameraPlanes = computeCameraPlanes(cam);
-            cameraPlaneBuffer.fill({ cameraPlanes });
+            cameraPlanes = computeCameraPlanes(cam);
         }
 
+        const uint32_t frameIndex = core.getCurrentFrameInFlight();
+        cameraPlaneBuffers[frameIndex].fill({ cameraPlanes });
+
 		const std::vector<vkcv::ImageHandle> renderTargets = { swapchainInput, depthBuffer };
 		auto cmdStream = core.createCommandStream(vkcv::QueueType::Graphics);
 
+        // the previous frame might still draw from the indirect buffer
+        core.recordBufferMemoryBarrier(cmdStream, indirectBuffer.getHandle());
+
         core.recordComputeDispatchToCmdStream(
 				cmdStream,
 				cullingPipelineHandle,
 				dispatchCount,
-				{cullingUsage},
+				{ vkcv::useDescriptorSet(0, cullingDescSets[frameIndex]) },
 				emptyPushConstant
 		);
 
@@ -608,7 +620,7 @@ int main(int argc, const char** argv) {
 		);
 
 		core.prepareSwapchainImageForPresent(cmdStream);
-		core.submitCommandStream(cmdStream);
+		core.submitCommandStreamAsync(cmdStream);
 		
         gui.beginGUI();
 
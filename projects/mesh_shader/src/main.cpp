@@ -221,20 +221,28 @@ int main(int argc, const char** argv) {
     const vkcv::VertexLayout bunnyLayout { bindings };
 
     vkcv::DescriptorSetLayoutHandle vertexShaderDescriptorSetLayout = core.createDescriptorSetLayout(bunnyShaderProgram.getReflectedDescriptors().at(0));
-    vkcv::DescriptorSetHandle vertexShaderDescriptorSet = core.createDescriptorSet(vertexShaderDescriptorSetLayout);
 
 	struct ObjectMatrices {
 		glm::mat4 model;
 		glm::mat4 mvp;
 	};
 	const size_t objectCount = 1;
-	vkcv::Buffer<ObjectMatrices> matrixBuffer = vkcv::buffer<ObjectMatrices>(
-			core, vkcv::BufferType::STORAGE, objectCount
-	);
 
-	vkcv::DescriptorWrites vertexShaderDescriptorWrites;
-	vertexShaderDescriptorWrites.writeStorageBuffer(0, matrixBuffer.getHandle());
-	core.writeDescriptorSet(vertexShaderDescriptorSet, vertexShaderDescriptorWrites);
+	// the matrices get updated every frame while previous frames are still in flight
+	std::vector<vkcv::Buffer<ObjectMatrices>> matrixBuffers;
+	std::vector<vkcv::DescriptorSetHandle> vertexShaderDescriptorSets;
+
+	for (uint32_t i = 0; i < core.getFramesInFlight(); i++) {
+		matrixBuffers.push_back(vkcv::buffer<ObjectMatrices>(
+				core, vkcv::BufferType::STORAGE, objectCount
+		));
+
+		vertexShaderDescriptorSets.push_back(core.createDescriptorSet(vertexShaderDescriptorSetLayout));
+
+		vkcv::DescriptorWrites vertexShaderDescriptorWrites;
+		vertexShaderDescriptorWrites.writeStorageBuffer(0, matrixBuffers.back().getHandle());
+		core.writeDescriptorSet(vertexShaderDescriptorSets.back(), vertexShaderDescriptorWrites);
+	}
 
 	vkcv::GraphicsPipelineHandle bunnyPipeline = core.createGraphicsPipeline(
 			vkcv::GraphicsPipelineConfig(
@@ -271,7 +279,6 @@ int main(int argc, const char** argv) {
 	});
 
 	vkcv::DescriptorSetLayoutHandle meshShaderDescriptorSetLayout = core.createDescriptorSetLayout(meshShaderProgram.getReflectedDescriptors().at(0));
-	vkcv::DescriptorSetHandle meshShaderDescriptorSet = core.createDescriptorSet(meshShaderDescriptorSetLayout);
 	const vkcv::VertexLayout meshShaderLayout = vkcv::createVertexLayout(bindings);
 
 	vkcv::GraphicsPipelineHandle meshShaderPipeline = core.createGraphicsPipeline(
@@ -289,24 +296,31 @@ int main(int argc, const char** argv) {
 		return EXIT_FAILURE;
 	}
 
-	vkcv::Buffer<CameraPlanes> cameraPlaneBuffer = vkcv::buffer<CameraPlanes>(
-			core, vkcv::BufferType::UNIFORM, 1
-	);
-
-	vkcv::DescriptorWrites meshShaderWrites;
-	meshShaderWrites.writeStorageBuffer(
-			0, meshShaderVertexBuffer.getHandle()
-	).writeStorageBuffer(
-			1, meshShaderIndexBuffer.getHandle()
-	).writeStorageBuffer(
-			2, meshletBuffer.getHandle()
-	).writeStorageBuffer(
-			4, matrixBuffer.getHandle()
-	);
-	
-	meshShaderWrites.writeUniformBuffer(3, cameraPlaneBuffer.getHandle());
+	std::vector<vkcv::Buffer<CameraPlanes>> cameraPlaneBuffers;
+	std::vector<vkcv::DescriptorSetHandle> meshShaderDescriptorSets;
+
+	for (uint32_t i = 0; i < core.getFramesInFlight(); i++) {
+		cameraPlaneBuffers.push_back(vkcv::buffer<CameraPlanes>(
+				core, vkcv::BufferType::UNIFORM, 1
+		));
+
+		meshShaderDescriptorSets.push_back(core.createDescriptorSet(meshShaderDescriptorSetLayout));
+
+		vkcv::DescriptorWrites meshShaderWrites;
+		meshShaderWrites.writeStorageBuffer(
+				0, meshShaderVertexBuffer.getHandle()
+		).writeStorageBuffer(
+				1, meshShaderIndexBuffer.getHandle()
+		).writeStorageBuffer(
+				2, meshletBuffer.getHandle()
+		).writeStorageBuffer(
+				4, matrixBuffers[i].getHandle()
+		);
+		
+		meshShaderWrites.writeUniformBuffer(3, cameraPlaneBuffers.back().getHandle());
 
-  core.writeDescriptorSet( meshShaderDescriptorSet, meshShaderWrites);
+		core.writeDescriptorSet(meshShaderDescriptorSets.back(), meshShaderWrites);
+	}
 
   vkcv::ImageHandle depthBuffer;
 	vkcv::ImageHandle swapchainImageHandle = vkcv::ImageHandle::createSwapchainImageHandle();
@@ -324,6 +338,7 @@ int main(int argc, const char** argv) {
 
 	bool useMeshShader       = true;
 	bool updateFrustumPlanes = true;
+	CameraPlanes cameraPlanes;
 	
 	core.run([&](const vkcv::WindowHandle &windowHandle, double t, double dt,
 				 uint32_t swapchainWidth, uint32_t swapchainHeight) {
@@ -347,13 +362,15 @@ int main(int argc, const char** argv) {
 		objectMatrices.model = *reinterpret_cast<glm::mat4*>(&mesh.meshes.front().modelMatrix);
 		objectMatrices.mvp   = camera.getMVP() * objectMatrices.model;
 
-		matrixBuffer.fill({ objectMatrices });
+		const uint32_t frameIndex = core.getCurrentFrameInFlight();
+		matrixBuffers[frameIndex].fill({ objectMatrices });
 
 		if (updateFrustumPlanes) {
-			const CameraPlanes cameraPlanes = computeCameraPlanes(camera);
-			cameraPlaneBuffer.fill({ cameraPlanes });
+			cameraPlanes = computeCameraPlanes(camera);
 		}
 
+		cameraPlaneBuffers[frameIndex].fill({ cameraPlanes });
+
 		const std::vector<vkcv::ImageHandle> renderTargets = { swapchainInput, depthBuffer };
 		auto cmdStream = core.createCommandStream(vkcv::QueueType::Graphics);
 
@@ -364,7 +381,7 @@ int main(int argc, const char** argv) {
 					meshShaderModelData.meshlets.size(), 32
 			));
 			
-			drawcall.useDescriptorSet(0, meshShaderDescriptorSet);
+			drawcall.useDescriptorSet(0, meshShaderDescriptorSets[frameIndex]);
 			core.recordMeshShaderDrawcalls(
 				cmdStream,
 				meshShaderPipeline,
@@ -375,7 +392,7 @@ int main(int argc, const char** argv) {
 			);
 		} else {
 			vkcv::InstanceDrawcall drawcall (vertexData);
-			drawcall.useDescriptorSet(0, vertexShaderDescriptorSet);
+			drawcall.useDescriptorSet(0, vertexShaderDescriptorSets[frameIndex]);
 
 			core.recordDrawcallsToCmdStream(
 				cmdStream,
@@ -388,7 +405,7 @@ int main(int argc, const char** argv) {
 		}
 
 		core.prepareSwapchainImageForPresent(cmdStream);
-		core.submitCommandStream(cmdStream);
+		core.submitCommandStreamAsync(cmdStream);
 		
 		gui.beginGUI();
 		
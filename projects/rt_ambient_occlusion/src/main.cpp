@@ -105,10 +105,15 @@ int main(int argc, const char** argv) {
 	std::vector<vkcv::DescriptorSetLayoutHandle> descriptorSetLayoutHandles;
 
 	vkcv::DescriptorSetLayoutHandle shaderDescriptorSetLayout = core.createDescriptorSetLayout(shaderProgram.getReflectedDescriptors().at(0));
-	vkcv::DescriptorSetHandle shaderDescriptorSet = core.createDescriptorSet(shaderDescriptorSetLayout);
-	descriptorSetHandles.push_back(shaderDescriptorSet);
 	descriptorSetLayoutHandles.push_back(shaderDescriptorSetLayout);
 	
+	// the color buffer gets replaced while previous frames are still in flight
+	for (uint32_t i = 0; i < core.getFramesInFlight(); i++) {
+		descriptorSetHandles.push_back(core.createDescriptorSet(shaderDescriptorSetLayout));
+	}
+	
+	std::vector<bool> descriptorSetsOutdated (descriptorSetHandles.size(), true);
+	
 	const uint32_t instanceCount = scene.getMeshCount();
 	const uint32_t geometryCount = scene.getMeshPartCount();
 	
@@ -158,12 +163,12 @@ int main(int argc, const char** argv) {
 	context[0] = instanceCount;
 	context[1] = 16;
 	
-	{
+	for (const auto& descriptorSet : descriptorSetHandles) {
 		vkcv::DescriptorWrites writes;
 		writes.writeAcceleration(1, { scene_tlas });
 		writes.writeStorageBuffer(2, objDescBuffer.getHandle());
 		writes.writeStorageBuffer(3, contextBuffer.getHandle());
-		core.writeDescriptorSet(descriptorSetHandles[0], writes);
+		core.writeDescriptorSet(descriptorSet, writes);
 	}
 	
 	vkcv::upscaling::FSRUpscaling upscaling (core);
@@ -250,6 +255,8 @@ int main(int argc, const char** argv) {
 					colorBufferFormat,
 					colorBufferConfig
 			);
+			
+			descriptorSetsOutdated.assign(descriptorSetsOutdated.size(), true);
 		}
 		
 		if ((!colorBuffer) || (!depthBuffer)) {
@@ -271,10 +278,15 @@ int main(int argc, const char** argv) {
 		vkcv::PushConstants pushConstants = vkcv::pushConstants<RaytracingPushConstantData>();
 		pushConstants.appendDrawcall(raytracingPushData);
 		
-		{
+		const uint32_t frameIndex = core.getCurrentFrameInFlight();
+		const vkcv::DescriptorSetHandle shaderDescriptorSet = descriptorSetHandles[frameIndex];
+		
+		if (descriptorSetsOutdated[frameIndex]) {
 			vkcv::DescriptorWrites writes;
 			writes.writeStorageImage(0, colorBuffer);
 			core.writeDescriptorSet(shaderDescriptorSet, writes);
+			
+			descriptorSetsOutdated[frameIndex] = false;
 		}
 
 		auto cmdStream = core.createCommandStream(vkcv::QueueType::Graphics);
@@ -296,7 +308,7 @@ int main(int argc, const char** argv) {
 		upscaling.recordUpscaling(cmdStream, colorBuffer, swapchainInput);
 
 		core.prepareSwapchainImageForPresent(cmdStream);
-		core.submitCommandStream(cmdStream);
+		core.submitCommandStreamAsync(cmdStream);
 		
 		gui.beginGUI();
 		
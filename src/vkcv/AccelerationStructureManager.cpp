@@ -24,8 +24,8 @@ namespace vkcv {
 	}
 	
 	AccelerationStructureHandle
-	AccelerationStructureManager::createById(uint64_t id, const HandleDestroyFunction &destroy) {
-		return AccelerationStructureHandle(id, destroy);
+	AccelerationStructureManager::createById(uint64_t id, HandleCounter &counter) {
+		return AccelerationStructureHandle(id, counter, *this);
 	}
 	
 	void AccelerationStructureManager::destroyById(uint64_t id) {
@@ -386,7 +386,7 @@ namespace vkcv {
 			
 			const auto indexBufferAddress = bufferManager.getBufferDeviceAddress(
 					data.getIndexBuffer()
-			);
+			) + data.getIndexOffset();
 			
 			const auto vertexStride = data.getVertexStride();
 			const auto maxVertex = data.getMaxVertexIndex();
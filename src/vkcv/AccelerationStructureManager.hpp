@@ -44,7 +44,7 @@ namespace vkcv {
 		
 		[[nodiscard]] AccelerationStructureHandle createById(
 				uint64_t id,
-				const HandleDestroyFunction &destroy) override;
+				HandleCounter &counter) override;
 		
 		/**
 		 * Destroys and deallocates image represented by a given
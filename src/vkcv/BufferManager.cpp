@@ -4,18 +4,43 @@
  */
 
 #include "BufferManager.hpp"
+#include "CommandStreamManager.hpp"
 #include "vkcv/Core.hpp"
 #include <vkcv/Logger.hpp>
 
+#include <algorithm>
 #include <limits>
 #include <numeric>
 
 namespace vkcv {
 
-	bool BufferManager::init(Core &core) {
+	/**
+	 * @brief Size of the persistently mapped staging buffer in bytes.
+	 */
+	constexpr size_t STAGING_BUFFER_SIZE = 64 * 1024 * 1024;
+
+	/**
+	 * @brief Alignment of ranges inside the staging buffer in bytes.
+	 */
+	constexpr size_t STAGING_BUFFER_ALIGNMENT = 16;
+
+	/**
+	 * @brief Size of the blocks of buffer arenas in bytes.
+	 */
+	constexpr size_t BUFFER_ARENA_BLOCK_SIZE = 64 * 1024 * 1024;
+
+	/**
+	 * @brief Maximum size of ranges allocated from blocks of buffer arenas
+	 * in bytes, larger ranges get their own buffer.
+	 */
+	constexpr size_t BUFFER_ARENA_MAX_RANGE_SIZE = BUFFER_ARENA_BLOCK_SIZE / 4;
+
+	bool BufferManager::init(Core &core, CommandStreamManager &commandStreamManager) {
 		if (!HandleManager<BufferEntry, BufferHandle>::init(core)) {
 			return false;
 		}
+
+		m_commandStreamManager = &commandStreamManager;
 		
 		const vma::Allocator &allocator = getCore().getContext().getAllocator();
 		const auto& memoryProperties = allocator.getMemoryProperties();
@@ -71,10 +96,26 @@ namespace vkcv {
 				TypeGuard(1),
 				BufferType::STAGING,
 				BufferMemoryType::HOST_VISIBLE,
-				1024 * 1024,
+				STAGING_BUFFER_SIZE,
 				false
 		);
 
+		// the staging buffer stays mapped until its destruction
+		auto &stagingBuffer = (*this) [m_stagingBuffer];
+		stagingBuffer.m_mapping = reinterpret_cast<char*>(
+				allocator.mapMemory(stagingBuffer.m_allocation)
+		);
+
+		stagingBuffer.m_mapCounter = 1;
+
+		m_stagingHead = 0;
+		m_stagingTail = 0;
+
+		m_stagingRegions.clear();
+		m_stagingSegments.clear();
+
+		m_stagingStream = CommandStreamHandle();
+		m_acquireStream = CommandStreamHandle();
 		return true;
 	}
 
@@ -82,8 +123,8 @@ namespace vkcv {
 		return handle.getId();
 	}
 
-	BufferHandle BufferManager::createById(uint64_t id, const HandleDestroyFunction &destroy) {
-		return BufferHandle(id, destroy);
+	BufferHandle BufferManager::createById(uint64_t id, HandleCounter &counter) {
+		return BufferHandle(id, counter, *this);
 	}
 
 	void BufferManager::destroyById(uint64_t id) {
@@ -107,12 +148,91 @@ namespace vkcv {
 		HandleManager<BufferEntry, BufferHandle>(),
 		m_resizableBar(false),
 		m_shaderDeviceAddress(false),
-		m_stagingBuffer(BufferHandle()) {}
+		m_commandStreamManager(nullptr),
+		m_stagingBuffer(BufferHandle()),
+		m_stagingHead(0),
+		m_stagingTail(0),
+		m_stagingRegions(),
+		m_stagingSegments(),
+		m_stagingStream(),
+		m_acquireStream(),
+		m_arenas(),
+		m_arenaMutex() {}
 
 	BufferManager::~BufferManager() noexcept {
+		m_stagingRegions.clear();
+		m_stagingSegments.clear();
+
+		m_stagingStream = CommandStreamHandle();
+		m_acquireStream = CommandStreamHandle();
+
+		m_arenas.clear();
+
 		clear();
 	}
 
+	void BufferManager::retireStagingSegments() {
+		while (!m_stagingSegments.empty()) {
+			const StagingSegment segment = m_stagingSegments.front();
+
+			if (!m_commandStreamManager->isSubmissionFinished(segment.m_submission)) {
+				break;
+			}
+
+			m_stagingTail = segment.m_end;
+			m_stagingSegments.erase(m_stagingSegments.begin());
+		}
+
+		if ((m_stagingSegments.empty()) && (!hasPendingStaging())) {
+			m_stagingHead = 0;
+			m_stagingTail = 0;
+		}
+	}
+
+	bool BufferManager::hasPendingStaging() const {
+		return ((!m_stagingRegions.empty()) || (m_stagingStream) || (m_acquireStream));
+	}
+
+	size_t BufferManager::allocateStaging(size_t size, size_t alignment) {
+		const size_t stagingSize = getBufferSize(m_stagingBuffer);
+
+		if (size > stagingSize) {
+			vkcv_log(LogLevel::ERROR, "Staging allocation exceeds the staging buffer");
+			return 0;
+		}
+
+		while (true) {
+			retireStagingSegments();
+
+			const bool empty = ((m_stagingSegments.empty()) && (!hasPendingStaging()));
+			const size_t head = (m_stagingHead + alignment - 1) / alignment * alignment;
+
+			if ((empty) || (m_stagingHead > m_stagingTail)) {
+				if (head + size <= stagingSize) {
+					m_stagingHead = head + size;
+					return head;
+				}
+
+				// wrap around to the beginning of the ring
+				if (size <= m_stagingTail) {
+					m_stagingHead = size;
+					return 0;
+				}
+			} else if ((m_stagingHead < m_stagingTail) && (head + size <= m_stagingTail)) {
+				m_stagingHead = head + size;
+				return head;
+			}
+
+			if (hasPendingStaging()) {
+				flushStagingBuffer();
+			} else {
+				m_commandStreamManager->waitForSubmission(
+						m_stagingSegments.front().m_submission
+				);
+			}
+		}
+	}
+
 	bool BufferManager::useResizableBar() const {
 		return m_resizableBar;
 	}
@@ -253,118 +373,59 @@ namespace vkcv {
 		});
 	}
 
-	/**
-	 * @brief Structure to store details required for a write staging process.
-	 */
-	struct StagingWriteInfo {
-		const void* data;
-		size_t size;
-		size_t offset;
-
-		vk::Buffer buffer;
-		vk::Buffer stagingBuffer;
-		vma::Allocation stagingAllocation;
-
-		size_t stagingLimit;
-		size_t stagingPosition;
-	};
-
-	/**
-	 * Copies data from CPU to a staging buffer and submits the commands to copy
-	 * each part one after another into the actual target buffer.
-	 *
-	 * The function can be used fully asynchronously!
-	 * Just be careful to not use the staging buffer in parallel!
-	 *
-	 * @param core Core instance
-	 * @param info Staging-info structure
-	 */
-	static void fillFromStagingBuffer(Core &core, StagingWriteInfo &info) {
-		const size_t remaining = info.size - info.stagingPosition;
-		const size_t mapped_size = std::min(remaining, info.stagingLimit);
-
-		const vma::Allocator &allocator = core.getContext().getAllocator();
-
-		void* mapped = allocator.mapMemory(info.stagingAllocation);
-		memcpy(mapped, reinterpret_cast<const char*>(info.data) + info.stagingPosition,
-			   mapped_size);
-		allocator.unmapMemory(info.stagingAllocation);
-
-		auto stream = core.createCommandStream(QueueType::Transfer);
-
-		core.recordCommandsToStream(
-			stream,
-			[&info, &mapped_size](const vk::CommandBuffer &commandBuffer) {
-				const vk::BufferCopy region(0, info.offset + info.stagingPosition, mapped_size);
-
-				commandBuffer.copyBuffer(info.stagingBuffer, info.buffer, 1, &region);
-			},
-			[&core, &info, &mapped_size, &remaining]() {
-				if (mapped_size < remaining) {
-					info.stagingPosition += mapped_size;
-
-					fillFromStagingBuffer(core, info);
-				}
-			});
-
-		core.submitCommandStream(stream, false);
-	}
-
-	/**
-	 * @brief Structure to store details required for a read staging process.
-	 */
-	struct StagingReadInfo {
-		void* data;
-		size_t size;
-		size_t offset;
+	BufferRange BufferManager::allocateBufferRange(BufferType type,
+												   BufferMemoryType memoryType,
+												   size_t size,
+												   size_t alignment) {
+		if (size == 0) {
+			return { BufferHandle(), 0, 0 };
+		}
 
-		vk::Buffer buffer;
-		vk::Buffer stagingBuffer;
-		vma::Allocation stagingAllocation;
+		if (size > BUFFER_ARENA_MAX_RANGE_SIZE) {
+			const BufferHandle buffer = createBuffer(TypeGuard(1), type, memoryType, size, false);
+			
+			if (buffer) {
+				getCore().setDebugLabel(buffer, "vkcv::BufferArena");
+			}
+			
+			return { buffer, 0, size };
+		}
 
-		size_t stagingLimit;
-		size_t stagingPosition;
-	};
+		alignment = std::max<size_t>(alignment, 1);
 
-	/**
-	 * Copies data from a staging buffer to CPU and submits the commands to copy
-	 * each part one after another into the actual target data pointer.
-	 *
-	 * The function can be used fully asynchronously!
-	 * Just be careful to not use the staging buffer in parallel!
-	 *
-	 * @param core Core instance
-	 * @param info Staging-info structure
-	 */
-	static void readToStagingBuffer(Core &core, StagingReadInfo &info) {
-		const size_t remaining = info.size - info.stagingPosition;
-		const size_t mapped_size = std::min(remaining, info.stagingLimit);
+		const uint64_t key = (
+			(static_cast<uint64_t>(type) << 32) |
+			static_cast<uint64_t>(memoryType)
+		);
 
-		auto stream = core.createCommandStream(QueueType::Transfer);
+		std::lock_guard<std::mutex> lock(m_arenaMutex);
+		auto &arena = m_arenas [key];
 
-		core.recordCommandsToStream(
-			stream,
-			[&info, &mapped_size](const vk::CommandBuffer &commandBuffer) {
-				const vk::BufferCopy region(info.offset + info.stagingPosition, 0, mapped_size);
+		BufferHandle block;
+		size_t offset = 0;
 
-				commandBuffer.copyBuffer(info.buffer, info.stagingBuffer, 1, &region);
-			},
-			[&core, &info, &mapped_size, &remaining]() {
-				const vma::Allocator &allocator = core.getContext().getAllocator();
+		// the block is only referenced by its ranges, so it might be destroyed already
+		if (arena.m_size > 0) {
+			block = createHandleIfReferenced(arena.m_id);
+			offset = (arena.m_head + alignment - 1) / alignment * alignment;
+		}
 
-				const void* mapped = allocator.mapMemory(info.stagingAllocation);
-				memcpy(reinterpret_cast<char*>(info.data) + info.stagingPosition, mapped,
-					   mapped_size);
-				allocator.unmapMemory(info.stagingAllocation);
+		if ((!block) || (offset + size > arena.m_size)) {
+			block = createBuffer(TypeGuard(1), type, memoryType, BUFFER_ARENA_BLOCK_SIZE, false);
 
-				if (mapped_size < remaining) {
-					info.stagingPosition += mapped_size;
+			if (!block) {
+				arena = { 0, 0, 0 };
+				return { BufferHandle(), 0, 0 };
+			}
 
-					readToStagingBuffer(core, info);
-				}
-			});
+			getCore().setDebugLabel(block, "vkcv::BufferArena");
+			
+			arena = { block.getId(), 0, BUFFER_ARENA_BLOCK_SIZE };
+			offset = 0;
+		}
 
-		core.submitCommandStream(stream, false);
+		arena.m_head = offset + size;
+		return { block, offset, size };
 	}
 
 	vk::Buffer BufferManager::getBuffer(const BufferHandle &handle) const {
@@ -439,22 +500,19 @@ namespace vkcv {
 			void* mapped = allocator.mapMemory(buffer.m_allocation);
 			memcpy(reinterpret_cast<char*>(mapped) + offset, data, max_size);
 			allocator.unmapMemory(buffer.m_allocation);
-		} else {
-			auto &stagingBuffer = (*this) [m_stagingBuffer];
-
-			StagingWriteInfo info;
-			info.data = data;
-			info.size = max_size;
-			info.offset = offset;
+			return;
+		}
 
-			info.buffer = buffer.m_handle;
-			info.stagingBuffer = stagingBuffer.m_handle;
-			info.stagingAllocation = stagingBuffer.m_allocation;
+		size_t position = 0;
 
-			info.stagingLimit = stagingBuffer.m_size;
-			info.stagingPosition = 0;
+		while (position < max_size) {
+			const size_t chunk_size = std::min(max_size - position, STAGING_BUFFER_SIZE);
+			const size_t stagingOffset = stageData(
+				reinterpret_cast<const char*>(data) + position, chunk_size,
+				STAGING_BUFFER_ALIGNMENT);
 
-			fillFromStagingBuffer(getCore(), info);
+			m_stagingRegions.push_back({ handle, stagingOffset, offset + position, chunk_size });
+			position += chunk_size;
 		}
 	}
 
@@ -480,23 +538,51 @@ namespace vkcv {
 			const void* mapped = allocator.mapMemory(buffer.m_allocation);
 			memcpy(data, reinterpret_cast<const char*>(mapped) + offset, max_size);
 			allocator.unmapMemory(buffer.m_allocation);
-		} else {
-			auto &stagingBuffer = (*this) [m_stagingBuffer];
+			return;
+		}
+
+		// pending copies need to be finished before reading
+		m_commandStreamManager->waitForSubmission(flushStagingBuffer());
+
+		size_t position = 0;
+
+		while (position < max_size) {
+			const size_t chunk_size = std::min(max_size - position, STAGING_BUFFER_SIZE);
+			const size_t stagingOffset = allocateStaging(chunk_size, STAGING_BUFFER_ALIGNMENT);
+
+			const vk::Buffer srcBuffer = getBuffer(handle);
+			const vk::Buffer stagingBuffer = getBuffer(m_stagingBuffer);
+
+			auto stream = getCore().createCommandStream(QueueType::Transfer);
+
+			getCore().recordCommandsToStream(
+				stream,
+				[&](const vk::CommandBuffer &commandBuffer) {
+					const vk::BufferCopy region(offset + position, stagingOffset, chunk_size);
+
+					commandBuffer.copyBuffer(srcBuffer, stagingBuffer, 1, &region);
+				},
+				nullptr);
 
-			StagingReadInfo info;
-			info.data = data;
-			info.size = max_size;
-			info.offset = offset;
+			Vector<vk::Semaphore> waitSemaphores;
+			Vector<vk::Semaphore> signalSemaphores;
 
-			info.buffer = buffer.m_handle;
-			info.stagingBuffer = stagingBuffer.m_handle;
-			info.stagingAllocation = stagingBuffer.m_allocation;
+			const uint64_t submission = m_commandStreamManager->submitCommandStreamAsynchronous(
+				stream, waitSemaphores, signalSemaphores);
 
-			info.stagingLimit = stagingBuffer.m_size;
-			info.stagingPosition = 0;
+			m_stagingSegments.push_back({ submission, m_stagingHead });
+			m_commandStreamManager->waitForSubmission(submission);
 
-			readToStagingBuffer(getCore(), info);
+			const auto &staging = (*this) [m_stagingBuffer];
+
+			allocator.invalidateAllocation(staging.m_allocation, stagingOffset, chunk_size);
+			memcpy(reinterpret_cast<char*>(data) + position, staging.m_mapping + stagingOffset,
+				   chunk_size);
+
+			position += chunk_size;
 		}
+
+		retireStagingSegments();
 	}
 
 	void* BufferManager::mapBuffer(const BufferHandle &handle, size_t offset, size_t size) {
@@ -567,6 +653,207 @@ namespace vkcv {
 		buffer.m_mapCounter = 0;
 	}
 
+	uint64_t BufferManager::flushStagingBuffer() {
+		if (!hasPendingStaging()) {
+			return 0;
+		}
+
+		const CommandStreamHandle stagingStream = getStagingStream();
+		const CommandStreamHandle acquireStream = getAcquireStream();
+
+		m_stagingStream = CommandStreamHandle();
+		m_acquireStream = CommandStreamHandle();
+
+		Vector<StagingRegion> regions;
+		std::swap(regions, m_stagingRegions);
+
+		const auto &queueManager = getCore().getContext().getQueueManager();
+		const Queue transferQueue = queueManager.getTransferQueues().front();
+		const Queue graphicsQueue = queueManager.getGraphicsQueues().front();
+
+		const bool sameQueue = (transferQueue.handle == graphicsQueue.handle);
+		const bool ownershipTransfer = (transferQueue.familyIndex != graphicsQueue.familyIndex);
+
+		const uint32_t srcQueueFamily =
+			ownershipTransfer ? transferQueue.familyIndex : VK_QUEUE_FAMILY_IGNORED;
+		const uint32_t dstQueueFamily =
+			ownershipTransfer ? graphicsQueue.familyIndex : VK_QUEUE_FAMILY_IGNORED;
+
+		Vector<vk::BufferMemoryBarrier> barriers;
+		barriers.reserve(regions.size());
+
+		for (const auto &region : regions) {
+			barriers.emplace_back(vk::AccessFlagBits::eTransferWrite,
+								  vk::AccessFlagBits::eMemoryRead, srcQueueFamily,
+								  dstQueueFamily, getBuffer(region.m_buffer), region.m_offset,
+								  region.m_size);
+		}
+
+		const vk::Buffer stagingBuffer = getBuffer(m_stagingBuffer);
+
+		getCore().recordCommandsToStream(
+			stagingStream,
+			[&](const vk::CommandBuffer &commandBuffer) {
+				Vector<vk::BufferCopy> copies;
+
+				// consecutive regions of the same buffer get copied at once
+				for (size_t i = 0; i < regions.size(); i++) {
+					copies.emplace_back(regions [i].m_stagingOffset, regions [i].m_offset,
+										regions [i].m_size);
+
+					if ((i + 1 < regions.size()) &&
+						(barriers [i + 1].buffer == barriers [i].buffer)) {
+						continue;
+					}
+
+					commandBuffer.copyBuffer(stagingBuffer, barriers [i].buffer, copies);
+					copies.clear();
+				}
+
+				if (barriers.empty()) {
+					return;
+				}
+
+				if (sameQueue) {
+					commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+												  vk::PipelineStageFlagBits::eAllCommands, {},
+												  nullptr, barriers, nullptr);
+				} else if (ownershipTransfer) {
+					commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+												  vk::PipelineStageFlagBits::eBottomOfPipe, {},
+												  nullptr, barriers, nullptr);
+				}
+			},
+			nullptr);
+
+		Vector<vk::Semaphore> waitSemaphores;
+		Vector<vk::Semaphore> signalSemaphores;
+
+		uint64_t submission;
+
+		if (sameQueue) {
+			submission = m_commandStreamManager->submitCommandStreamAsynchronous(
+				stagingStream, waitSemaphores, signalSemaphores);
+		} else {
+			const vk::Device &device = getCore().getContext().getDevice();
+			const vk::Semaphore semaphore = device.createSemaphore({});
+
+			signalSemaphores.push_back(semaphore);
+
+			m_commandStreamManager->submitCommandStreamAsynchronous(
+				stagingStream, waitSemaphores, signalSemaphores);
+
+			// the graphics queue acquires the buffers after the copies have finished, the
+			// barrier chains the semaphore wait into all later submissions of the queue
+			getCore().recordCommandsToStream(
+				acquireStream,
+				[&](const vk::CommandBuffer &commandBuffer) {
+					if (barriers.empty()) {
+						return;
+					}
+
+					if (ownershipTransfer) {
+						commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe,
+													  vk::PipelineStageFlagBits::eAllCommands,
+													  {}, nullptr, barriers, nullptr);
+					} else {
+						commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands,
+													  vk::PipelineStageFlagBits::eAllCommands,
+													  {}, nullptr, barriers, nullptr);
+					}
+				},
+				[device, semaphore]() {
+					device.destroySemaphore(semaphore);
+				});
+
+			waitSemaphores.push_back(semaphore);
+			signalSemaphores.clear();
+
+			submission = m_commandStreamManager->submitCommandStreamAsynchronous(
+				acquireStream, waitSemaphores, signalSemaphores);
+		}
+
+		m_stagingSegments.push_back({ submission, m_stagingHead });
+		return submission;
+	}
+
+	size_t BufferManager::getStagingBufferSize() const {
+		return getBufferSize(m_stagingBuffer);
+	}
+
+	vk::Buffer BufferManager::getStagingBuffer() const {
+		return getBuffer(m_stagingBuffer);
+	}
+
+	size_t BufferManager::stageData(const void* data, size_t size, size_t alignment) {
+		const size_t stagingOffset = allocateStaging(size, alignment);
+		const auto &stagingBuffer = (*this) [m_stagingBuffer];
+
+		memcpy(stagingBuffer.m_mapping + stagingOffset, data, size);
+
+		getCore().getContext().getAllocator().flushAllocation(
+				stagingBuffer.m_allocation, stagingOffset, size
+		);
+
+		return stagingOffset;
+	}
+
+	const CommandStreamHandle &BufferManager::getStagingStream() {
+		if (!m_stagingStream) {
+			m_stagingStream = getCore().createCommandStream(QueueType::Transfer);
+		}
+
+		return m_stagingStream;
+	}
+
+	const CommandStreamHandle &BufferManager::getAcquireStream() {
+		const auto &queueManager = getCore().getContext().getQueueManager();
+
+		// uploads on the graphics queue need no separate stream to acquire them
+		if (queueManager.getTransferQueues().front().handle ==
+			queueManager.getGraphicsQueues().front().handle) {
+			return getStagingStream();
+		}
+
+		if (!m_acquireStream) {
+			m_acquireStream = getCore().createCommandStream(QueueType::Graphics);
+		}
+
+		return m_acquireStream;
+	}
+
+	void BufferManager::setDebugLabel(const BufferHandle &handle, const std::string &label) {
+		auto &buffer = (*this) [handle];
+
+		if (!buffer.m_allocation) {
+			return;
+		}
+
+		const vma::Allocator &allocator = getCore().getContext().getAllocator();
+		allocator.setAllocationName(buffer.m_allocation, label.c_str());
+	}
+
+	void BufferManager::appendMemoryStatistics(MemoryStatistics &statistics) const {
+		const vma::Allocator &allocator = getCore().getContext().getAllocator();
+		const uint64_t count = getCount();
+
+		for (uint64_t id = 0; id < count; id++) {
+			const auto &buffer = getById(id);
+
+			if ((!buffer.m_handle) || (!buffer.m_allocation)) {
+				continue;
+			}
+
+			const auto info = allocator.getAllocationInfo(buffer.m_allocation);
+
+			addMemoryUsage(statistics.bufferTypes [buffer.m_type], info.size);
+
+			if ((info.pName) && (*(info.pName))) {
+				addMemoryUsage(statistics.labels [info.pName], info.size);
+			}
+		}
+	}
+
 	void BufferManager ::recordBufferMemoryBarrier(const BufferHandle &handle,
 												   vk::CommandBuffer cmdBuffer) {
 		auto &buffer = (*this) [handle];
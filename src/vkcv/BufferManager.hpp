@@ -6,12 +6,15 @@
  */
 
 #include <memory>
+#include <mutex>
 
 #include <vk_mem_alloc.hpp>
 #include <vulkan/vulkan.hpp>
 
+#include "vkcv/BufferRange.hpp"
 #include "vkcv/BufferTypes.hpp"
 #include "vkcv/Container.hpp"
+#include "vkcv/MemoryStatistics.hpp"
 #include "vkcv/TypeGuard.hpp"
 
 #include "HandleManager.hpp"
@@ -34,6 +37,38 @@ namespace vkcv {
 		size_t m_mapCounter;
 	};
 
+	/**
+	 * @brief Structure to store a pending copy from the staging buffer
+	 * into a buffer.
+	 */
+	struct StagingRegion {
+		BufferHandle m_buffer;
+		size_t m_stagingOffset;
+		size_t m_offset;
+		size_t m_size;
+	};
+
+	/**
+	 * @brief Structure to store the end of a segment in the staging buffer
+	 * which is in use until a given submission has been retired.
+	 */
+	struct StagingSegment {
+		uint64_t m_submission;
+		size_t m_end;
+	};
+
+	/**
+	 * @brief Structure to store the current block of an arena which
+	 * ranges of buffer memory get linearly allocated from.
+	 */
+	struct BufferArena {
+		uint64_t m_id;
+		size_t m_head;
+		size_t m_size;
+	};
+
+	class CommandStreamManager;
+
 	/**
 	 * @brief Class to manage the creation, destruction, allocation
 	 * and filling of buffers.
@@ -47,14 +82,28 @@ namespace vkcv {
 		bool m_resizableBar;
 		bool m_shaderDeviceAddress;
 		
+		CommandStreamManager* m_commandStreamManager;
+
 		BufferHandle m_stagingBuffer;
+		size_t m_stagingHead;
+		size_t m_stagingTail;
+
+		Vector<StagingRegion> m_stagingRegions;
+		Vector<StagingSegment> m_stagingSegments;
+
+		CommandStreamHandle m_stagingStream;
+		CommandStreamHandle m_acquireStream;
+
+		Dictionary<uint64_t, BufferArena> m_arenas;
+		std::mutex m_arenaMutex;
 
-		bool init(Core &core) override;
+		using HandleManager<BufferEntry, BufferHandle>::init;
+		bool init(Core &core, CommandStreamManager &commandStreamManager);
 
 		[[nodiscard]] uint64_t getIdFrom(const BufferHandle &handle) const override;
 
 		[[nodiscard]] BufferHandle createById(uint64_t id,
-											  const HandleDestroyFunction &destroy) override;
+											  HandleCounter &counter) override;
 
 		/**
 		 * Destroys and deallocates buffer represented by a given
@@ -64,6 +113,29 @@ namespace vkcv {
 		 */
 		void destroyById(uint64_t id) override;
 
+		/**
+		 * @brief Releases all segments of the staging buffer which
+		 * are not in use by any pending submission anymore.
+		 */
+		void retireStagingSegments();
+
+		/**
+		 * @brief Returns whether any uploads are pending to be flushed.
+		 *
+		 * @return True, if uploads are pending, otherwise false
+		 */
+		[[nodiscard]] bool hasPendingStaging() const;
+
+		/**
+		 * @brief Allocates a range of the staging buffer, waiting for
+		 * previous submissions to finish if necessary.
+		 *
+		 * @param[in] size Size of the range in bytes
+		 * @param[in] alignment Alignment of the range in bytes
+		 * @return Offset of the range in the staging buffer
+		 */
+		size_t allocateStaging(size_t size, size_t alignment);
+
 	public:
 		BufferManager() noexcept;
 
@@ -88,6 +160,28 @@ namespace vkcv {
 												BufferMemoryType memoryType, size_t size,
 												bool readable, size_t alignment = 0);
 
+		/**
+		 * @brief Allocates a range of memory from a large pooled buffer
+		 * of a given type and memory type. Ranges get allocated linearly
+		 * from the current block of the arena, so many small allocations
+		 * share a single buffer and a single allocation of device memory.
+		 *
+		 * The block stays alive as long as any range of it is referenced.
+		 * Memory of released ranges will not be reused before all ranges
+		 * of their block are released. Ranges which are too large for a
+		 * block get their own buffer.
+		 *
+		 * @param[in] type Type of buffer
+		 * @param[in] memoryType Type of buffers memory
+		 * @param[in] size Size of the range in bytes
+		 * @param[in] alignment Alignment of the range in bytes
+		 * @return Range of buffer memory
+		 */
+		[[nodiscard]] BufferRange allocateBufferRange(BufferType type,
+													  BufferMemoryType memoryType,
+													  size_t size,
+													  size_t alignment);
+
 		/**
 		 * @brief Returns the Vulkan buffer handle of a buffer
 		 * represented by a given buffer handle.
@@ -197,6 +291,78 @@ namespace vkcv {
 		 */
 		void unmapBuffer(const BufferHandle &handle);
 
+		/**
+		 * @brief Submits all pending copies from the staging buffer
+		 * with one submission on the transfer queue and transfers the
+		 * ownership of the filled buffers to the graphics queue.
+		 *
+		 * @return Submission token of the copies or zero if nothing was pending
+		 */
+		uint64_t flushStagingBuffer();
+
+		/**
+		 * @brief Returns the size of the staging buffer in bytes.
+		 *
+		 * @return Size of the staging buffer
+		 */
+		[[nodiscard]] size_t getStagingBufferSize() const;
+
+		/**
+		 * @brief Returns the Vulkan buffer handle of the staging buffer.
+		 *
+		 * @return Vulkan buffer handle
+		 */
+		[[nodiscard]] vk::Buffer getStagingBuffer() const;
+
+		/**
+		 * @brief Copies data into a newly allocated range of the staging
+		 * buffer which stays in use until the next flush has been retired.
+		 *
+		 * This may flush previously pending uploads, so it needs to be called
+		 * before requesting the upload streams.
+		 *
+		 * @param[in] data Pointer to data
+		 * @param[in] size Size of data in bytes
+		 * @param[in] alignment Alignment of the range in bytes
+		 * @return Offset of the range in the staging buffer
+		 */
+		size_t stageData(const void* data, size_t size, size_t alignment);
+
+		/**
+		 * @brief Returns the command stream on the transfer queue which
+		 * records pending uploads until the next flush.
+		 *
+		 * @return Command stream handle
+		 */
+		const CommandStreamHandle &getStagingStream();
+
+		/**
+		 * @brief Returns the command stream on the graphics queue which
+		 * executes after all pending uploads have finished. It can be used
+		 * to acquire ownership of uploaded resources or to generate mip chains.
+		 *
+		 * @return Command stream handle
+		 */
+		const CommandStreamHandle &getAcquireStream();
+
+		/**
+		 * @brief Sets a debug label as name of the memory allocation of a
+		 * buffer represented by a given buffer handle, so its memory gets
+		 * accounted per label.
+		 *
+		 * @param[in] handle Buffer handle
+		 * @param[in] label Debug label
+		 */
+		void setDebugLabel(const BufferHandle &handle, const std::string &label);
+
+		/**
+		 * @brief Adds the memory used by all buffers to given memory
+		 * statistics per buffer type and debug label.
+		 *
+		 * @param[in,out] statistics Memory statistics
+		 */
+		void appendMemoryStatistics(MemoryStatistics &statistics) const;
+
 		/**
 		 * @brief Records a memory barrier for a buffer,
 		 * synchronizing subsequent accesses to buffer data
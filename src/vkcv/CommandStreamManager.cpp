@@ -7,30 +7,115 @@
 
 namespace vkcv {
 
+	bool CommandStreamManager::init(Core &core) {
+		if (!HandleManager<CommandStreamEntry, CommandStreamHandle>::init(core)) {
+			return false;
+		}
+
+		const auto &featureManager = getCore().getContext().getFeatureManager();
+
+		m_timelineSemaphores = (
+			featureManager.checkFeatures<vk::PhysicalDeviceTimelineSemaphoreFeatures>(
+				vk::StructureType::ePhysicalDeviceTimelineSemaphoreFeatures,
+				[](const vk::PhysicalDeviceTimelineSemaphoreFeatures &features) {
+					return features.timelineSemaphore;
+				}
+			) ||
+			featureManager.checkFeatures<vk::PhysicalDeviceVulkan12Features>(
+				vk::StructureType::ePhysicalDeviceVulkan12Features,
+				[](const vk::PhysicalDeviceVulkan12Features &features) {
+					return features.timelineSemaphore;
+				}
+			)
+		);
+
+		if (!m_timelineSemaphores) {
+			vkcv_log(LogLevel::WARNING,
+					 "Timeline semaphores are not supported, using fences instead");
+		}
+
+		return true;
+	}
+
 	uint64_t CommandStreamManager::getIdFrom(const CommandStreamHandle &handle) const {
 		return handle.getId();
 	}
 
 	CommandStreamHandle CommandStreamManager::createById(uint64_t id,
-														 const HandleDestroyFunction &destroy) {
-		return CommandStreamHandle(id, destroy);
+														 HandleCounter &counter) {
+		return CommandStreamHandle(id, counter, *this);
 	}
 
 	void CommandStreamManager::destroyById(uint64_t id) {
 		auto &stream = getById(id);
 
+		if (stream.submission > 0) {
+			// the command buffer is still in use, so it gets freed on retirement
+			stream.released = true;
+			return;
+		}
+
 		if (stream.cmdBuffer) {
 			getCore().getContext().getDevice().freeCommandBuffers(stream.cmdPool, stream.cmdBuffer);
 			stream.cmdBuffer = nullptr;
 			stream.callbacks.clear();
 		}
+
+		stream.released = false;
+	}
+
+	bool CommandStreamManager::isDestructionDeferred() const {
+		return false;
+	}
+
+	bool CommandStreamManager::isFreeById(uint64_t id) const {
+		return !(getById(id).cmdBuffer);
+	}
+
+	vk::Semaphore CommandStreamManager::getTimelineSemaphore(const vk::Queue &queue) {
+		const auto key = static_cast<VkQueue>(queue);
+		const auto it = m_timelines.find(key);
+
+		if (it != m_timelines.end()) {
+			return it->second;
+		}
+
+		const vk::SemaphoreTypeCreateInfo typeInfo(vk::SemaphoreType::eTimeline, 0);
+		const vk::SemaphoreCreateInfo createInfo({}, &typeInfo);
+
+		const vk::Semaphore timeline = getCore().getContext().getDevice().createSemaphore(
+			createInfo
+		);
+
+		m_timelines[key] = timeline;
+		return timeline;
 	}
 
 	CommandStreamManager::CommandStreamManager() noexcept :
-		HandleManager<CommandStreamEntry, CommandStreamHandle>() {}
+		HandleManager<CommandStreamEntry, CommandStreamHandle>(),
+		m_timelines(),
+		m_submissions(),
+		m_submissionCounter(0),
+		m_timelineSemaphores(false) {}
 
 	CommandStreamManager::~CommandStreamManager() noexcept {
+		for (const auto &submission : m_submissions) {
+			if (submission.fence) {
+				getCore().getContext().getDevice().destroyFence(submission.fence);
+			}
+
+			auto &stream = getById(submission.id);
+			stream.submission = 0;
+		}
+
+		m_submissions.clear();
 		clear();
+
+		for (const auto &timeline : m_timelines) {
+			getCore().getContext().getDevice().destroySemaphore(timeline.second);
+		}
+
+		m_timelines.clear();
 	}
 
 	CommandStreamHandle CommandStreamManager::createCommandStream(const vk::Queue &queue,
@@ -43,21 +128,7 @@ namespace vkcv {
 		const vk::CommandBufferBeginInfo beginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
 		cmdBuffer.begin(beginInfo);
 
-		for (uint64_t id = 0; id < getCount(); id++) {
-			auto &stream = getById(id);
-
-			if (!(stream.cmdBuffer)) {
-				stream.cmdBuffer = cmdBuffer;
-				stream.cmdPool = cmdPool;
-				stream.queue = queue;
-
-				return createById(id, [&](uint64_t id) {
-					destroyById(id);
-				});
-			}
-		}
-
-		return add({ cmdBuffer, cmdPool, queue, {} });
+		return add({ cmdBuffer, cmdPool, queue, {}, 0, false });
 	}
 
 	void CommandStreamManager::recordCommandsToStream(const CommandStreamHandle &handle,
@@ -73,33 +144,203 @@ namespace vkcv {
 	}
 
 	void CommandStreamManager::submitCommandStreamSynchronous(
+		const CommandStreamHandle &handle, Vector<vk::Semaphore> &waitSemaphores,
+		Vector<vk::Semaphore> &signalSemaphores) {
+		const uint64_t submission = submitCommandStreamAsynchronous(
+			handle, waitSemaphores, signalSemaphores
+		);
+
+		if (!waitForSubmission(submission)) {
+			getCore().getContext().getDevice().waitIdle();
+			retireCommandStreams();
+		}
+	}
+
+	uint64_t CommandStreamManager::submitCommandStreamAsynchronous(
 		const CommandStreamHandle &handle, Vector<vk::Semaphore> &waitSemaphores,
 		Vector<vk::Semaphore> &signalSemaphores) {
 		auto &stream = (*this) [handle];
+
+		if (stream.submission > 0) {
+			vkcv_log(LogLevel::ERROR, "Command stream has already been submitted");
+			return stream.submission;
+		}
+
 		stream.cmdBuffer.end();
 
-		const auto device = getCore().getContext().getDevice();
-		const vk::Fence waitFence = device.createFence({});
+		const auto &device = getCore().getContext().getDevice();
 
 		const Vector<vk::PipelineStageFlags> waitDstStageMasks(
 			waitSemaphores.size(), vk::PipelineStageFlagBits::eAllCommands);
 
-		const vk::SubmitInfo queueSubmitInfo(waitSemaphores, waitDstStageMasks, stream.cmdBuffer,
-											 signalSemaphores);
+		CommandStreamSubmission submission {
+			getIdFrom(handle), ++m_submissionCounter, nullptr, nullptr
+		};
+
+		if (m_timelineSemaphores) {
+			submission.timeline = getTimelineSemaphore(stream.queue);
+
+			Vector<vk::Semaphore> semaphores (signalSemaphores);
+			semaphores.push_back(submission.timeline);
+
+			const Vector<uint64_t> waitValues (waitSemaphores.size(), 0);
+			Vector<uint64_t> signalValues (semaphores.size(), 0);
+			signalValues.back() = submission.value;
+
+			const vk::TimelineSemaphoreSubmitInfo timelineInfo(waitValues, signalValues);
+			const vk::SubmitInfo queueSubmitInfo(waitSemaphores, waitDstStageMasks,
+												 stream.cmdBuffer, semaphores, &timelineInfo);
+
+			stream.queue.submit(queueSubmitInfo);
+		} else {
+			submission.fence = device.createFence({});
+
+			const vk::SubmitInfo queueSubmitInfo(waitSemaphores, waitDstStageMasks,
+												 stream.cmdBuffer, signalSemaphores);
+
+			stream.queue.submit(queueSubmitInfo, submission.fence);
+		}
+
+		stream.submission = submission.value;
+		m_submissions.push_back(submission);
+		return submission.value;
+	}
+
+	/**
+	 * @brief Checks whether a pending submission has been retired by the GPU.
+	 *
+	 * @param[in] device Vulkan device
+	 * @param[in] submission Pending submission
+	 * @return True, if the submission is finished, otherwise false
+	 */
+	static bool checkSubmission(const vk::Device &device,
+								const CommandStreamSubmission &submission) {
+		if (submission.fence) {
+			return (device.getFenceStatus(submission.fence) == vk::Result::eSuccess);
+		} else {
+			return (device.getSemaphoreCounterValue(submission.timeline) >= submission.value);
+		}
+	}
+
+	bool CommandStreamManager::isSubmissionFinished(uint64_t submission) {
+		retireCommandStreams();
+
+		for (const auto &pending : m_submissions) {
+			if (pending.value == submission) {
+				return false;
+			}
+		}
+
+		return (submission <= m_submissionCounter);
+	}
+
+	bool CommandStreamManager::waitForSubmission(uint64_t submission, uint64_t timeout) {
+		const auto &device = getCore().getContext().getDevice();
+
+		for (const auto &pending : m_submissions) {
+			if (pending.value != submission) {
+				continue;
+			}
+
+			vk::Result result;
+
+			if (pending.fence) {
+				result = device.waitForFences(pending.fence, true, timeout);
+			} else {
+				const vk::SemaphoreWaitInfo waitInfo({}, pending.timeline, pending.value);
+				result = device.waitSemaphores(waitInfo, timeout);
+			}
+
+			if (result == vk::Result::eTimeout) {
+				return false;
+			}
+
+			break;
+		}
+
+		retireCommandStreams();
+		return true;
+	}
+
+	void CommandStreamManager::waitForSubmissions(uint64_t submission) {
+		const auto &device = getCore().getContext().getDevice();
+
+		for (const auto &pending : m_submissions) {
+			if (pending.value > submission) {
+				continue;
+			}
+
+			vk::Result result;
+
+			if (pending.fence) {
+				result = device.waitForFences(pending.fence, true,
+											  std::numeric_limits<uint64_t>::max());
+			} else {
+				const vk::SemaphoreWaitInfo waitInfo({}, pending.timeline, pending.value);
+				result = device.waitSemaphores(waitInfo, std::numeric_limits<uint64_t>::max());
+			}
+
+			if (result == vk::Result::eTimeout) {
+				device.waitIdle();
+				break;
+			}
+		}
+
+		retireCommandStreams();
+	}
+
+	uint64_t CommandStreamManager::getLatestSubmission() const {
+		return m_submissionCounter;
+	}
+
+	bool CommandStreamManager::isCommandPoolInUse(const vk::CommandPool &cmdPool) const {
+		for (uint64_t id = 0; id < getCount(); id++) {
+			const auto &stream = getById(id);
+
+			if ((stream.cmdBuffer) && (stream.cmdPool == cmdPool)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
 
-		stream.queue.submit(queueSubmitInfo, waitFence);
-		
-		const auto result = device.waitForFences(waitFence, true, std::numeric_limits<uint64_t>::max());
-		
-		if (result == vk::Result::eTimeout) {
-			device.waitIdle();
+	void CommandStreamManager::retireCommandStreams() {
+		const auto &device = getCore().getContext().getDevice();
+		Vector<CommandStreamSubmission> finished;
+
+		for (size_t i = 0; i < m_submissions.size();) {
+			if (checkSubmission(device, m_submissions[i])) {
+				finished.push_back(m_submissions[i]);
+				m_submissions.erase(m_submissions.begin() + i);
+			} else {
+				i++;
+			}
 		}
 
-		device.destroyFence(waitFence);
-		stream.queue = nullptr;
+		for (const auto &submission : finished) {
+			if (submission.fence) {
+				device.destroyFence(submission.fence);
+			}
 
-		for (const auto &finishCallback : stream.callbacks) {
-			finishCallback();
+			Vector<FinishCommandFunction> callbacks;
+
+			{
+				auto &stream = getById(submission.id);
+				std::swap(callbacks, stream.callbacks);
+
+				stream.queue = nullptr;
+				stream.submission = 0;
+
+				if (stream.released) {
+					recycleById(submission.id);
+				}
+			}
+
+			// callbacks may create or submit further command streams
+			for (const auto &finishCallback : callbacks) {
+				finishCallback();
+			}
 		}
 	}
 
@@ -109,4 +350,4 @@ namespace vkcv {
 		return stream.cmdBuffer;
 	}
 
-} // namespace vkcv
\ No newline at end of file
+} // namespace vkcv
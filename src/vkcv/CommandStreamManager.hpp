@@ -1,5 +1,6 @@
 #pragma once
 
+#include <limits>
 #include <vulkan/vulkan.hpp>
 
 #include "vkcv/Container.hpp"
@@ -20,6 +21,19 @@ namespace vkcv {
 		vk::CommandPool cmdPool;
 		vk::Queue queue;
 		Vector<FinishCommandFunction> callbacks;
+		uint64_t submission;
+		bool released;
+	};
+
+	/**
+	 * @brief Represents one pending submission of a command stream which
+	 * has not been retired by the GPU yet.
+	 */
+	struct CommandStreamSubmission {
+		uint64_t id;
+		uint64_t value;
+		vk::Semaphore timeline;
+		vk::Fence fence;
 	};
 
 	/**
@@ -29,13 +43,45 @@ namespace vkcv {
 		friend class Core;
 
 	private:
+		Dictionary<VkQueue, vk::Semaphore> m_timelines;
+		Vector<CommandStreamSubmission> m_submissions;
+		uint64_t m_submissionCounter;
+		bool m_timelineSemaphores;
+
+		bool init(Core &core) override;
+
 		[[nodiscard]] uint64_t getIdFrom(const CommandStreamHandle &handle) const override;
 
 		[[nodiscard]] CommandStreamHandle createById(uint64_t id,
-													 const HandleDestroyFunction &destroy) override;
+													 HandleCounter &counter) override;
 
 		void destroyById(uint64_t id) override;
 
+		/**
+		 * @brief Command streams are released on retirement of their submission instead.
+		 *
+		 * @return False
+		 */
+		[[nodiscard]] bool isDestructionDeferred() const override;
+
+		/**
+		 * @brief Slots of command streams can only be reused after their
+		 * command buffer has been freed.
+		 *
+		 * @param id Command stream handle id
+		 * @return True, if the slot is free, otherwise false
+		 */
+		[[nodiscard]] bool isFreeById(uint64_t id) const override;
+
+		/**
+		 * @brief Returns the timeline semaphore used to track submissions
+		 * to a given queue, creating it on first use.
+		 *
+		 * @param queue Vulkan queue
+		 * @return Timeline semaphore of the queue
+		 */
+		vk::Semaphore getTimelineSemaphore(const vk::Queue &queue);
+
 	public:
 		CommandStreamManager() noexcept;
 
@@ -82,6 +128,68 @@ namespace vkcv {
 											Vector<vk::Semaphore> &waitSemaphores,
 											Vector<vk::Semaphore> &signalSemaphores);
 
+		/**
+		 * @brief Submits a #CommandStream to it's queue and returns immediately. The finish
+		 * callbacks of the stream are called once the GPU has retired the submitted work.
+		 *
+		 * @param handle Command stream handle
+		 * @param waitSemaphores Semaphores that are waited upon before executing the recorded
+		 * commands
+		 * @param signalSemaphores Semaphores that are signaled when execution of the recorded
+		 * commands is finished
+		 * @return Submission token to poll or wait for completion
+		 */
+		uint64_t submitCommandStreamAsynchronous(const CommandStreamHandle &handle,
+												 Vector<vk::Semaphore> &waitSemaphores,
+												 Vector<vk::Semaphore> &signalSemaphores);
+
+		/**
+		 * @brief Checks whether a submission has been retired by the GPU.
+		 *
+		 * @param submission Submission token
+		 * @return True, if the submission is finished, otherwise false
+		 */
+		bool isSubmissionFinished(uint64_t submission);
+
+		/**
+		 * @brief Waits for a submission to be retired by the GPU.
+		 *
+		 * @param submission Submission token
+		 * @param timeout Timeout in nanoseconds
+		 * @return True, if the submission is finished, otherwise false
+		 */
+		bool waitForSubmission(uint64_t submission,
+							   uint64_t timeout = std::numeric_limits<uint64_t>::max());
+
+		/**
+		 * @brief Waits for all submissions up to a given one to be retired by the GPU.
+		 *
+		 * @param submission Submission token
+		 */
+		void waitForSubmissions(uint64_t submission);
+
+		/**
+		 * @brief Returns the submission token of the latest submission.
+		 *
+		 * @return Latest submission token
+		 */
+		[[nodiscard]] uint64_t getLatestSubmission() const;
+
+		/**
+		 * @brief Checks whether any command stream still uses a command buffer
+		 * allocated from a given command pool.
+		 *
+		 * @param cmdPool Command pool
+		 * @return True, if the command pool is in use, otherwise false
+		 */
+		[[nodiscard]] bool isCommandPoolInUse(const vk::CommandPool &cmdPool) const;
+
+		/**
+		 * @brief Checks all pending submissions without blocking, calls the finish
+		 * callbacks of each retired command stream and releases its resources.
+		 */
+		void retireCommandStreams();
+
 		/**
 		 * @brief Returns the underlying vulkan handle of a #CommandStream to be used for manual
 		 * command recording
@@ -92,4 +200,4 @@ namespace vkcv {
 		vk::CommandBuffer getStreamCommandBuffer(const CommandStreamHandle &handle);
 	};
 
-} // namespace vkcv
\ No newline at end of file
+} // namespace vkcv
@@ -9,8 +9,8 @@ namespace vkcv {
 	}
 
 	ComputePipelineHandle ComputePipelineManager::createById(uint64_t id,
-															 const HandleDestroyFunction &destroy) {
-		return ComputePipelineHandle(id, destroy);
+															 HandleCounter &counter) {
+		return ComputePipelineHandle(id, counter, *this);
 	}
 
 	void ComputePipelineManager::destroyById(uint64_t id) {
@@ -89,7 +89,7 @@ namespace vkcv {
 
 		vk::Pipeline vkPipeline;
 		if (getCore().getContext().getDevice().createComputePipelines(
-				nullptr, 1, &computePipelineCreateInfo, nullptr, &vkPipeline)
+				getCore().getPipelineCache(), 1, &computePipelineCreateInfo, nullptr, &vkPipeline)
 			!= vk::Result::eSuccess) {
 			getCore().getContext().getDevice().destroy(computeModule);
 			return ComputePipelineHandle();
@@ -30,7 +30,7 @@ namespace vkcv {
 		[[nodiscard]] uint64_t getIdFrom(const ComputePipelineHandle &handle) const override;
 
 		[[nodiscard]] ComputePipelineHandle
-		createById(uint64_t id, const HandleDestroyFunction &destroy) override;
+		createById(uint64_t id, HandleCounter &counter) override;
 
 		/**
 		 * Destroys and deallocates compute pipeline represented by a given
@@ -431,6 +431,40 @@ namespace vkcv {
 			feature(featureManager);
 		}
 
+		// timeline semaphores track asynchronous submissions if the device supports them,
+		// otherwise the command streams fall back to one fence per submission
+		vk::PhysicalDeviceTimelineSemaphoreFeatures timelineSemaphoreFeatures;
+		vk::PhysicalDeviceFeatures2 deviceFeatures;
+		deviceFeatures.setPNext(&timelineSemaphoreFeatures);
+		physicalDevice.getFeatures2(&deviceFeatures);
+
+		if (timelineSemaphoreFeatures.timelineSemaphore) {
+			// the core features of Vulkan 1.2 can't be combined with the separate structure
+			if (featureManager.checkFeatures<vk::PhysicalDeviceVulkan12Features>(
+					vk::StructureType::ePhysicalDeviceVulkan12Features,
+					[](const vk::PhysicalDeviceVulkan12Features &features) {
+						return true;
+					})) {
+				featureManager.useFeatures<vk::PhysicalDeviceVulkan12Features>(
+					[](vk::PhysicalDeviceVulkan12Features &features) {
+						features.setTimelineSemaphore(true);
+					}, false);
+			} else if ((physicalDevice.getProperties().apiVersion >= VK_API_VERSION_1_2) ||
+					   (featureManager.useExtension(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME,
+													false))) {
+				featureManager.useFeatures<vk::PhysicalDeviceTimelineSemaphoreFeatures>(
+					[](vk::PhysicalDeviceTimelineSemaphoreFeatures &features) {
+						features.setTimelineSemaphore(true);
+					}, false);
+			}
+		}
+
+		// memory budgets are optional to report the memory usage per heap
+		const bool memoryBudget = (
+			(featureManager.isExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)) &&
+			(featureManager.useExtension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME, false))
+		);
+
 		const auto &extensions = featureManager.getActiveExtensions();
 
 		Vector<vk::DeviceQueueCreateInfo> qCreateInfos;
@@ -483,6 +517,10 @@ namespace vkcv {
 			vmaFlags |= vma::AllocatorCreateFlagBits::eBufferDeviceAddress;
 		}
 		
+		if (memoryBudget) {
+			vmaFlags |= vma::AllocatorCreateFlagBits::eExtMemoryBudget;
+		}
+		
 		const vma::AllocatorCreateInfo allocatorCreateInfo(
 				vmaFlags,
 				physicalDevice,
@@ -5,9 +5,14 @@
  */
 
 #include <GLFW/glfw3.h>
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <limits>
+#include <numeric>
+#include <thread>
+#include <tuple>
 #include <vkcv/Logger.hpp>
 
 #include "AccelerationStructureManager.hpp"
@@ -22,10 +27,12 @@
 #include "RayTracingPipelineManager.hpp"
 #include "SamplerManager.hpp"
 #include "WindowManager.hpp"
+#include "WorkerPool.hpp"
 
 #include "vkcv/BlitDownsampler.hpp"
 #include "vkcv/Container.hpp"
 #include "vkcv/Core.hpp"
+#include "vkcv/File.hpp"
 #include "vkcv/Image.hpp"
 #include "vkcv/Logger.hpp"
 
@@ -80,21 +87,183 @@ namespace vkcv {
 		return commandPoolsPerQueueFamily;
 	}
 
+	static const char* PIPELINE_CACHE_FILENAME = "pipeline_cache.bin";
+
+	/**
+	 * @brief Returns the default directory to load and save the pipeline cache.
+	 *
+	 * @return Default cache directory or an empty path if unavailable
+	 */
+	static std::filesystem::path getDefaultPipelineCacheDirectory() {
+		std::error_code error;
+		const std::filesystem::path directory = std::filesystem::temp_directory_path(error);
+
+		if (error) {
+			return {};
+		}
+
+		return directory / "vkcv_pipeline_cache";
+	}
+
+	/**
+	 * @brief Minimum amount of drawcalls per secondary command buffer to
+	 * outweigh the overhead of recording in parallel.
+	 */
+	constexpr size_t PARALLEL_RECORDING_MIN_DRAWCALLS = 256;
+
+	/**
+	 * @brief Checks whether serialized pipeline cache data has been created
+	 * by a device and driver matching the given physical device properties.
+	 *
+	 * @param[in] data Serialized pipeline cache data
+	 * @param[in] properties Physical device properties
+	 * @return True if the data is compatible, otherwise false
+	 */
+	static bool isPipelineCacheCompatible(const Vector<char> &data,
+										  const vk::PhysicalDeviceProperties &properties) {
+		// header layout of VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+		uint32_t header [4];
+		const size_t headerSize = sizeof(header) + VK_UUID_SIZE;
+
+		if (data.size() < headerSize) {
+			return false;
+		}
+
+		memcpy(header, data.data(), sizeof(header));
+
+		if ((header [0] < headerSize) ||
+			(header [1] != static_cast<uint32_t>(vk::PipelineCacheHeaderVersion::eOne)) ||
+			(header [2] != properties.vendorID) || (header [3] != properties.deviceID)) {
+			return false;
+		}
+
+		// the cache UUID changes with any driver update invalidating the data
+		return (0 == memcmp(data.data() + sizeof(header), properties.pipelineCacheUUID.data(),
+							VK_UUID_SIZE));
+	}
+
 	Core Core::create(const std::string &applicationName, uint32_t applicationVersion,
 					  const Vector<vk::QueueFlagBits> &queueFlags, const Features &features,
-					  const Vector<const char*> &instanceExtensions) {
+					  const Vector<const char*> &instanceExtensions, uint32_t framesInFlight) {
 		Context context = Context::create(applicationName, applicationVersion, queueFlags, features,
 										  instanceExtensions);
 
-		return Core(std::move(context));
+		return Core(std::move(context), framesInFlight);
 	}
 
 	const Context &Core::getContext() const {
 		return m_Context;
 	}
 
-	Core::Core(Context &&context) noexcept :
+	uint32_t Core::getFramesInFlight() const {
+		return static_cast<uint32_t>(m_Frames.size());
+	}
+
+	uint32_t Core::getCurrentFrameInFlight() const {
+		return m_currentFrameIndex;
+	}
+
+	const vk::PipelineCache &Core::getPipelineCache() const {
+		return m_PipelineCache;
+	}
+
+	bool Core::setPipelineCacheDirectory(const std::filesystem::path &directory) {
+		std::error_code error;
+		std::filesystem::create_directories(directory, error);
+
+		if (error) {
+			vkcv_log(LogLevel::ERROR, "The cache directory could not be created (%s)",
+					 directory.string().c_str());
+			return false;
+		}
+
+		m_PipelineCacheDirectory = directory;
+
+		const std::filesystem::path path = directory / PIPELINE_CACHE_FILENAME;
+
+		if (!std::filesystem::exists(path)) {
+			return true;
+		}
+
+		Vector<char> data;
+		if (!readContentFromFile(path, data)) {
+			return false;
+		}
+
+		if (!isPipelineCacheCompatible(data, m_Context.getPhysicalDevice().getProperties())) {
+			vkcv_log(LogLevel::WARNING, "Pipeline cache does not match device or driver (%s)",
+					 path.string().c_str());
+			return true;
+		}
+
+		const vk::Device &device = m_Context.getDevice();
+		const vk::PipelineCacheCreateInfo cacheCreateInfo({}, data.size(), data.data());
+
+		vk::PipelineCache cache;
+		if (device.createPipelineCache(&cacheCreateInfo, nullptr, &cache)
+			!= vk::Result::eSuccess) {
+			vkcv_log(LogLevel::WARNING, "Pipeline cache could not be loaded (%s)",
+					 path.string().c_str());
+			return true;
+		}
+
+		const vk::Result result = device.mergePipelineCaches(m_PipelineCache, 1, &cache);
+		device.destroyPipelineCache(cache);
+
+		return (result == vk::Result::eSuccess);
+	}
+
+	bool Core::savePipelineCache() const {
+		if ((!m_PipelineCache) || (m_PipelineCacheDirectory.empty())) {
+			return false;
+		}
+
+		const auto cacheData = m_Context.getDevice().getPipelineCacheData(m_PipelineCache);
+
+		if (cacheData.empty()) {
+			return false;
+		}
+
+		const std::filesystem::path path = m_PipelineCacheDirectory / PIPELINE_CACHE_FILENAME;
+		std::filesystem::path tmpPath = path;
+		tmpPath += ".tmp";
+
+		// write to a temporary file first to never leave a truncated cache behind
+		if (!writeContentToFile(tmpPath, Vector<char>(cacheData.begin(), cacheData.end()))) {
+			return false;
+		}
+
+		std::error_code error;
+		std::filesystem::rename(tmpPath, path, error);
+
+		if (error) {
+			vkcv_log(LogLevel::ERROR, "The pipeline cache could not be saved (%s)",
+					 path.string().c_str());
+			return false;
+		}
+
+		return true;
+	}
+
+	bool deferDestruction(Core &core, const FinishCommandFunction &destroy) {
+		// handles might be released from any thread
+		std::lock_guard<std::mutex> lock(core.m_FramesMutex);
+
+		if (core.m_Frames.empty()) {
+			return false;
+		}
+
+		core.m_Frames [core.m_currentFrameIndex].destructions.push_back(destroy);
+		return true;
+	}
+
+	Core::Core(Context &&context, uint32_t framesInFlight) noexcept :
 		m_Context(std::move(context)),
+		m_Frames(),
+		m_currentFrameIndex(0),
+		m_FramesMutex(),
+		m_PipelineCache(),
+		m_PipelineCacheDirectory(),
 		m_DescriptorSetLayoutManager(std::make_unique<DescriptorSetLayoutManager>()),
 		m_DescriptorSetManager(std::make_unique<DescriptorSetManager>()),
 		m_BufferManager(std::make_unique<BufferManager>()),
@@ -108,26 +277,44 @@ namespace vkcv {
 		m_GraphicsPipelineManager(std::make_unique<GraphicsPipelineManager>()),
 		m_ComputePipelineManager(std::make_unique<ComputePipelineManager>()),
 		m_RayTracingPipelineManager(std::make_unique<RayTracingPipelineManager>()),
-		m_CommandPools(),
-		m_RenderFinished(),
+		m_RecordingWorkers(nullptr),
+		m_CreationWorkers(nullptr),
+		m_CreationWorkersFlag(),
+		m_DrawcallSorting(false),
+		m_DrawcallStatistics(),
 		m_SwapchainImagesAcquired(),
 		m_currentSwapchainImageIndex(std::numeric_limits<uint32_t>::max()),
 		m_currentSwapchainSemaphoreIndex(0),
 		m_downsampler(nullptr) {
-		m_CommandPools = createCommandPools(
-			m_Context.getDevice(), generateQueueFamilyIndexSet(m_Context.getQueueManager()));
+		const Set<int> familyIndexSet = generateQueueFamilyIndexSet(m_Context.getQueueManager());
+
+		m_Frames.resize(std::max<uint32_t>(framesInFlight, 1));
+
+		for (auto &frame : m_Frames) {
+			frame.commandPools = createCommandPools(m_Context.getDevice(), familyIndexSet);
+			frame.renderFinished = m_Context.getDevice().createSemaphore({});
+			frame.renderingSignaled = false;
+			frame.submission = 0;
+		}
+
+		m_PipelineCache = m_Context.getDevice().createPipelineCache({});
+
+		// pipelines get compiled from the cache of previous runs by default
+		const std::filesystem::path cacheDirectory = getDefaultPipelineCacheDirectory();
 
-		m_RenderFinished = m_Context.getDevice().createSemaphore({});
+		if (!cacheDirectory.empty()) {
+			setPipelineCacheDirectory(cacheDirectory);
+		}
 
 		m_DescriptorSetLayoutManager->init(*this);
 		m_DescriptorSetManager->init(*this, *m_DescriptorSetLayoutManager);
-		m_BufferManager->init(*this);
+		m_BufferManager->init(*this, *m_CommandStreamManager);
 		m_SamplerManager->init(*this);
 		m_ImageManager->init(*this, *m_BufferManager);
 		m_AccelerationStructureManager->init(*this, *m_BufferManager);
 		m_CommandStreamManager->init(*this);
 		m_SwapchainManager->init(*this);
-		m_PassManager->init(*this);
+		m_PassManager->init(*this, *m_ImageManager);
 		m_GraphicsPipelineManager->init(*this);
 		m_ComputePipelineManager->init(*this);
 		m_RayTracingPipelineManager->init(*this);
@@ -135,17 +322,66 @@ namespace vkcv {
 	}
 
 	Core::~Core() noexcept {
+		m_BufferManager->flushStagingBuffer();
 		m_Context.getDevice().waitIdle();
+		m_CommandStreamManager->retireCommandStreams();
+
+		for (auto &frame : m_Frames) {
+			for (const auto &destroy : frame.destructions) {
+				destroy();
+			}
 
-		for (const vk::CommandPool &pool : m_CommandPools) {
-			m_Context.getDevice().destroyCommandPool(pool);
+			frame.destructions.clear();
 		}
 
-		m_Context.getDevice().destroySemaphore(m_RenderFinished);
+		// resources released from here on get destroyed immediately
+		Vector<FrameInFlight> frames;
+		std::swap(frames, m_Frames);
+
+		for (const auto &frame : frames) {
+			for (const vk::CommandPool &pool : frame.commandPools) {
+				m_Context.getDevice().destroyCommandPool(pool);
+			}
+
+			for (const auto &secondaryPool : frame.secondaryCommandPools) {
+				m_Context.getDevice().destroyCommandPool(secondaryPool.commandPool);
+			}
+
+			m_Context.getDevice().destroySemaphore(frame.renderFinished);
+		}
 
 		for (auto& semaphore : m_SwapchainImagesAcquired) {
 			m_Context.getDevice().destroySemaphore(semaphore);
 		}
+
+		savePipelineCache();
+		m_Context.getDevice().destroyPipelineCache(m_PipelineCache);
+	}
+
+	/**
+	 * @brief Creates a handle for each config of a given list via a creation
+	 * function distributed across a pool of worker threads, including the
+	 * calling thread.
+	 *
+	 * @tparam H Handle type
+	 * @tparam C Config type
+	 * @param[in,out] workers Worker pool
+	 * @param[in] configs Configs
+	 * @param[in] create Creation function
+	 * @return Handles in order of their configs
+	 */
+	template <typename H, typename C>
+	static Vector<H> createInParallel(WorkerPool &workers,
+									  const Vector<C> &configs,
+									  const std::function<H(const C &)> &create) {
+		Vector<H> handles;
+		handles.resize(configs.size());
+
+		workers.run(configs.size(), [&](size_t index) {
+			handles [index] = create(configs [index]);
+		});
+
+		return handles;
 	}
 
 	GraphicsPipelineHandle Core::createGraphicsPipeline(const GraphicsPipelineConfig &config) {
@@ -165,6 +401,22 @@ namespace vkcv {
 
 		return m_ComputePipelineManager->createComputePipeline(config.getShaderProgram(), layouts);
 	}
+
+	Vector<GraphicsPipelineHandle>
+	Core::createGraphicsPipelines(const Vector<GraphicsPipelineConfig> &configs) {
+		return createInParallel<GraphicsPipelineHandle, GraphicsPipelineConfig>(
+			getCreationWorkers(), configs, [this](const GraphicsPipelineConfig &config) {
+				return createGraphicsPipeline(config);
+			});
+	}
+
+	Vector<ComputePipelineHandle>
+	Core::createComputePipelines(const Vector<ComputePipelineConfig> &configs) {
+		return createInParallel<ComputePipelineHandle, ComputePipelineConfig>(
+			getCreationWorkers(), configs, [this](const ComputePipelineConfig &config) {
+				return createComputePipeline(config);
+			});
+	}
 	
 	RayTracingPipelineHandle Core::createRayTracingPipeline(
 			const vkcv::RayTracingPipelineConfig &config) {
@@ -192,6 +444,11 @@ namespace vkcv {
 		return m_BufferManager->createBuffer(TypeGuard(1), type, memoryType, size, readable);
 	}
 
+	BufferRange Core::allocateBufferRange(BufferType type, size_t size, size_t alignment,
+										  BufferMemoryType memoryType) {
+		return m_BufferManager->allocateBufferRange(type, memoryType, size, alignment);
+	}
+
 	vk::Buffer Core::getBuffer(const BufferHandle &buffer) const {
 		return m_BufferManager->getBuffer(buffer);
 	}
@@ -267,7 +524,174 @@ namespace vkcv {
 		return Result::SUCCESS;
 	}
 
+	void Core::advanceFrameInFlight() {
+		m_BufferManager->flushStagingBuffer();
+
+		m_Frames [m_currentFrameIndex].submission = m_CommandStreamManager->getLatestSubmission();
+
+		{
+			std::lock_guard<std::mutex> lock(m_FramesMutex);
+			m_currentFrameIndex = (m_currentFrameIndex + 1) % m_Frames.size();
+		}
+
+		auto &frame = m_Frames [m_currentFrameIndex];
+		m_CommandStreamManager->waitForSubmissions(frame.submission);
+
+		Vector<FinishCommandFunction> destructions;
+
+		{
+			std::lock_guard<std::mutex> lock(m_FramesMutex);
+			std::swap(destructions, frame.destructions);
+		}
+
+		for (const auto &destroy : destructions) {
+			destroy();
+		}
+
+		bool poolsInUse = false;
+
+		for (const vk::CommandPool &pool : frame.commandPools) {
+			if (!pool) {
+				continue;
+			}
+
+			if (m_CommandStreamManager->isCommandPoolInUse(pool)) {
+				poolsInUse = true;
+			} else {
+				m_Context.getDevice().resetCommandPool(pool);
+			}
+		}
+
+		// secondary command buffers might still be referenced by pending streams
+		if (poolsInUse) {
+			return;
+		}
+
+		for (auto &secondaryPool : frame.secondaryCommandPools) {
+			if (secondaryPool.usedCommandBuffers > 0) {
+				m_Context.getDevice().resetCommandPool(secondaryPool.commandPool);
+				secondaryPool.usedCommandBuffers = 0;
+			}
+		}
+	}
+
+	Vector<vk::CommandBuffer> Core::getSecondaryCommandBuffers(size_t count) {
+		const vk::Device &device = m_Context.getDevice();
+		const uint32_t familyIndex =
+			m_Context.getQueueManager().getGraphicsQueues().front().familyIndex;
+
+		auto &frame = m_Frames [m_currentFrameIndex];
+
+		while (frame.secondaryCommandPools.size() < count) {
+			const vk::CommandPoolCreateInfo poolCreateInfo(
+				vk::CommandPoolCreateFlagBits::eTransient, familyIndex);
+
+			frame.secondaryCommandPools.push_back(
+				{ device.createCommandPool(poolCreateInfo), {}, 0 });
+		}
+
+		Vector<vk::CommandBuffer> cmdBuffers;
+		cmdBuffers.reserve(count);
+
+		for (size_t i = 0; i < count; i++) {
+			auto &secondaryPool = frame.secondaryCommandPools [i];
+
+			if (secondaryPool.usedCommandBuffers >= secondaryPool.commandBuffers.size()) {
+				const vk::CommandBufferAllocateInfo allocateInfo(
+					secondaryPool.commandPool, vk::CommandBufferLevel::eSecondary, 1);
+
+				secondaryPool.commandBuffers.push_back(
+					device.allocateCommandBuffers(allocateInfo).front());
+			}
+
+			cmdBuffers.push_back(
+				secondaryPool.commandBuffers [secondaryPool.usedCommandBuffers++]);
+		}
+
+		return cmdBuffers;
+	}
+
+	WorkerPool &Core::getCreationWorkers() {
+		std::call_once(m_CreationWorkersFlag, [this]() {
+			m_CreationWorkers = std::make_unique<WorkerPool>(
+				std::max<size_t>(std::thread::hardware_concurrency(), 1));
+		});
+
+		return *m_CreationWorkers;
+	}
+
+	void Core::setRecordingThreadCount(uint32_t threadCount) {
+		if (threadCount > 1) {
+			m_RecordingWorkers = std::make_unique<WorkerPool>(threadCount);
+		} else {
+			m_RecordingWorkers = nullptr;
+		}
+	}
+
+	void Core::setDrawcallSorting(bool sorting) {
+		m_DrawcallSorting = sorting;
+	}
+
+	bool Core::isDrawcallSorting() const {
+		return m_DrawcallSorting;
+	}
+
+	const DrawcallStatistics &Core::getDrawcallStatistics() const {
+		return m_DrawcallStatistics;
+	}
+
+	void Core::resetDrawcallStatistics() {
+		m_DrawcallStatistics = DrawcallStatistics();
+	}
+
+	MemoryStatistics Core::getMemoryStatistics() const {
+		MemoryStatistics statistics {};
+
+		statistics.budgetSupported = m_Context.getFeatureManager().isExtensionActive(
+			VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+		const vma::Allocator &allocator = m_Context.getAllocator();
+		const vk::PhysicalDeviceMemoryProperties memoryProperties =
+			m_Context.getPhysicalDevice().getMemoryProperties();
+
+		Vector<vma::Budget> budgets;
+		budgets.resize(memoryProperties.memoryHeapCount);
+		allocator.getHeapBudgets(budgets.data());
+
+		statistics.heaps.reserve(budgets.size());
+
+		for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+			const vk::MemoryHeap &heap = memoryProperties.memoryHeaps [i];
+			const vma::Budget &budget = budgets [i];
+
+			statistics.heaps.push_back({
+				static_cast<bool>(heap.flags & vk::MemoryHeapFlagBits::eDeviceLocal),
+				static_cast<size_t>(heap.size),
+				static_cast<size_t>(budget.usage),
+				static_cast<size_t>(budget.budget),
+				static_cast<size_t>(budget.statistics.blockBytes),
+				static_cast<size_t>(budget.statistics.allocationBytes),
+				static_cast<size_t>(budget.statistics.blockCount),
+				static_cast<size_t>(budget.statistics.allocationCount)
+			});
+		}
+
+		m_BufferManager->appendMemoryStatistics(statistics);
+		m_ImageManager->appendMemoryStatistics(statistics);
+		return statistics;
+	}
+
+	uint32_t Core::getRecordingThreadCount() const {
+		if (!m_RecordingWorkers) {
+			return 1;
+		}
+
+		return static_cast<uint32_t>(m_RecordingWorkers->getThreadCount());
+	}
+
 	bool Core::beginFrame(uint32_t &width, uint32_t &height, const WindowHandle &windowHandle) {
+		advanceFrameInFlight();
+
 		const Window &window = m_WindowManager->getWindow(windowHandle);
 		const SwapchainHandle swapchainHandle = window.getSwapchain();
 
@@ -338,24 +762,6 @@ namespace vkcv {
 		return widthHeight;
 	}
 
-	static vk::Framebuffer createFramebuffer(const Vector<ImageHandle> &renderTargets,
-											 const ImageManager &imageManager,
-											 const vk::Extent2D &renderExtent,
-											 const vk::RenderPass &renderpass,
-											 const vk::Device &device) {
-
-		Vector<vk::ImageView> attachmentsViews;
-		for (const ImageHandle &handle : renderTargets) {
-			attachmentsViews.push_back(imageManager.getVulkanImageView(handle));
-		}
-
-		const vk::FramebufferCreateInfo createInfo(
-			{}, renderpass, static_cast<uint32_t>(attachmentsViews.size()), attachmentsViews.data(),
-			renderExtent.width, renderExtent.height, 1);
-
-		return device.createFramebuffer(createInfo);
-	}
-
 	void transitionRendertargetsToAttachmentLayout(const Vector<ImageHandle> &renderTargets,
 												   ImageManager &imageManager,
 												   const vk::CommandBuffer cmdBuffer) {
@@ -404,31 +810,88 @@ namespace vkcv {
 		}
 	}
 
+	/**
+	 * @brief Structure to track the state bound in a command buffer while
+	 * recording drawcalls, so redundant binds can be skipped.
+	 */
+	struct DrawcallBindState {
+		Vector<vk::Buffer> vertexBuffers;
+		Vector<vk::DeviceSize> vertexOffsets;
+		Vector<vk::DescriptorSet> descriptorSets;
+		Vector<Vector<uint32_t>> dynamicOffsets;
+		vk::Buffer indexBuffer;
+		vk::DeviceSize indexOffset;
+		vk::IndexType indexType;
+		DrawcallStatistics statistics;
+	};
+
+	static void accumulateDrawcallStatistics(DrawcallStatistics &total,
+											 const DrawcallStatistics &statistics) {
+		total.drawcalls += statistics.drawcalls;
+		total.vertexBufferBinds += statistics.vertexBufferBinds;
+		total.vertexBufferBindsSkipped += statistics.vertexBufferBindsSkipped;
+		total.descriptorSetBinds += statistics.descriptorSetBinds;
+		total.descriptorSetBindsSkipped += statistics.descriptorSetBindsSkipped;
+		total.indexBufferBinds += statistics.indexBufferBinds;
+		total.indexBufferBindsSkipped += statistics.indexBufferBindsSkipped;
+	}
+
 	static void recordDrawcall(const DescriptorSetManager &descriptorSetManager,
 							   const BufferManager &bufferManager, const InstanceDrawcall &drawcall,
 							   vk::CommandBuffer cmdBuffer, vk::PipelineLayout pipelineLayout,
-							   const PushConstants &pushConstants, size_t drawcallIndex) {
+							   const PushConstants &pushConstants, size_t drawcallIndex,
+							   DrawcallBindState &state) {
 
 		const auto &vertexData = drawcall.getVertexData();
+		const auto &vertexBindings = vertexData.getVertexBufferBindings();
 
-		for (uint32_t i = 0; i < vertexData.getVertexBufferBindings().size(); i++) {
-			const auto &vertexBinding = vertexData.getVertexBufferBindings() [i];
+		if (state.vertexBuffers.size() < vertexBindings.size()) {
+			state.vertexBuffers.resize(vertexBindings.size());
+			state.vertexOffsets.resize(vertexBindings.size());
+		}
 
-			cmdBuffer.bindVertexBuffers(
-					i,
-					bufferManager.getBuffer(vertexBinding.m_buffer),
-					vertexBinding.m_offset
-			);
+		for (uint32_t i = 0; i < vertexBindings.size(); i++) {
+			const vk::Buffer buffer = bufferManager.getBuffer(vertexBindings [i].m_buffer);
+			const vk::DeviceSize offset = vertexBindings [i].m_offset;
+
+			if ((state.vertexBuffers [i] == buffer) && (state.vertexOffsets [i] == offset)) {
+				state.statistics.vertexBufferBindsSkipped++;
+				continue;
+			}
+
+			cmdBuffer.bindVertexBuffers(i, buffer, offset);
+
+			state.vertexBuffers [i] = buffer;
+			state.vertexOffsets [i] = offset;
+			state.statistics.vertexBufferBinds++;
 		}
 
 		for (const auto &usage : drawcall.getDescriptorSetUsages()) {
+			const vk::DescriptorSet descriptorSet =
+				descriptorSetManager.getDescriptorSet(usage.descriptorSet).vulkanHandle;
+
+			if (state.descriptorSets.size() <= usage.location) {
+				state.descriptorSets.resize(usage.location + 1);
+				state.dynamicOffsets.resize(usage.location + 1);
+			}
+
+			if ((state.descriptorSets [usage.location] == descriptorSet) &&
+				(state.dynamicOffsets [usage.location] == usage.dynamicOffsets)) {
+				state.statistics.descriptorSetBindsSkipped++;
+				continue;
+			}
+
 			cmdBuffer.bindDescriptorSets(
 				vk::PipelineBindPoint::eGraphics,
 				pipelineLayout,
 				usage.location,
-				descriptorSetManager.getDescriptorSet(usage.descriptorSet).vulkanHandle,
+				descriptorSet,
 				usage.dynamicOffsets
 			);
+
+			state.descriptorSets [usage.location] = descriptorSet;
+			state.dynamicOffsets [usage.location] = usage.dynamicOffsets;
+			state.statistics.descriptorSetBinds++;
 		}
 
 		if (pushConstants.getSizePerDrawcall() > 0) {
@@ -437,9 +900,24 @@ namespace vkcv {
 									pushConstants.getDrawcallData(drawcallIndex));
 		}
 
+		state.statistics.drawcalls++;
+
 		if (vertexData.getIndexBuffer()) {
-			cmdBuffer.bindIndexBuffer(bufferManager.getBuffer(vertexData.getIndexBuffer()), 0,
-									  getIndexType(vertexData.getIndexBitCount()));
+			const vk::Buffer indexBuffer = bufferManager.getBuffer(vertexData.getIndexBuffer());
+			const vk::DeviceSize indexOffset = vertexData.getIndexOffset();
+			const vk::IndexType indexType = getIndexType(vertexData.getIndexBitCount());
+
+			if ((state.indexBuffer == indexBuffer) && (state.indexOffset == indexOffset) &&
+				(state.indexType == indexType)) {
+				state.statistics.indexBufferBindsSkipped++;
+			} else {
+				cmdBuffer.bindIndexBuffer(indexBuffer, indexOffset, indexType);
+
+				state.indexBuffer = indexBuffer;
+				state.indexOffset = indexOffset;
+				state.indexType = indexType;
+				state.statistics.indexBufferBinds++;
+			}
 
 			cmdBuffer.drawIndexed(vertexData.getCount(), drawcall.getInstanceCount(), 0, 0, {});
 		} else {
@@ -447,6 +925,15 @@ namespace vkcv {
 		}
 	}
 
+	/**
+	 * @brief Function to record commands into secondary command buffers which
+	 * get executed inside a render pass. The given function needs to be called
+	 * first on each secondary command buffer to begin its recording with the
+	 * state of the render pass.
+	 */
+	typedef std::function<Vector<vk::CommandBuffer>(const RecordCommandFunction &)>
+		RecordSecondaryCommandFunction;
+
 	static void recordGraphicsPipeline(Core &core, CommandStreamManager &cmdStreamManager,
 									   GraphicsPipelineManager &pipelineManager,
 									   PassManager &passManager, ImageManager &imageManager,
@@ -455,7 +942,8 @@ namespace vkcv {
 									   const PushConstants &pushConstants,
 									   const Vector<ImageHandle> &renderTargets,
 									   const WindowHandle &windowHandle,
-									   const RecordCommandFunction &record) {
+									   const RecordCommandFunction &record,
+									   const RecordSecondaryCommandFunction &recordSecondary = nullptr) {
 
 		const SwapchainHandle swapchainHandle = core.getWindow(windowHandle).getSwapchain();
 
@@ -489,44 +977,162 @@ namespace vkcv {
 													 cmdBuffer);
 		}
 
-		const vk::Framebuffer framebuffer =
-			createFramebuffer(renderTargets, imageManager, renderArea.extent, renderPass,
-							  core.getContext().getDevice());
+		const bool dynamicRendering = passManager.isDynamicRendering(passHandle);
+		vk::Framebuffer framebuffer = nullptr;
 
-		if (!framebuffer) {
-			vkcv_log(LogLevel::ERROR, "Failed to create temporary framebuffer");
-			return;
+		if (!dynamicRendering) {
+			framebuffer = imageManager.getFramebuffer(renderTargets, renderArea.extent, renderPass);
+
+			if (!framebuffer) {
+				vkcv_log(LogLevel::ERROR, "Failed to create framebuffer");
+				return;
+			}
 		}
 
+		const auto &dispatchLoader = core.getContext().getDispatchLoaderDynamic();
+		const bool viewportDynamic =
+			pipelineManager.getPipelineConfig(pipelineHandle).isViewportDynamic();
+
+		Vector<vk::CommandBuffer> secondaryBuffers;
+
+		if (recordSecondary) {
+			Vector<vk::Format> colorFormats;
+			vk::Format depthFormat = vk::Format::eUndefined;
+			vk::Format stencilFormat = vk::Format::eUndefined;
+
+			if (dynamicRendering) {
+				passManager.getAttachmentFormats(passHandle, colorFormats, depthFormat,
+												 stencilFormat);
+			}
+
+			const vk::CommandBufferInheritanceRenderingInfo renderingInheritanceInfo(
+				{}, 0, colorFormats, depthFormat, stencilFormat,
+				msaaToSampleCountFlagBits(passConfig.getMultisampling()));
+
+			vk::CommandBufferInheritanceInfo inheritanceInfo(
+				dynamicRendering ? vk::RenderPass() : renderPass, 0, framebuffer);
+
+			if (dynamicRendering) {
+				inheritanceInfo.setPNext(&renderingInheritanceInfo);
+			}
+
+			const vk::CommandBufferBeginInfo secondaryBeginInfo(
+				vk::CommandBufferUsageFlagBits::eOneTimeSubmit |
+					vk::CommandBufferUsageFlagBits::eRenderPassContinue,
+				&inheritanceInfo);
+
+			// secondary command buffers inherit no state from the primary one
+			secondaryBuffers = recordSecondary([&](const vk::CommandBuffer &secondaryBuffer) {
+				secondaryBuffer.begin(secondaryBeginInfo);
+				secondaryBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline, {});
+
+				if (viewportDynamic) {
+					recordDynamicViewport(secondaryBuffer, width, height);
+				}
+			});
+		}
+
+		const bool secondary = !secondaryBuffers.empty();
+
 		auto submitFunction = [&](const vk::CommandBuffer &cmdBuffer) {
-			const Vector<vk::ClearValue> clearValues =
-				createAttachmentClearValues(attachments);
+			if (dynamicRendering) {
+				Vector<vk::ImageView> attachmentViews;
+				attachmentViews.reserve(renderTargets.size());
 
-			const vk::RenderPassBeginInfo beginInfo(renderPass, framebuffer, renderArea,
-													clearValues.size(), clearValues.data());
+				for (const auto &renderTarget : renderTargets) {
+					attachmentViews.push_back(imageManager.getVulkanImageView(renderTarget));
+				}
 
-			cmdBuffer.beginRenderPass(beginInfo, {}, {});
-			cmdBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline, {});
+				passManager.recordBeginRendering(
+					passHandle, attachmentViews, renderArea, cmdBuffer,
+					secondary ? vk::RenderingFlagBits::eContentsSecondaryCommandBuffers :
+								vk::RenderingFlags());
+			} else {
+				const Vector<vk::ClearValue> clearValues =
+					createAttachmentClearValues(attachments);
 
-			const GraphicsPipelineConfig &pipeConfig =
-				pipelineManager.getPipelineConfig(pipelineHandle);
+				const vk::RenderPassBeginInfo beginInfo(renderPass, framebuffer, renderArea,
+														clearValues.size(), clearValues.data());
 
-			if (pipeConfig.isViewportDynamic()) {
-				recordDynamicViewport(cmdBuffer, width, height);
+				cmdBuffer.beginRenderPass(beginInfo,
+										  secondary ? vk::SubpassContents::eSecondaryCommandBuffers :
+													  vk::SubpassContents::eInline,
+										  {});
 			}
 
-			if (record) {
-				record(cmdBuffer);
+			if (secondary) {
+				cmdBuffer.executeCommands(secondaryBuffers, {});
+			} else {
+				cmdBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline, {});
+
+				if (viewportDynamic) {
+					recordDynamicViewport(cmdBuffer, width, height);
+				}
+
+				if (record) {
+					record(cmdBuffer);
+				}
 			}
 
-			cmdBuffer.endRenderPass();
+			if (dynamicRendering) {
+				cmdBuffer.endRendering(dispatchLoader);
+			} else {
+				cmdBuffer.endRenderPass();
+			}
 		};
 
-		auto finishFunction = [framebuffer, &core]() {
-			core.getContext().getDevice().destroy(framebuffer);
+		core.recordCommandsToStream(cmdStreamHandle, submitFunction, nullptr);
+	}
+
+	/**
+	 * @brief Returns the order to record drawcalls in, so that drawcalls sharing
+	 * their descriptor sets, vertex buffers and index buffer follow each other.
+	 *
+	 * @param[in] descriptorSetManager Descriptor set manager
+	 * @param[in] bufferManager Buffer manager
+	 * @param[in] drawcalls Drawcalls
+	 * @return Indices of the drawcalls in sorted order
+	 */
+	static Vector<size_t> getSortedDrawcallOrder(const DescriptorSetManager &descriptorSetManager,
+												 const BufferManager &bufferManager,
+												 const Vector<InstanceDrawcall> &drawcalls) {
+		struct DrawcallSortKey {
+			Vector<vk::DescriptorSet> descriptorSets;
+			Vector<vk::Buffer> vertexBuffers;
+			vk::Buffer indexBuffer;
 		};
 
-		core.recordCommandsToStream(cmdStreamHandle, submitFunction, finishFunction);
+		Vector<DrawcallSortKey> keys;
+		keys.resize(drawcalls.size());
+
+		for (size_t i = 0; i < drawcalls.size(); i++) {
+			const auto &usages = drawcalls [i].getDescriptorSetUsages();
+			const auto &vertexData = drawcalls [i].getVertexData();
+
+			for (const auto &usage : usages) {
+				keys [i].descriptorSets.push_back(
+					descriptorSetManager.getDescriptorSet(usage.descriptorSet).vulkanHandle);
+			}
+
+			for (const auto &binding : vertexData.getVertexBufferBindings()) {
+				keys [i].vertexBuffers.push_back(bufferManager.getBuffer(binding.m_buffer));
+			}
+
+			if (vertexData.getIndexBuffer()) {
+				keys [i].indexBuffer = bufferManager.getBuffer(vertexData.getIndexBuffer());
+			}
+		}
+
+		Vector<size_t> order;
+		order.resize(drawcalls.size());
+		std::iota(order.begin(), order.end(), 0);
+
+		std::stable_sort(order.begin(), order.end(), [&keys](size_t a, size_t b) {
+			return std::tie(keys [a].descriptorSets, keys [a].vertexBuffers, keys [a].indexBuffer) <
+				   std::tie(keys [b].descriptorSets, keys [b].vertexBuffers, keys [b].indexBuffer);
+		});
+
+		return order;
 	}
 
 	void Core::recordDrawcallsToCmdStream(const CommandStreamHandle &cmdStreamHandle,
@@ -543,16 +1149,68 @@ namespace vkcv {
 		const vk::PipelineLayout pipelineLayout =
 			m_GraphicsPipelineManager->getVkPipelineLayout(pipelineHandle);
 
+		Vector<size_t> order;
+
+		if (m_DrawcallSorting) {
+			order = getSortedDrawcallOrder(*m_DescriptorSetManager, *m_BufferManager, drawcalls);
+		} else {
+			order.resize(drawcalls.size());
+			std::iota(order.begin(), order.end(), 0);
+		}
+
+		// push constants stay assigned to the original index of each drawcall
+		auto recordRange = [&](const vk::CommandBuffer &cmdBuffer, size_t first, size_t last,
+							   DrawcallBindState &state) {
+			for (size_t i = first; i < last; i++) {
+				recordDrawcall(*m_DescriptorSetManager, *m_BufferManager, drawcalls [order [i]],
+							   cmdBuffer, pipelineLayout, pushConstantData, order [i], state);
+			}
+		};
+
 		auto recordFunction = [&](const vk::CommandBuffer &cmdBuffer) {
-			for (size_t i = 0; i < drawcalls.size(); i++) {
-				recordDrawcall(*m_DescriptorSetManager, *m_BufferManager, drawcalls [i], cmdBuffer,
-							   pipelineLayout, pushConstantData, i);
+			DrawcallBindState state {};
+			recordRange(cmdBuffer, 0, order.size(), state);
+			accumulateDrawcallStatistics(m_DrawcallStatistics, state.statistics);
+		};
+
+		const size_t chunkCount = std::min<size_t>(
+			getRecordingThreadCount(), drawcalls.size() / PARALLEL_RECORDING_MIN_DRAWCALLS);
+
+		if (chunkCount <= 1) {
+			recordGraphicsPipeline(*this, *m_CommandStreamManager, *m_GraphicsPipelineManager,
+								   *m_PassManager, *m_ImageManager, cmdStreamHandle,
+								   pipelineHandle, pushConstantData, renderTargets, windowHandle,
+								   recordFunction);
+			return;
+		}
+
+		// each chunk of drawcalls gets recorded with its own command pool
+		auto recordSecondaryFunction = [&](const RecordCommandFunction &begin) {
+			const Vector<vk::CommandBuffer> cmdBuffers = getSecondaryCommandBuffers(chunkCount);
+
+			Vector<DrawcallBindState> states;
+			states.resize(chunkCount);
+
+			m_RecordingWorkers->run(chunkCount, [&](size_t chunk) {
+				const vk::CommandBuffer &cmdBuffer = cmdBuffers [chunk];
+
+				begin(cmdBuffer);
+				recordRange(cmdBuffer, order.size() * chunk / chunkCount,
+							order.size() * (chunk + 1) / chunkCount, states [chunk]);
+				cmdBuffer.end();
+			});
+
+			for (const auto &state : states) {
+				accumulateDrawcallStatistics(m_DrawcallStatistics, state.statistics);
 			}
+
+			return cmdBuffers;
 		};
 
 		recordGraphicsPipeline(*this, *m_CommandStreamManager, *m_GraphicsPipelineManager,
 							   *m_PassManager, *m_ImageManager, cmdStreamHandle, pipelineHandle,
-							   pushConstantData, renderTargets, windowHandle, recordFunction);
+							   pushConstantData, renderTargets, windowHandle, recordFunction,
+							   recordSecondaryFunction);
 	}
 
 	static void
@@ -580,21 +1238,55 @@ namespace vkcv {
 		}
 
 		if (pushConstantData.getSizePerDrawcall() > 0) {
+			// drawcalls without own push constants share the ones of the first drawcall
+			const size_t pushConstantIndex = (
+					drawcallIndex < pushConstantData.getDrawcallCount()? drawcallIndex : 0
+			);
+
 			cmdBuffer.pushConstants(pipelineLayout, vk::ShaderStageFlagBits::eAll, 0,
 									pushConstantData.getSizePerDrawcall(),
-									pushConstantData.getDrawcallData(0));
+									pushConstantData.getDrawcallData(pushConstantIndex));
 		}
 
+		const vk::Buffer indirectDrawBuffer = bufferManager.getBuffer(
+				drawcall.getIndirectDrawBuffer()
+		);
+
+		const vk::Buffer drawCountBuffer = drawcall.getDrawCountBuffer()?
+				bufferManager.getBuffer(drawcall.getDrawCountBuffer()) : nullptr;
+
 		if (vertexData.getIndexBuffer()) {
-			cmdBuffer.bindIndexBuffer(bufferManager.getBuffer(vertexData.getIndexBuffer()), 0,
+			cmdBuffer.bindIndexBuffer(bufferManager.getBuffer(vertexData.getIndexBuffer()),
+									  vertexData.getIndexOffset(),
 									  getIndexType(vertexData.getIndexBitCount()));
 
-			cmdBuffer.drawIndexedIndirect(bufferManager.getBuffer(drawcall.getIndirectDrawBuffer()),
-										  0, drawcall.getDrawCount(),
-										  sizeof(vk::DrawIndexedIndirectCommand));
+			if (drawCountBuffer) {
+				cmdBuffer.drawIndexedIndirectCount(indirectDrawBuffer,
+												   drawcall.getIndirectDrawOffset(),
+												   drawCountBuffer,
+												   drawcall.getDrawCountOffset(),
+												   drawcall.getDrawCount(),
+												   sizeof(vk::DrawIndexedIndirectCommand));
+			} else {
+				cmdBuffer.drawIndexedIndirect(indirectDrawBuffer,
+											  drawcall.getIndirectDrawOffset(),
+											  drawcall.getDrawCount(),
+											  sizeof(vk::DrawIndexedIndirectCommand));
+			}
 		} else {
-			cmdBuffer.drawIndirect(bufferManager.getBuffer(drawcall.getIndirectDrawBuffer()), 0,
-								   drawcall.getDrawCount(), sizeof(vk::DrawIndirectCommand));
+			if (drawCountBuffer) {
+				cmdBuffer.drawIndirectCount(indirectDrawBuffer,
+											drawcall.getIndirectDrawOffset(),
+											drawCountBuffer,
+											drawcall.getDrawCountOffset(),
+											drawcall.getDrawCount(),
+											sizeof(vk::DrawIndirectCommand));
+			} else {
+				cmdBuffer.drawIndirect(indirectDrawBuffer,
+									   drawcall.getIndirectDrawOffset(),
+									   drawcall.getDrawCount(),
+									   sizeof(vk::DrawIndirectCommand));
+			}
 		}
 	}
 
@@ -869,11 +1561,16 @@ namespace vkcv {
 		const uint32_t semaphoreIndex = m_currentSwapchainSemaphoreIndex % m_SwapchainImagesAcquired.size();
 		m_currentSwapchainSemaphoreIndex = (m_currentSwapchainSemaphoreIndex + 1) % m_SwapchainImagesAcquired.size();
 
+		auto &frame = m_Frames [m_currentFrameIndex];
+
 		const std::array<vk::Semaphore, 2> waitSemaphores {
-			m_RenderFinished,
+			frame.renderFinished,
 			m_SwapchainImagesAcquired[semaphoreIndex]
 		};
 
+		// the presentation consumes the signal of the rendering
+		frame.renderingSignaled = false;
+
 		const vk::SwapchainKHR &swapchain =
 			m_SwapchainManager->getSwapchain(swapchainHandle).m_Swapchain;
 		const vk::PresentInfoKHR presentInfo(
@@ -929,7 +1626,8 @@ namespace vkcv {
 
 	CommandStreamHandle Core::createCommandStream(QueueType queueType) {
 		const vkcv::Queue queue = getQueueForSubmit(queueType, m_Context.getQueueManager());
-		const vk::CommandPool cmdPool = m_CommandPools [queue.familyIndex];
+		const auto &frame = m_Frames [m_currentFrameIndex];
+		const vk::CommandPool cmdPool = frame.commandPools [queue.familyIndex];
 
 		return m_CommandStreamManager->createCommandStream(queue.handle, cmdPool);
 	}
@@ -946,19 +1644,56 @@ namespace vkcv {
 		}
 	}
 
+	void Core::prepareRenderingSemaphores(bool signalRendering,
+										  Vector<vk::Semaphore> &waitSemaphores,
+										  Vector<vk::Semaphore> &signalSemaphores) {
+		if (!signalRendering) {
+			return;
+		}
+
+		auto &frame = m_Frames [m_currentFrameIndex];
+
+		// a binary semaphore can't be signaled twice, so the signal gets passed on
+		if (frame.renderingSignaled) {
+			waitSemaphores.push_back(frame.renderFinished);
+		}
+
+		signalSemaphores.push_back(frame.renderFinished);
+		frame.renderingSignaled = true;
+	}
+
 	void Core::submitCommandStream(const CommandStreamHandle &stream, bool signalRendering) {
-		Vector<vk::Semaphore> waitSemaphores;
+		m_BufferManager->flushStagingBuffer();
 
 		// FIXME: add proper user controllable sync
+		Vector<vk::Semaphore> waitSemaphores;
 		Vector<vk::Semaphore> signalSemaphores;
-		if (signalRendering) {
-			signalSemaphores.push_back(m_RenderFinished);
-		}
+		prepareRenderingSemaphores(signalRendering, waitSemaphores, signalSemaphores);
 
 		m_CommandStreamManager->submitCommandStreamSynchronous(stream, waitSemaphores,
 															   signalSemaphores);
 	}
 
+	uint64_t Core::submitCommandStreamAsync(const CommandStreamHandle &stream,
+											bool signalRendering) {
+		m_BufferManager->flushStagingBuffer();
+
+		Vector<vk::Semaphore> waitSemaphores;
+		Vector<vk::Semaphore> signalSemaphores;
+		prepareRenderingSemaphores(signalRendering, waitSemaphores, signalSemaphores);
+
+		return m_CommandStreamManager->submitCommandStreamAsynchronous(stream, waitSemaphores,
+																	   signalSemaphores);
+	}
+
+	bool Core::isSubmissionFinished(uint64_t submission) {
+		return m_CommandStreamManager->isSubmissionFinished(submission);
+	}
+
+	bool Core::waitForSubmission(uint64_t submission, uint64_t timeout) {
+		return m_CommandStreamManager->waitForSubmission(submission, timeout);
+	}
+
 	SamplerHandle Core::createSampler(SamplerFilterType magFilter, SamplerFilterType minFilter,
 									  SamplerMipmapMode mipmapMode, SamplerAddressMode addressMode,
 									  float mipLodBias, SamplerBorderColor borderColor) {
@@ -977,6 +1712,10 @@ namespace vkcv {
 							std::max(config.getHeight(), config.getDepth()))
 					)
 			);
+			
+			if (config.getMipCount() > 0) {
+				mipCount = std::min(mipCount, config.getMipCount());
+			}
 		}
 
 		return m_ImageManager->createImage(
@@ -990,14 +1729,28 @@ namespace vkcv {
 						 const void* data,
 						 size_t size,
 						 uint32_t firstLayer,
-						 uint32_t layerCount) {
-		m_ImageManager->fillImage(image, data, size, firstLayer, layerCount);
+						 uint32_t layerCount,
+						 uint32_t firstMipLevel,
+						 uint32_t mipLevelCount) {
+		m_ImageManager->fillImage(image, data, size, firstLayer, layerCount,
+								  firstMipLevel, mipLevelCount);
 	}
 
 	void Core::switchImageLayout(const ImageHandle &image, vk::ImageLayout layout) {
 		m_ImageManager->switchImageLayoutImmediate(image, layout);
 	}
 
+	void Core::recordMipChainGenerationToUploads(const ImageHandle &image) {
+		const CommandStreamHandle &acquireStream = m_BufferManager->getAcquireStream();
+
+		m_ImageManager->recordImageMipChainGenerationToCmdStream(acquireStream, image);
+		prepareImageForSampling(acquireStream, image);
+	}
+
+	uint64_t Core::flushUploads() {
+		return m_BufferManager->flushStagingBuffer();
+	}
+
 	Downsampler &Core::getDownsampler() {
 		return *m_downsampler;
 	}
@@ -1246,6 +1999,8 @@ namespace vkcv {
 		setDebugObjectLabel(m_Context.getDevice(), vk::ObjectType::eBuffer,
 							uint64_t(static_cast<VkBuffer>(m_BufferManager->getBuffer(handle))),
 							label);
+
+		m_BufferManager->setDebugLabel(handle, label);
 	}
 
 	void Core::setDebugLabel(const PassHandle &handle, const std::string &label) {
@@ -1318,6 +2073,8 @@ namespace vkcv {
 		setDebugObjectLabel(m_Context.getDevice(), vk::ObjectType::eImage,
 							uint64_t(static_cast<VkImage>(m_ImageManager->getVulkanImage(handle))),
 							label);
+
+		m_ImageManager->setDebugLabel(handle, label);
 	}
 
 	void Core::setDebugLabel(const CommandStreamHandle &handle, const std::string &label) {
@@ -9,20 +9,14 @@ namespace vkcv {
 	}
 
 	DescriptorSetLayoutHandle
-	DescriptorSetLayoutManager::createById(uint64_t id, const HandleDestroyFunction &destroy) {
-		return DescriptorSetLayoutHandle(id, destroy);
+	DescriptorSetLayoutManager::createById(uint64_t id, HandleCounter &counter) {
+		return DescriptorSetLayoutHandle(id, counter, *this);
 	}
 
 	void DescriptorSetLayoutManager::destroyById(uint64_t id) {
+		std::lock_guard<std::mutex> lock(m_layoutMutex);
 		auto &layout = getById(id);
 
-		if (layout.layoutUsageCount > 1) {
-			layout.layoutUsageCount--;
-			return;
-		} else {
-			layout.layoutUsageCount = 0;
-		}
-
 		if (layout.vulkanHandle) {
 			getCore().getContext().getDevice().destroy(layout.vulkanHandle);
 			layout.vulkanHandle = nullptr;
@@ -30,30 +24,30 @@ namespace vkcv {
 	}
 
 	DescriptorSetLayoutManager::DescriptorSetLayoutManager() noexcept :
-		HandleManager<DescriptorSetLayoutEntry, DescriptorSetLayoutHandle>() {}
+		HandleManager<DescriptorSetLayoutEntry, DescriptorSetLayoutHandle>(), m_layoutMutex() {}
 
 	DescriptorSetLayoutManager::~DescriptorSetLayoutManager() noexcept {
-		for (uint64_t id = 0; id < getCount(); id++) {
-			// Resets the usage count to one for destruction.
-			getById(id).layoutUsageCount = 1;
-		}
-
 		clear();
 	}
 
 	DescriptorSetLayoutHandle
 	DescriptorSetLayoutManager::createDescriptorSetLayout(const DescriptorBindings &bindings) {
+		std::lock_guard<std::mutex> lock(m_layoutMutex);
+
 		for (uint64_t id = 0; id < getCount(); id++) {
 			auto &layout = getById(id);
 
-			if (layout.descriptorBindings.size() != bindings.size())
+			if ((!layout.vulkanHandle) || (layout.descriptorBindings.size() != bindings.size()))
 				continue;
 
 			if (layout.descriptorBindings == bindings) {
-				layout.layoutUsageCount++;
-				return createById(id, [&](uint64_t id) {
-					destroyById(id);
-				});
+				// the layout is shared via the reference counter of its slot, unless
+				// it has been released and only waits for its deferred destruction
+				const DescriptorSetLayoutHandle handle = createHandleIfReferenced(getHandleId(id));
+
+				if (handle) {
+					return handle;
+				}
 			}
 		}
 
@@ -96,7 +90,7 @@ namespace vkcv {
 			return DescriptorSetLayoutHandle();
 		};
 
-		return add({ vulkanHandle, bindings, 1 });
+		return add({ vulkanHandle, bindings });
 	}
 
 	const DescriptorSetLayoutEntry &DescriptorSetLayoutManager::getDescriptorSetLayout(
@@ -4,6 +4,7 @@
  * @file src/vkcv/DescriptorManager.cpp
  * @brief Creation and handling of descriptor set layouts.
  */
+#include <mutex>
 #include <vulkan/vulkan.hpp>
 
 #include "vkcv/DescriptorBinding.hpp"
@@ -18,7 +19,6 @@ namespace vkcv {
 	struct DescriptorSetLayoutEntry {
 		vk::DescriptorSetLayout vulkanHandle;
 		DescriptorBindings descriptorBindings;
-		size_t layoutUsageCount;
 	};
 
 	/**
@@ -29,10 +29,12 @@ namespace vkcv {
 		friend class Core;
 
 	private:
+		std::mutex m_layoutMutex;
+
 		[[nodiscard]] uint64_t getIdFrom(const DescriptorSetLayoutHandle &handle) const override;
 
 		[[nodiscard]] DescriptorSetLayoutHandle
-		createById(uint64_t id, const HandleDestroyFunction &destroy) override;
+		createById(uint64_t id, HandleCounter &counter) override;
 
 		/**
 		 * Destroys and deallocates descriptor set layout represented by a given
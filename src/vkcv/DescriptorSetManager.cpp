@@ -67,8 +67,8 @@ namespace vkcv {
 	}
 
 	DescriptorSetHandle DescriptorSetManager::createById(uint64_t id,
-														 const HandleDestroyFunction &destroy) {
-		return DescriptorSetHandle(id, destroy);
+														 HandleCounter &counter) {
+		return DescriptorSetHandle(id, counter, *this);
 	}
 
 	void DescriptorSetManager::destroyById(uint64_t id) {
@@ -76,6 +76,8 @@ namespace vkcv {
 		auto &set = getById(id);
 
 		if (set.vulkanHandle) {
+			std::lock_guard<std::mutex> lock(m_PoolMutex);
+
 			device.freeDescriptorSets(
 				m_Pools[set.poolIndex],
 				1,
@@ -103,7 +105,7 @@ namespace vkcv {
 	}
 
 	DescriptorSetManager::DescriptorSetManager() noexcept :
-		HandleManager<DescriptorSetEntry, DescriptorSetHandle>() {}
+		HandleManager<DescriptorSetEntry, DescriptorSetHandle>(), m_PoolMutex() {}
 
 	DescriptorSetManager::~DescriptorSetManager() noexcept {
 		const auto& device = getCore().getContext().getDevice();
@@ -124,6 +126,9 @@ namespace vkcv {
 		const auto &device = getCore().getContext().getDevice();
 
 
+		// descriptor pools need to be synchronized externally
+		std::unique_lock<std::mutex> lock(m_PoolMutex);
+
 		vk::DescriptorSet vulkanHandle;
 		vk::DescriptorSetAllocateInfo allocInfo(
 			m_Pools.back(),
@@ -171,6 +176,8 @@ namespace vkcv {
 		};
 
 		size_t poolIndex = (m_Pools.size() - 1);
+		lock.unlock();
+
 		return add({ vulkanHandle, layout, poolIndex });
 	}
 
@@ -4,6 +4,7 @@
  * @file src/vkcv/DescriptorManager.cpp
  * @brief Creation and handling of descriptor sets and the respective descriptor pools.
  */
+#include <mutex>
 #include <vulkan/vulkan.hpp>
 
 #include "vkcv/DescriptorBinding.hpp"
@@ -36,6 +37,7 @@ namespace vkcv {
 		DescriptorSetLayoutManager* m_DescriptorSetLayoutManager;
 
 		Vector<vk::DescriptorPool> m_Pools;
+		std::mutex m_PoolMutex;
 		Vector<vk::DescriptorPoolSize> m_PoolSizes;
 		vk::DescriptorPoolCreateInfo m_PoolInfo;
 		vk::DescriptorPoolInlineUniformBlockCreateInfo m_InlineUniformBlockInfo;
@@ -46,7 +48,7 @@ namespace vkcv {
 		[[nodiscard]] uint64_t getIdFrom(const DescriptorSetHandle &handle) const override;
 
 		[[nodiscard]] DescriptorSetHandle createById(uint64_t id,
-													 const HandleDestroyFunction &destroy) override;
+													 HandleCounter &counter) override;
 
 		/**
 		 * Destroys and deallocates descriptor set represented by a given
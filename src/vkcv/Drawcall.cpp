@@ -36,17 +36,25 @@ namespace vkcv {
 
 	IndirectDrawcall::IndirectDrawcall(const BufferHandle &indirectDrawBuffer,
 									   const VertexData &vertexData,
-									   uint32_t drawCount) :
+									   uint32_t drawCount,
+									   size_t indirectDrawOffset) :
 		Drawcall(),
 		m_indirectDrawBuffer(indirectDrawBuffer),
+		m_indirectDrawOffset(indirectDrawOffset),
 		m_vertexData(vertexData),
-		m_drawCount(drawCount) {
+		m_drawCount(drawCount),
+		m_drawCountBuffer(),
+		m_drawCountOffset(0) {
 	}
 
 	BufferHandle IndirectDrawcall::getIndirectDrawBuffer() const {
 		return m_indirectDrawBuffer;
 	}
 
+	size_t IndirectDrawcall::getIndirectDrawOffset() const {
+		return m_indirectDrawOffset;
+	}
+
 	const VertexData &IndirectDrawcall::getVertexData() const {
 		return m_vertexData;
 	}
@@ -55,6 +63,20 @@ namespace vkcv {
 		return m_drawCount;
 	}
 
+	void IndirectDrawcall::useDrawCountBuffer(const BufferHandle &drawCountBuffer,
+											  size_t drawCountOffset) {
+		m_drawCountBuffer = drawCountBuffer;
+		m_drawCountOffset = drawCountOffset;
+	}
+
+	BufferHandle IndirectDrawcall::getDrawCountBuffer() const {
+		return m_drawCountBuffer;
+	}
+
+	size_t IndirectDrawcall::getDrawCountOffset() const {
+		return m_drawCountOffset;
+	}
+
 	TaskDrawcall::TaskDrawcall(const DispatchSize& taskSize) : Drawcall(), m_taskSize(taskSize) {}
 	
 	DispatchSize TaskDrawcall::getTaskSize() const {
@@ -535,6 +535,15 @@ namespace vkcv {
 
 		return true;
 	}
+	
+	bool FeatureManager::checkSupport(const vk::PhysicalDeviceDynamicRenderingFeatures &features,
+									  bool required) const {
+		vkcv_check_init_features2(vk::PhysicalDeviceDynamicRenderingFeatures);
+		
+		vkcv_check_feature(dynamicRendering);
+		
+		return true;
+	}
 
 	vk::BaseOutStructure* FeatureManager::findFeatureStructure(vk::StructureType type) const {
 		for (auto &base : m_featuresExtensions) {
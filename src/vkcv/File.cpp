@@ -59,7 +59,7 @@ namespace vkcv {
 	
 	bool writeContentToFile(const std::filesystem::path &path,
 							const Vector<char>& content) {
-		std::ofstream file (path.string(), std::ios::out);
+		std::ofstream file (path.string(), std::ios::out | std::ios::binary);
 		
 		if (!file.is_open()) {
 			vkcv_log(LogLevel::ERROR, "The file could not be opened (%s)",
@@ -76,7 +76,7 @@ namespace vkcv {
 	
 	bool writeBinaryToFile(const std::filesystem::path &path,
 						   const Vector<uint32_t>& binary) {
-		std::ofstream file (path.string(), std::ios::out);
+		std::ofstream file (path.string(), std::ios::out | std::ios::binary);
 		
 		if (!file.is_open()) {
 			vkcv_log(LogLevel::ERROR, "The file could not be opened (%s)",
@@ -113,7 +113,7 @@ namespace vkcv {
 	
 	bool readContentFromFile(const std::filesystem::path &path,
 							 Vector<char>& content) {
-		std::ifstream file (path.string(), std::ios::ate);
+		std::ifstream file (path.string(), std::ios::ate | std::ios::binary);
 		
 		if (!file.is_open()) {
 			vkcv_log(LogLevel::ERROR, "The file could not be opened (%s)",
@@ -133,7 +133,7 @@ namespace vkcv {
 	
 	bool readBinaryFromFile(const std::filesystem::path &path,
 							Vector<uint32_t>& binary) {
-		std::ifstream file (path.string(), std::ios::ate);
+		std::ifstream file (path.string(), std::ios::ate | std::ios::binary);
 		
 		if (!file.is_open()) {
 			vkcv_log(LogLevel::ERROR, "The file could not be opened (%s)",
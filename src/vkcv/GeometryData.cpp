@@ -9,6 +9,7 @@ namespace vkcv {
 		m_vertexType(GeometryVertexType::UNDEFINED),
 		m_indices(),
 		m_indexBitCount(IndexBitCount::Bit16),
+		m_indexOffset(0),
 		m_count(0) {}
 	
 	GeometryData::GeometryData(const VertexBufferBinding &binding,
@@ -19,6 +20,7 @@ namespace vkcv {
 		m_vertexType(geometryVertexType),
 		m_indices(),
 		m_indexBitCount(IndexBitCount::Bit16),
+		m_indexOffset(0),
 		m_count(0) {}
 	
 	bool GeometryData::isValid() const {
@@ -41,9 +43,11 @@ namespace vkcv {
 		return m_vertexType;
 	}
 	
-	void GeometryData::setIndexBuffer(const BufferHandle &indices, IndexBitCount indexBitCount) {
+	void GeometryData::setIndexBuffer(const BufferHandle &indices, IndexBitCount indexBitCount,
+									  size_t offset) {
 		m_indices = indices;
 		m_indexBitCount = indexBitCount;
+		m_indexOffset = offset;
 	}
 	
 	const BufferHandle &GeometryData::getIndexBuffer() const {
@@ -54,6 +58,10 @@ namespace vkcv {
 		return m_indexBitCount;
 	}
 	
+	size_t GeometryData::getIndexOffset() const {
+		return m_indexOffset;
+	}
+	
 	void GeometryData::setCount(size_t count) {
 		m_count = count;
 	}
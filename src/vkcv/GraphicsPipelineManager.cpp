@@ -12,8 +12,8 @@ namespace vkcv {
 	}
 
 	GraphicsPipelineHandle
-	GraphicsPipelineManager::createById(uint64_t id, const HandleDestroyFunction &destroy) {
-		return GraphicsPipelineHandle(id, destroy);
+	GraphicsPipelineManager::createById(uint64_t id, HandleCounter &counter) {
+		return GraphicsPipelineHandle(id, counter, *this);
 	}
 
 	void GraphicsPipelineManager::destroyById(uint64_t id) {
@@ -685,6 +685,23 @@ namespace vkcv {
 				existsTessellationEvaluationShader
 		);
 
+		// attachment formats replace the render pass with dynamic rendering
+		const bool dynamicRendering = passManager.isDynamicRendering(config.getPass());
+
+		Vector<vk::Format> colorAttachmentFormats;
+		vk::Format depthAttachmentFormat;
+		vk::Format stencilAttachmentFormat;
+
+		passManager.getAttachmentFormats(config.getPass(), colorAttachmentFormats,
+										 depthAttachmentFormat, stencilAttachmentFormat);
+
+		const vk::PipelineRenderingCreateInfo pipelineRenderingCreateInfo(
+			0,
+			colorAttachmentFormats,
+			depthAttachmentFormat,
+			stencilAttachmentFormat
+		);
+
 		// Get all setting structs together and create the Pipeline
 		const vk::GraphicsPipelineCreateInfo graphicsPipelineCreateInfo(
 			{},
@@ -703,11 +720,12 @@ namespace vkcv {
 			pass,
 			0,
 			{},
-			0
+			0,
+			dynamicRendering? &pipelineRenderingCreateInfo : nullptr
 		);
 		
 		auto pipelineResult = getCore().getContext().getDevice().createGraphicsPipeline(
-				nullptr, graphicsPipelineCreateInfo
+				getCore().getPipelineCache(), graphicsPipelineCreateInfo
 		);
 		
 		if (pipelineResult.result != vk::Result::eSuccess) {
@@ -32,7 +32,7 @@ namespace vkcv {
 		[[nodiscard]] uint64_t getIdFrom(const GraphicsPipelineHandle &handle) const override;
 
 		[[nodiscard]] GraphicsPipelineHandle
-		createById(uint64_t id, const HandleDestroyFunction &destroy) override;
+		createById(uint64_t id, HandleCounter &counter) override;
 
 		/**
 		 * Destroys and deallocates graphics pipeline represented by a given
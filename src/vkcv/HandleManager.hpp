@@ -1,8 +1,14 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <optional>
 
 #include "vkcv/Container.hpp"
+#include "vkcv/EventFunctionTypes.hpp"
 #include "vkcv/Handles.hpp"
 #include "vkcv/Logger.hpp"
 
@@ -10,16 +16,119 @@ namespace vkcv {
 
 	class Core;
 
+	/**
+	 * @brief Defers the destruction of a resource until the current frame in
+	 * flight of a given core has been retired by the GPU.
+	 *
+	 * @param[in,out] core Core instance
+	 * @param[in] destroy Function to destroy the resource
+	 * @return True, if the destruction got deferred, otherwise false
+	 */
+	bool deferDestruction(Core &core, const FinishCommandFunction &destroy);
+
+	/**
+	 * @brief Amount of lower bits of a handle id storing the index of its slot,
+	 * the upper bits store the generation of the slot.
+	 */
+	constexpr uint64_t HANDLE_INDEX_BITS = 32;
+	constexpr uint64_t HANDLE_INDEX_MASK = (1ULL << HANDLE_INDEX_BITS) - 1;
+
+	/**
+	 * @brief Amount of slots allocated together in one page, so that the
+	 * addresses of entries and reference counters stay stable while new
+	 * slots get added.
+	 */
+	constexpr uint64_t HANDLE_PAGE_SIZE = 1024;
+
+	/**
+	 * @brief Maximum amount of pages a handle manager can allocate.
+	 */
+	constexpr uint64_t HANDLE_PAGE_COUNT = 4096;
+
+	/**
+	 * @brief Generation of a slot in a handle manager and whether it is
+	 * currently free to be reused.
+	 */
+	struct HandleSlot {
+		uint32_t generation;
+		bool free;
+	};
+
+	/**
+	 * @brief Page of slots in a handle manager storing the entries, the
+	 * state of the slots and the reference counters of their handles.
+	 */
+	template <typename T>
+	struct HandlePage {
+		std::array<T, HANDLE_PAGE_SIZE> entries;
+		std::array<HandleSlot, HANDLE_PAGE_SIZE> slots;
+		std::array<HandleCounter, HANDLE_PAGE_SIZE> counters;
+	};
+
+	/**
+	 * @brief Class to manage entries represented by reference counted handles.
+	 *
+	 * Entries get stored in pages which never move after allocation. So new
+	 * entries can be added from multiple threads while other threads read
+	 * existing entries without any locking. Only the selection of a slot for
+	 * a new entry is guarded by a mutex.
+	 *
+	 * Modifying the same entry from multiple threads still needs to be
+	 * synchronized externally.
+	 */
 	template <typename T, typename H = Handle>
-	class HandleManager {
+	class HandleManager : public HandleOwner {
 		friend class Core;
 
 	private:
 		Core* m_core;
-		Vector<T> m_entries;
+		std::array<std::atomic<HandlePage<T>*>, HANDLE_PAGE_COUNT> m_pages;
+		std::atomic<uint64_t> m_count;
+		Vector<uint64_t> m_freeIndices;
+		std::mutex m_mutex;
+
+		/**
+		 * @brief Releases an entry after the last handle referencing it got
+		 * dropped.
+		 *
+		 * @param id Handle id
+		 */
+		void releaseHandle(uint64_t id) override {
+			releaseById(id);
+		}
+
+		/**
+		 * @brief Returns the page containing a slot by its index or nullptr
+		 * if the page has not been allocated.
+		 *
+		 * @param index Slot index
+		 * @return Page of the slot
+		 */
+		[[nodiscard]] HandlePage<T>* getPage(uint64_t index) const {
+			const uint64_t page = (index / HANDLE_PAGE_SIZE);
+
+			if (page >= HANDLE_PAGE_COUNT) {
+				return nullptr;
+			}
+
+			return m_pages [page].load(std::memory_order_acquire);
+		}
+
+		/**
+		 * @brief Destroys all allocated pages and resets the amount of slots.
+		 */
+		void freePages() {
+			for (auto &page : m_pages) {
+				delete page.exchange(nullptr);
+			}
+
+			m_count = 0;
+			m_freeIndices.clear();
+		}
 
 	protected:
-		HandleManager() noexcept : m_core(nullptr), m_entries() {}
+		HandleManager() noexcept :
+			m_core(nullptr), m_pages(), m_count(0), m_freeIndices(), m_mutex() {}
 
 		virtual bool init(Core &core) {
 			if (m_core) {
@@ -27,13 +136,13 @@ namespace vkcv {
 				return false;
 			}
 
-			if (!m_entries.empty()) {
+			if (getCount() > 0) {
 				vkcv_log(vkcv::LogLevel::WARNING,
 						 "Entries added before initialization will be erased");
 			}
 
 			m_core = &core;
-			m_entries.clear();
+			freePages();
 			return true;
 		}
 
@@ -45,58 +154,306 @@ namespace vkcv {
 			return *m_core;
 		}
 
+		/**
+		 * @brief Returns the amount of slots in use or freed for reuse.
+		 *
+		 * @return Amount of slots
+		 */
 		[[nodiscard]] size_t getCount() const {
-			return m_entries.size();
+			return m_count.load(std::memory_order_acquire);
 		}
 
 		[[nodiscard]] const T &getById(uint64_t id) const {
-			if (id >= m_entries.size()) {
+			const uint64_t index = (id & HANDLE_INDEX_MASK);
+
+			if (index >= getCount()) {
 				static T invalid;
 				vkcv_log(vkcv::LogLevel::ERROR, "Invalid handle id");
 				return invalid;
 			}
 
-			return m_entries [id];
+			return getPage(index)->entries [index % HANDLE_PAGE_SIZE];
 		}
 
 		[[nodiscard]] T &getById(uint64_t id) {
-			if (id >= m_entries.size()) {
+			const uint64_t index = (id & HANDLE_INDEX_MASK);
+
+			if (index >= getCount()) {
 				static T invalid;
 				vkcv_log(vkcv::LogLevel::ERROR, "Invalid handle id");
 				return invalid;
 			}
 
-			return m_entries [id];
+			return getPage(index)->entries [index % HANDLE_PAGE_SIZE];
+		}
+
+		/**
+		 * @brief Returns the reference counter of handles for a slot by its id.
+		 *
+		 * @param id Handle id
+		 * @return Reference counter
+		 */
+		[[nodiscard]] HandleCounter &getCounterById(uint64_t id) {
+			const uint64_t index = (id & HANDLE_INDEX_MASK);
+			return getPage(index)->counters [index % HANDLE_PAGE_SIZE];
+		}
+
+		/**
+		 * @brief Creates a new handle referencing the entry of an already used
+		 * slot by its index.
+		 *
+		 * @param index Slot index
+		 * @return New handle
+		 */
+		[[nodiscard]] H createHandle(uint64_t index) {
+			return createById(getHandleId(index), getCounterById(index));
+		}
+
+		/**
+		 * @brief Creates a new handle referencing the entry of an already used
+		 * slot by its handle id, unless the last handle referencing it has been
+		 * dropped already or the slot has been reused for another entry since.
+		 * The entry might then be destroyed any time, so an invalid handle gets
+		 * returned instead.
+		 *
+		 * @param id Handle id including the generation of the slot
+		 * @return New handle or invalid handle
+		 */
+		[[nodiscard]] H createHandleIfReferenced(uint64_t id) {
+			const uint64_t index = (id & HANDLE_INDEX_MASK);
+			HandleCounter &counter = getCounterById(index);
+
+#ifdef VKCV_ATOMIC_HANDLES
+			uint64_t count = counter.load(std::memory_order_relaxed);
+
+			// the counter stays pinned above zero while the new handle gets created
+			do {
+				if (count == 0) {
+					return H();
+				}
+			} while (!counter.compare_exchange_weak(count, count + 1,
+													std::memory_order_acquire,
+													std::memory_order_relaxed));
+
+			// the pinned slot can't be recycled, so its generation is stable now
+			H handle = createHandle(index);
+			counter.fetch_sub(1, std::memory_order_relaxed);
+
+			// dropping the handle of another entry releases it properly if needed
+			if (isStaleId(id)) {
+				return H();
+			}
+
+			return handle;
+#else
+			if ((counter == 0) || (isStaleId(id))) {
+				return H();
+			}
+
+			return createHandle(index);
+#endif
+		}
+
+		/**
+		 * @brief Returns the handle id of a slot by its index including the
+		 * current generation of the slot.
+		 *
+		 * @param index Slot index
+		 * @return Handle id
+		 */
+		[[nodiscard]] uint64_t getHandleId(uint64_t index) const {
+			index &= HANDLE_INDEX_MASK;
+
+			if (index >= getCount()) {
+				return index;
+			}
+
+			const auto &slot = getPage(index)->slots [index % HANDLE_PAGE_SIZE];
+			return (static_cast<uint64_t>(slot.generation) << HANDLE_INDEX_BITS) | index;
+		}
+
+		/**
+		 * @brief Returns whether a handle id refers to a slot which has been
+		 * freed or reused for another entry since the handle was created.
+		 *
+		 * @param id Handle id
+		 * @return True, if the handle id is stale, otherwise false
+		 */
+		[[nodiscard]] bool isStaleId(uint64_t id) const {
+			const uint64_t index = (id & HANDLE_INDEX_MASK);
+
+			if (index >= getCount()) {
+				return false;
+			}
+
+			const auto &slot = getPage(index)->slots [index % HANDLE_PAGE_SIZE];
+			return (slot.free) || (getHandleId(index) != id);
 		}
 
 		virtual uint64_t getIdFrom(const H &handle) const = 0;
 
 		[[nodiscard]] virtual const T &operator[](const H &handle) const {
 			const Handle &_handle = handle;
-			return getById(getIdFrom(static_cast<const H &>(_handle)));
+			const uint64_t id = getIdFrom(static_cast<const H &>(_handle));
+
+			if (isStaleId(id)) {
+				static T invalid;
+				vkcv_log(vkcv::LogLevel::ERROR, "Stale handle id");
+				return invalid;
+			}
+
+			return getById(id);
 		}
 
 		[[nodiscard]] virtual T &operator[](const H &handle) {
 			const Handle &_handle = handle;
-			return getById(getIdFrom(static_cast<const H &>(_handle)));
+			const uint64_t id = getIdFrom(static_cast<const H &>(_handle));
+
+			if (isStaleId(id)) {
+				static T invalid;
+				vkcv_log(vkcv::LogLevel::ERROR, "Stale handle id");
+				return invalid;
+			}
+
+			return getById(id);
 		}
 
-		H add(const T &entry) {
-			const uint64_t id = m_entries.size();
-			m_entries.push_back(entry);
-			return createById(id, [&](uint64_t id) {
-				destroyById(id);
-			});
+		/**
+		 * @brief Adds a new entry and returns a handle representing it. Entries
+		 * can be added from multiple threads concurrently while other threads
+		 * access existing entries of the manager.
+		 *
+		 * Slots of destroyed entries get reused before any new slot is
+		 * allocated.
+		 *
+		 * @param entry New entry
+		 * @return Handle of the entry
+		 */
+		H add(T entry) {
+			uint64_t id;
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				if (m_freeIndices.empty()) {
+					id = getCount();
+
+					if (id >= HANDLE_PAGE_SIZE * HANDLE_PAGE_COUNT) {
+						vkcv_log(vkcv::LogLevel::ERROR, "Manager ran out of handle slots");
+						return H();
+					}
+
+					auto &pointer = m_pages [id / HANDLE_PAGE_SIZE];
+					HandlePage<T>* page = pointer.load(std::memory_order_relaxed);
+
+					if (!page) {
+						page = new HandlePage<T>();
+						pointer.store(page, std::memory_order_release);
+					}
+
+					page->entries [id % HANDLE_PAGE_SIZE] = std::move(entry);
+					page->slots [id % HANDLE_PAGE_SIZE] = { 0, false };
+
+					m_count.store(id + 1, std::memory_order_release);
+				} else {
+					const uint64_t index = m_freeIndices.back();
+					m_freeIndices.pop_back();
+
+					HandlePage<T>* page = getPage(index);
+					page->entries [index % HANDLE_PAGE_SIZE] = std::move(entry);
+					page->slots [index % HANDLE_PAGE_SIZE].free = false;
+					id = getHandleId(index);
+				}
+			}
+
+			return createById(id, getCounterById(id));
 		}
 
-		virtual H createById(uint64_t id, const HandleDestroyFunction &destroy) = 0;
+		virtual H createById(uint64_t id, HandleCounter &counter) = 0;
 
 		virtual void destroyById(uint64_t id) = 0;
 
+		/**
+		 * @brief Returns whether the slot of an entry can be reused after the
+		 * entry got destroyed.
+		 *
+		 * @param id Handle id
+		 * @return True, if the slot is free, otherwise false
+		 */
+		[[nodiscard]] virtual bool isFreeById(uint64_t id) const {
+			return true;
+		}
+
+		/**
+		 * @brief Destroys an entry by its id and recycles its slot for new
+		 * entries, if the slot is free afterwards.
+		 *
+		 * @param id Handle id
+		 */
+		void recycleById(uint64_t id) {
+			const uint64_t index = (id & HANDLE_INDEX_MASK);
+
+			destroyById(index);
+
+			if ((index >= getCount()) || (!isFreeById(index))) {
+				return;
+			}
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto &slot = getPage(index)->slots [index % HANDLE_PAGE_SIZE];
+
+			if (slot.free) {
+				return;
+			}
+
+			slot.free = true;
+
+			// the maximum generation is skipped to keep ids apart from invalid handles
+			if (++slot.generation == std::numeric_limits<uint32_t>::max()) {
+				slot.generation = 0;
+			}
+
+			m_freeIndices.push_back(index);
+		}
+
+		/**
+		 * @brief Returns whether the destruction of entries needs to be deferred
+		 * until the frame which might still use them has been retired.
+		 *
+		 * @return True, if destruction gets deferred, otherwise false
+		 */
+		[[nodiscard]] virtual bool isDestructionDeferred() const {
+			return true;
+		}
+
+		/**
+		 * @brief Releases an entry by its id after its last handle got dropped.
+		 *
+		 * @param id Handle id
+		 */
+		void releaseById(uint64_t id) {
+			if ((m_core) && (isDestructionDeferred()) &&
+				(deferDestruction(*m_core, [this, id]() { recycleById(id); }))) {
+				return;
+			}
+
+			recycleById(id);
+		}
+
 		void clear() {
-			for (uint64_t id = 0; id < m_entries.size(); id++) {
+			const uint64_t count = getCount();
+
+			for (uint64_t id = 0; id < count; id++) {
 				destroyById(id);
 			}
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_freeIndices.clear();
+
+			for (uint64_t index = 0; index < count; index++) {
+				getPage(index)->slots [index % HANDLE_PAGE_SIZE].free = true;
+				m_freeIndices.push_back(index);
+			}
 		}
 
 	public:
@@ -106,7 +463,9 @@ namespace vkcv {
 		HandleManager &operator=(HandleManager &&other) = delete;
 		HandleManager &operator=(const HandleManager &other) = delete;
 
-		virtual ~HandleManager() noexcept = default;
+		virtual ~HandleManager() noexcept {
+			freePages();
+		}
 	};
 
 } // namespace vkcv
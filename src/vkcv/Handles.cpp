@@ -5,36 +5,67 @@
 
 namespace vkcv {
 
-	void Handle::destroy() {
-		if ((m_rc) && (*m_rc > 0) && (--(*m_rc) == 0)) {
-			if (m_destroy) {
-				m_destroy(m_id);
-			}
+	/**
+	 * @brief Increments a reference counter of handles.
+	 *
+	 * @param[in,out] counter Reference counter
+	 */
+	static void incrementCounter(HandleCounter &counter) {
+#ifdef VKCV_ATOMIC_HANDLES
+		counter.fetch_add(1, std::memory_order_relaxed);
+#else
+		++counter;
+#endif
+	}
 
-			delete m_rc;
+	/**
+	 * @brief Decrements a reference counter of handles.
+	 *
+	 * @param[in,out] counter Reference counter
+	 * @return True, if the last reference got dropped, otherwise false
+	 */
+	static bool decrementCounter(HandleCounter &counter) {
+#ifdef VKCV_ATOMIC_HANDLES
+		return (counter.fetch_sub(1, std::memory_order_acq_rel) == 1);
+#else
+		return (--counter == 0);
+#endif
+	}
+
+	void Handle::destroy() {
+		if ((m_rc) && (decrementCounter(*m_rc)) && (m_owner)) {
+			m_owner->releaseHandle(m_id);
 		}
+
+		m_rc = nullptr;
+		m_owner = nullptr;
 	}
 
-	Handle::Handle() : m_id(std::numeric_limits<uint64_t>::max()), m_rc(nullptr), m_destroy(nullptr) {}
+	Handle::Handle() :
+		m_id(std::numeric_limits<uint64_t>::max()), m_rc(nullptr), m_owner(nullptr) {}
+
+	Handle::Handle(uint64_t id) : m_id(id), m_rc(nullptr), m_owner(nullptr) {}
 
-	Handle::Handle(uint64_t id, const HandleDestroyFunction &destroy) :
-		m_id(id), m_rc(new uint64_t(1)), m_destroy(destroy) {}
+	Handle::Handle(uint64_t id, HandleCounter &counter, HandleOwner &owner) :
+		m_id(id), m_rc(&counter), m_owner(&owner) {
+		incrementCounter(counter);
+	}
 
 	Handle::~Handle() {
 		destroy();
 	}
 
 	Handle::Handle(const Handle &other) :
-		m_id(other.m_id), m_rc(other.m_rc), m_destroy(other.m_destroy) {
+		m_id(other.m_id), m_rc(other.m_rc), m_owner(other.m_owner) {
 		if (m_rc) {
-			++(*m_rc);
+			incrementCounter(*m_rc);
 		}
 	}
 
 	Handle::Handle(Handle &&other) noexcept :
-		m_id(other.m_id), m_rc(other.m_rc), m_destroy(other.m_destroy) {
+		m_id(other.m_id), m_rc(other.m_rc), m_owner(other.m_owner) {
 		other.m_rc = nullptr;
-		other.m_destroy = nullptr;
+		other.m_owner = nullptr;
 	}
 
 	Handle &Handle::operator=(const Handle &other) {
@@ -42,28 +73,32 @@ namespace vkcv {
 			return *this;
 		}
 
+		if (other.m_rc) {
+			incrementCounter(*(other.m_rc));
+		}
+
 		destroy();
 
 		m_id = other.m_id;
 		m_rc = other.m_rc;
-		m_destroy = other.m_destroy;
-
-		if (m_rc) {
-			++(*m_rc);
-		}
+		m_owner = other.m_owner;
 
 		return *this;
 	}
 
 	Handle &Handle::operator=(Handle &&other) noexcept {
+		if (&other == this) {
+			return *this;
+		}
+
 		destroy();
 
 		m_id = other.m_id;
 		m_rc = other.m_rc;
-		m_destroy = other.m_destroy;
+		m_owner = other.m_owner;
 
 		other.m_rc = nullptr;
-		other.m_destroy = nullptr;
+		other.m_owner = nullptr;
 
 		return *this;
 	}
@@ -73,7 +108,7 @@ namespace vkcv {
 	}
 
 	uint64_t Handle::getRC() const {
-		return m_rc ? *m_rc : 0;
+		return m_rc ? static_cast<uint64_t>(*m_rc) : 0;
 	}
 
 	Handle::operator bool() const {
@@ -97,8 +132,8 @@ namespace vkcv {
 		return (getId() == std::numeric_limits<uint64_t>::max() - 1);
 	}
 
-	ImageHandle ImageHandle::createSwapchainImageHandle(const HandleDestroyFunction &destroy) {
-		return ImageHandle(uint64_t(std::numeric_limits<uint64_t>::max() - 1), destroy);
+	ImageHandle ImageHandle::createSwapchainImageHandle() {
+		return ImageHandle(uint64_t(std::numeric_limits<uint64_t>::max() - 1));
 	}
 
 } // namespace vkcv
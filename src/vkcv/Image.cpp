@@ -35,6 +35,68 @@ namespace vkcv {
 		}
 	}
 
+	bool isCompressedFormat(const vk::Format format) {
+		switch (format) {
+		case (vk::Format::eBc1RgbUnormBlock):
+		case (vk::Format::eBc1RgbSrgbBlock):
+		case (vk::Format::eBc1RgbaUnormBlock):
+		case (vk::Format::eBc1RgbaSrgbBlock):
+		case (vk::Format::eBc2UnormBlock):
+		case (vk::Format::eBc2SrgbBlock):
+		case (vk::Format::eBc3UnormBlock):
+		case (vk::Format::eBc3SrgbBlock):
+		case (vk::Format::eBc4UnormBlock):
+		case (vk::Format::eBc4SnormBlock):
+		case (vk::Format::eBc5UnormBlock):
+		case (vk::Format::eBc5SnormBlock):
+		case (vk::Format::eBc6HUfloatBlock):
+		case (vk::Format::eBc6HSfloatBlock):
+		case (vk::Format::eBc7UnormBlock):
+		case (vk::Format::eBc7SrgbBlock):
+		case (vk::Format::eEtc2R8G8B8UnormBlock):
+		case (vk::Format::eEtc2R8G8B8SrgbBlock):
+		case (vk::Format::eEtc2R8G8B8A1UnormBlock):
+		case (vk::Format::eEtc2R8G8B8A1SrgbBlock):
+		case (vk::Format::eEtc2R8G8B8A8UnormBlock):
+		case (vk::Format::eEtc2R8G8B8A8SrgbBlock):
+		case (vk::Format::eEacR11UnormBlock):
+		case (vk::Format::eEacR11SnormBlock):
+		case (vk::Format::eEacR11G11UnormBlock):
+		case (vk::Format::eEacR11G11SnormBlock):
+		case (vk::Format::eAstc4x4UnormBlock):
+		case (vk::Format::eAstc4x4SrgbBlock):
+		case (vk::Format::eAstc5x4UnormBlock):
+		case (vk::Format::eAstc5x4SrgbBlock):
+		case (vk::Format::eAstc5x5UnormBlock):
+		case (vk::Format::eAstc5x5SrgbBlock):
+		case (vk::Format::eAstc6x5UnormBlock):
+		case (vk::Format::eAstc6x5SrgbBlock):
+		case (vk::Format::eAstc6x6UnormBlock):
+		case (vk::Format::eAstc6x6SrgbBlock):
+		case (vk::Format::eAstc8x5UnormBlock):
+		case (vk::Format::eAstc8x5SrgbBlock):
+		case (vk::Format::eAstc8x6UnormBlock):
+		case (vk::Format::eAstc8x6SrgbBlock):
+		case (vk::Format::eAstc8x8UnormBlock):
+		case (vk::Format::eAstc8x8SrgbBlock):
+		case (vk::Format::eAstc10x5UnormBlock):
+		case (vk::Format::eAstc10x5SrgbBlock):
+		case (vk::Format::eAstc10x6UnormBlock):
+		case (vk::Format::eAstc10x6SrgbBlock):
+		case (vk::Format::eAstc10x8UnormBlock):
+		case (vk::Format::eAstc10x8SrgbBlock):
+		case (vk::Format::eAstc10x10UnormBlock):
+		case (vk::Format::eAstc10x10SrgbBlock):
+		case (vk::Format::eAstc12x10UnormBlock):
+		case (vk::Format::eAstc12x10SrgbBlock):
+		case (vk::Format::eAstc12x12UnormBlock):
+		case (vk::Format::eAstc12x12SrgbBlock):
+			return true;
+		default:
+			return false;
+		}
+	}
+
 	vk::Format Image::getFormat() const {
 		return m_core->getImageFormat(m_handle);
 	}
@@ -70,6 +132,13 @@ namespace vkcv {
 	void Image::fillLayer(uint32_t layer, const void* data, size_t size) {
 		m_core->fillImage(m_handle, data, size, layer, 1);
 	}
+	
+	void Image::fillMipLevels(uint32_t firstMipLevel,
+							  uint32_t mipLevelCount,
+							  const void* data,
+							  size_t size) {
+		m_core->fillImage(m_handle, data, size, 0, 0, firstMipLevel, mipLevelCount);
+	}
 
 	void Image::recordMipChainGeneration(const vkcv::CommandStreamHandle &cmdStream,
 										 Downsampler &downsampler) {
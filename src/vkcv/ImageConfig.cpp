@@ -14,6 +14,8 @@ namespace vkcv {
 	  m_height(height),
 	  m_depth(depth),
 	  
+	  m_mipCount(0),
+	  
 	  m_supportStorage(false),
 	  m_supportColorAttachment(false),
 	  m_cubeMapImage(false),
@@ -45,6 +47,14 @@ namespace vkcv {
 		m_depth = depth;
 	}
 	
+	uint32_t ImageConfig::getMipCount() const {
+		return m_mipCount;
+	}
+	
+	void ImageConfig::setMipCount(uint32_t mipCount) {
+		m_mipCount = mipCount;
+	}
+	
 	bool ImageConfig::isSupportingStorage() const {
 		return m_supportStorage;
 	}
@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <numeric>
 #include <sys/types.h>
 
 namespace vkcv {
@@ -30,8 +31,8 @@ namespace vkcv {
 		return handle.getId();
 	}
 	
-	ImageHandle ImageManager::createById(uint64_t id, const HandleDestroyFunction &destroy) {
-		return ImageHandle(id, destroy);
+	ImageHandle ImageManager::createById(uint64_t id, HandleCounter &counter) {
+		return ImageHandle(id, counter, *this);
 	}
 	
 	void ImageManager::destroyById(uint64_t id) {
@@ -39,6 +40,9 @@ namespace vkcv {
 		
 		const vk::Device &device = getCore().getContext().getDevice();
 		
+		invalidateFramebuffers(image.m_viewPerMip);
+		invalidateFramebuffers(image.m_arrayViewPerMip);
+		
 		for (auto &view : image.m_viewPerMip) {
 			if (view) {
 				device.destroyImageView(view);
@@ -74,6 +78,11 @@ namespace vkcv {
 	void ImageManager::recordImageMipGenerationToCmdBuffer(vk::CommandBuffer cmdBuffer,
 														   const ImageHandle &handle) {
 		auto &image = (*this) [handle];
+		
+		// compressed images can't be blitted into, so their mip levels need to be prebuilt
+		if (isCompressedFormat(image.m_format)) {
+			return;
+		}
 
 		vk::ImageAspectFlags aspectFlags;
 		if (isDepthFormat(image.m_format)) {
@@ -139,11 +148,17 @@ namespace vkcv {
 	
 	ImageManager::ImageManager() noexcept :
 			HandleManager<ImageEntry, ImageHandle>(), m_bufferManager(nullptr), m_swapchainImages(),
-			m_currentSwapchainInputImage(0) {}
+			m_currentSwapchainInputImage(0), m_framebuffers() {}
 	
 	ImageManager::~ImageManager() noexcept {
 		clear();
 		
+		for (const auto &framebuffer : m_framebuffers) {
+			getCore().getContext().getDevice().destroyFramebuffer(framebuffer.m_handle);
+		}
+		
+		m_framebuffers.clear();
+		
 		for (const auto &swapchainImage : m_swapchainImages) {
 			for (const auto view : swapchainImage.m_viewPerMip) {
 				getCore().getContext().getDevice().destroy(view);
@@ -414,6 +429,42 @@ namespace vkcv {
 		return info.deviceMemory;
 	}
 	
+	void ImageManager::setDebugLabel(const ImageHandle &handle, const std::string &label) {
+		if (handle.isSwapchainImage()) {
+			return;
+		}
+		
+		auto &image = (*this) [handle];
+		
+		if (!image.m_allocation) {
+			return;
+		}
+		
+		const vma::Allocator &allocator = getCore().getContext().getAllocator();
+		allocator.setAllocationName(image.m_allocation, label.c_str());
+	}
+	
+	void ImageManager::appendMemoryStatistics(MemoryStatistics &statistics) const {
+		const vma::Allocator &allocator = getCore().getContext().getAllocator();
+		const uint64_t count = getCount();
+		
+		for (uint64_t id = 0; id < count; id++) {
+			const auto &image = getById(id);
+			
+			if ((!image.m_handle) || (!image.m_allocation)) {
+				continue;
+			}
+			
+			const auto info = allocator.getAllocationInfo(image.m_allocation);
+			
+			addMemoryUsage(statistics.imageFormats [image.m_format], info.size);
+			
+			if ((info.pName) && (*(info.pName))) {
+				addMemoryUsage(statistics.labels [info.pName], info.size);
+			}
+		}
+	}
+	
 	vk::ImageView ImageManager::getVulkanImageView(const ImageHandle &handle, size_t mipLevel,
 												   bool arrayView) const {
 		if (handle.isSwapchainImage()) {
@@ -633,23 +684,176 @@ namespace vkcv {
 		}
 	}
 	
-	constexpr uint32_t getBytesPerPixel(vk::Format format) {
+	/**
+	 * @brief Structure describing the blocks of texels an image format
+	 * is stored in, uncompressed formats use blocks of a single texel.
+	 */
+	struct FormatBlock {
+		uint32_t width;
+		uint32_t height;
+		uint32_t size;
+	};
+	
+	constexpr FormatBlock getFormatBlock(vk::Format format) {
 		switch (format) {
 			case vk::Format::eR8Unorm:
-				return 1;
+				return { 1, 1, 1 };
 			case vk::Format::eR16Unorm:
-				return 2;
+			case vk::Format::eR8G8Unorm:
+				return { 1, 1, 2 };
 			case vk::Format::eR32Uint:
+			case vk::Format::eR32Sfloat:
 			case vk::Format::eR8G8B8A8Srgb:
 			case vk::Format::eR8G8B8A8Unorm:
-				return 4;
+			case vk::Format::eB8G8R8A8Srgb:
+			case vk::Format::eB8G8R8A8Unorm:
+				return { 1, 1, 4 };
+			case vk::Format::eR16G16B16A16Unorm:
 			case vk::Format::eR16G16B16A16Sfloat:
-				return 8;
+				return { 1, 1, 8 };
 			case vk::Format::eR32G32B32A32Sfloat:
-				return 16;
+				return { 1, 1, 16 };
+			case vk::Format::eBc1RgbUnormBlock:
+			case vk::Format::eBc1RgbSrgbBlock:
+			case vk::Format::eBc1RgbaUnormBlock:
+			case vk::Format::eBc1RgbaSrgbBlock:
+			case vk::Format::eBc4UnormBlock:
+			case vk::Format::eBc4SnormBlock:
+			case vk::Format::eEtc2R8G8B8UnormBlock:
+			case vk::Format::eEtc2R8G8B8SrgbBlock:
+			case vk::Format::eEtc2R8G8B8A1UnormBlock:
+			case vk::Format::eEtc2R8G8B8A1SrgbBlock:
+			case vk::Format::eEacR11UnormBlock:
+			case vk::Format::eEacR11SnormBlock:
+				return { 4, 4, 8 };
+			case vk::Format::eBc2UnormBlock:
+			case vk::Format::eBc2SrgbBlock:
+			case vk::Format::eBc3UnormBlock:
+			case vk::Format::eBc3SrgbBlock:
+			case vk::Format::eBc5UnormBlock:
+			case vk::Format::eBc5SnormBlock:
+			case vk::Format::eBc6HUfloatBlock:
+			case vk::Format::eBc6HSfloatBlock:
+			case vk::Format::eBc7UnormBlock:
+			case vk::Format::eBc7SrgbBlock:
+			case vk::Format::eEtc2R8G8B8A8UnormBlock:
+			case vk::Format::eEtc2R8G8B8A8SrgbBlock:
+			case vk::Format::eEacR11G11UnormBlock:
+			case vk::Format::eEacR11G11SnormBlock:
+			case vk::Format::eAstc4x4UnormBlock:
+			case vk::Format::eAstc4x4SrgbBlock:
+				return { 4, 4, 16 };
+			case vk::Format::eAstc5x4UnormBlock:
+			case vk::Format::eAstc5x4SrgbBlock:
+				return { 5, 4, 16 };
+			case vk::Format::eAstc5x5UnormBlock:
+			case vk::Format::eAstc5x5SrgbBlock:
+				return { 5, 5, 16 };
+			case vk::Format::eAstc6x5UnormBlock:
+			case vk::Format::eAstc6x5SrgbBlock:
+				return { 6, 5, 16 };
+			case vk::Format::eAstc6x6UnormBlock:
+			case vk::Format::eAstc6x6SrgbBlock:
+				return { 6, 6, 16 };
+			case vk::Format::eAstc8x5UnormBlock:
+			case vk::Format::eAstc8x5SrgbBlock:
+				return { 8, 5, 16 };
+			case vk::Format::eAstc8x6UnormBlock:
+			case vk::Format::eAstc8x6SrgbBlock:
+				return { 8, 6, 16 };
+			case vk::Format::eAstc8x8UnormBlock:
+			case vk::Format::eAstc8x8SrgbBlock:
+				return { 8, 8, 16 };
+			case vk::Format::eAstc10x5UnormBlock:
+			case vk::Format::eAstc10x5SrgbBlock:
+				return { 10, 5, 16 };
+			case vk::Format::eAstc10x6UnormBlock:
+			case vk::Format::eAstc10x6SrgbBlock:
+				return { 10, 6, 16 };
+			case vk::Format::eAstc10x8UnormBlock:
+			case vk::Format::eAstc10x8SrgbBlock:
+				return { 10, 8, 16 };
+			case vk::Format::eAstc10x10UnormBlock:
+			case vk::Format::eAstc10x10SrgbBlock:
+				return { 10, 10, 16 };
+			case vk::Format::eAstc12x10UnormBlock:
+			case vk::Format::eAstc12x10SrgbBlock:
+				return { 12, 10, 16 };
+			case vk::Format::eAstc12x12UnormBlock:
+			case vk::Format::eAstc12x12SrgbBlock:
+				return { 12, 12, 16 };
 			default:
 				std::cerr << "Unknown image format" << std::endl;
-				return 4;
+				return { 1, 1, 4 };
+		}
+	}
+	
+	/**
+	 * @brief Structure describing the copy of a single mip level from
+	 * tightly packed image data.
+	 */
+	struct ImageLevelCopy {
+		size_t offset;
+		uint32_t mipLevel;
+		vk::Extent3D extent;
+	};
+	
+	/**
+	 * @brief Returns the copies of all mip levels in a given range which
+	 * are fully covered by image data of a given size. Each mip level is
+	 * expected to contain all filled array layers after another.
+	 *
+	 * @param image Image entry
+	 * @param size Size of the image data in bytes
+	 * @param firstMipLevel First mip level to fill
+	 * @param mipLevelCount Amount of mip levels to fill
+	 * @param arrayLayerCount Amount of array layers to fill
+	 * @param copySize Size of the covered image data in bytes
+	 * @return Copies of the covered mip levels
+	 */
+	static Vector<ImageLevelCopy> getImageLevelCopies(const ImageEntry& image,
+													  size_t size,
+													  uint32_t firstMipLevel,
+													  uint32_t mipLevelCount,
+													  uint32_t arrayLayerCount,
+													  size_t& copySize) {
+		const FormatBlock block = getFormatBlock(image.m_format);
+		
+		Vector<ImageLevelCopy> copies;
+		copies.reserve(mipLevelCount);
+		copySize = 0;
+		
+		for (uint32_t i = 0; i < mipLevelCount; i++) {
+			const uint32_t mipLevel = firstMipLevel + i;
+			
+			const vk::Extent3D extent (
+					std::max<uint32_t>(image.m_width >> mipLevel, 1),
+					std::max<uint32_t>(image.m_height >> mipLevel, 1),
+					std::max<uint32_t>(image.m_depth >> mipLevel, 1)
+			);
+			
+			const size_t levelSize = (
+					static_cast<size_t>((extent.width + block.width - 1) / block.width) *
+					static_cast<size_t>((extent.height + block.height - 1) / block.height) *
+					extent.depth * arrayLayerCount * block.size
+			);
+			
+			if (copySize + levelSize > size) {
+				break;
+			}
+			
+			copies.push_back({ copySize, mipLevel, extent });
+			copySize += levelSize;
+		}
+		
+		return copies;
+	}
+	
+	static vk::ImageAspectFlags getImageAspectFlags(vk::Format format) {
+		if (isDepthImageFormat(format)) {
+			return vk::ImageAspectFlagBits::eDepth;
+		} else {
+			return vk::ImageAspectFlagBits::eColor;
 		}
 	}
 
@@ -661,7 +865,8 @@ namespace vkcv {
 										  const void* data, 
 										  size_t size,
 										  uint32_t baseArrayLayer,
-										  uint32_t arrayLayerCount) {
+										  uint32_t arrayLayerCount,
+										  const Vector<ImageLevelCopy>& copies) {
 		imageManager.switchImageLayoutImmediate(handle, vk::ImageLayout::eTransferDstOptimal);
 		
 		BufferHandle bufferHandle = bufferManager.createBuffer(
@@ -676,31 +881,32 @@ namespace vkcv {
 		
 		core.recordCommandsToStream(
 				stream,
-				[&image, &stagingBuffer, &baseArrayLayer, &arrayLayerCount]
+				[&image, &stagingBuffer, &baseArrayLayer, &arrayLayerCount, &copies]
 						(const vk::CommandBuffer &commandBuffer) {
-					vk::ImageAspectFlags aspectFlags;
+					const vk::ImageAspectFlags aspectFlags = getImageAspectFlags(image.m_format);
 					
-					if (isDepthImageFormat(image.m_format)) {
-						aspectFlags = vk::ImageAspectFlagBits::eDepth;
-					} else {
-						aspectFlags = vk::ImageAspectFlagBits::eColor;
+					Vector<vk::BufferImageCopy2> regions;
+					regions.reserve(copies.size());
+					
+					for (const auto& copy : copies) {
+						regions.emplace_back(
+								copy.offset,
+								0,
+								0,
+								vk::ImageSubresourceLayers(
+										aspectFlags, copy.mipLevel, baseArrayLayer, arrayLayerCount
+								),
+								vk::Offset3D(0, 0, 0),
+								copy.extent
+						);
 					}
-
-					const vk::BufferImageCopy2 region2(
-							0,
-							0,
-							0,
-							vk::ImageSubresourceLayers(aspectFlags, 0, baseArrayLayer, arrayLayerCount),
-							vk::Offset3D(0, 0, 0),
-							vk::Extent3D(image.m_width, image.m_height, image.m_depth)
-					);
 					
 					const vk::CopyBufferToImageInfo2 copyInfo(
 							stagingBuffer,
 							image.m_handle,
 							vk::ImageLayout::eTransferDstOptimal,
-							1,
-							&region2
+							static_cast<uint32_t>(regions.size()),
+							regions.data()
 					);
 
 					commandBuffer.copyBufferToImage2(&copyInfo);
@@ -713,40 +919,167 @@ namespace vkcv {
 		core.submitCommandStream(stream, false);
 	}
 
+	/**
+	 * @brief Records the upload of an image from the staging buffer into the
+	 * pending uploads, finally switching it to a layout for sampling.
+	 *
+	 * @param core Core instance
+	 * @param imageManager Image manager
+	 * @param bufferManager Buffer manager
+	 * @param handle Image handle
+	 * @param stagingOffset Offset of the data in the staging buffer
+	 * @param baseArrayLayer First array layer to fill
+	 * @param arrayLayerCount Amount of array layers to fill
+	 * @param copies Copies of the mip levels to fill
+	 */
+	static void fillImageViaStagingBuffer(Core& core,
+										  ImageManager& imageManager,
+										  BufferManager& bufferManager,
+										  const ImageHandle& handle,
+										  size_t stagingOffset,
+										  uint32_t baseArrayLayer,
+										  uint32_t arrayLayerCount,
+										  const Vector<ImageLevelCopy>& copies) {
+		const auto &queueManager = core.getContext().getQueueManager();
+		const Queue transferQueue = queueManager.getTransferQueues().front();
+		const Queue graphicsQueue = queueManager.getGraphicsQueues().front();
+
+		const bool sameQueue = (transferQueue.handle == graphicsQueue.handle);
+		const bool ownershipTransfer = (transferQueue.familyIndex != graphicsQueue.familyIndex);
+		const vk::Buffer stagingBuffer = bufferManager.getStagingBuffer();
+
+		Vector<vk::ImageMemoryBarrier> ownershipBarriers;
+
+		core.recordCommandsToStream(
+				bufferManager.getStagingStream(),
+				[&](const vk::CommandBuffer &commandBuffer) {
+					imageManager.recordImageLayoutTransition(
+							handle, 0, 0, vk::ImageLayout::eTransferDstOptimal, commandBuffer
+					);
+
+					const vk::Image image = imageManager.getVulkanImage(handle);
+					const vk::ImageAspectFlags aspectFlags = getImageAspectFlags(
+							imageManager.getImageFormat(handle)
+					);
+
+					Vector<vk::BufferImageCopy> regions;
+					regions.reserve(copies.size());
+					
+					for (const auto& copy : copies) {
+						regions.emplace_back(
+								stagingOffset + copy.offset,
+								0,
+								0,
+								vk::ImageSubresourceLayers(
+										aspectFlags, copy.mipLevel, baseArrayLayer, arrayLayerCount
+								),
+								vk::Offset3D(0, 0, 0),
+								copy.extent
+						);
+					}
+
+					commandBuffer.copyBufferToImage(
+							stagingBuffer, image, vk::ImageLayout::eTransferDstOptimal, regions
+					);
+
+					if (sameQueue) {
+						imageManager.recordImageLayoutTransition(
+								handle, 0, 0, vk::ImageLayout::eShaderReadOnlyOptimal, commandBuffer
+						);
+
+						return;
+					} else if (!ownershipTransfer) {
+						return;
+					}
+
+					// the layout transition happens as part of the ownership transfer
+					ownershipBarriers = imageManager.createImageOwnershipTransferBarriers(
+							handle,
+							vk::ImageLayout::eShaderReadOnlyOptimal,
+							transferQueue.familyIndex,
+							graphicsQueue.familyIndex
+					);
+
+					commandBuffer.pipelineBarrier(
+							vk::PipelineStageFlagBits::eTransfer,
+							vk::PipelineStageFlagBits::eBottomOfPipe,
+							{},
+							nullptr,
+							nullptr,
+							ownershipBarriers
+					);
+				},
+				nullptr
+		);
+
+		if (sameQueue) {
+			return;
+		} else if (!ownershipTransfer) {
+			// the transition after the semaphore wait makes later graphics work depend on the copy
+			core.recordCommandsToStream(
+					bufferManager.getAcquireStream(),
+					[&](const vk::CommandBuffer &commandBuffer) {
+						imageManager.recordImageLayoutTransition(
+								handle, 0, 0, vk::ImageLayout::eShaderReadOnlyOptimal, commandBuffer
+						);
+					},
+					nullptr
+			);
+
+			return;
+		}
+
+		core.recordCommandsToStream(
+				bufferManager.getAcquireStream(),
+				[&ownershipBarriers](const vk::CommandBuffer &commandBuffer) {
+					commandBuffer.pipelineBarrier(
+							vk::PipelineStageFlagBits::eTopOfPipe,
+							vk::PipelineStageFlagBits::eAllCommands,
+							{},
+							nullptr,
+							nullptr,
+							ownershipBarriers
+					);
+				},
+				nullptr
+		);
+	}
+
 	static void fillImageFromHost(Core& core, 
 								  ImageManager& imageManager, 
 								  const ImageEntry& image,
 								  const ImageHandle& handle,
 								  const void* data, 
 								  uint32_t baseArrayLayer, 
-								  uint32_t arrayLayerCount) {
+								  uint32_t arrayLayerCount,
+								  const Vector<ImageLevelCopy>& copies) {
 		imageManager.switchImageLayoutImmediate(handle, vk::ImageLayout::eTransferDstOptimal);
 
 		const auto &dynamicDispatch = core.getContext().getDispatchLoaderDynamic();
-		
-		vk::ImageAspectFlags aspectFlags;
+		const vk::ImageAspectFlags aspectFlags = getImageAspectFlags(image.m_format);
 
-		if (isDepthImageFormat(image.m_format)) {
-			aspectFlags = vk::ImageAspectFlagBits::eDepth;
-		} else {
-			aspectFlags = vk::ImageAspectFlagBits::eColor;
+		Vector<vk::MemoryToImageCopyEXT> regions;
+		regions.reserve(copies.size());
+		
+		for (const auto& copy : copies) {
+			regions.emplace_back(
+					static_cast<const uint8_t*>(data) + copy.offset,
+					0,
+					0,
+					vk::ImageSubresourceLayers(
+							aspectFlags, copy.mipLevel, baseArrayLayer, arrayLayerCount
+					),
+					vk::Offset3D(0, 0, 0),
+					copy.extent
+			);
 		}
 
-		const vk::MemoryToImageCopyEXT region(
-				data,
-				0,
-				0,
-				vk::ImageSubresourceLayers(aspectFlags, 0, baseArrayLayer, arrayLayerCount),
-				vk::Offset3D(0, 0, 0),
-				vk::Extent3D(image.m_width, image.m_height, image.m_depth)
-		);
-
 		const vk::CopyMemoryToImageInfoEXT copyInfo(
 				vk::HostImageCopyFlagsEXT(),
 				image.m_handle,
 				vk::ImageLayout::eTransferDstOptimal,
-				1,
-				&region
+				static_cast<uint32_t>(regions.size()),
+				regions.data()
 		);
 
 		core.getContext().getDevice().copyMemoryToImageEXT(copyInfo, dynamicDispatch);
@@ -758,7 +1091,9 @@ namespace vkcv {
 								 const void* data,
 								 size_t size,
 								 uint32_t firstLayer,
-								 uint32_t layerCount) {
+								 uint32_t layerCount,
+								 uint32_t firstMipLevel,
+								 uint32_t mipLevelCount) {
 		if (handle.isSwapchainImage()) {
 			vkcv_log(LogLevel::ERROR, "Swapchain image cannot be filled");
 			return;
@@ -781,11 +1116,29 @@ namespace vkcv {
 			arrayLayerCount = imageLayerCount - baseArrayLayer;
 		}
 		
-		const size_t image_size = (
-				image.m_width * image.m_height * image.m_depth * getBytesPerPixel(image.m_format)
+		const auto imageMipCount = static_cast<uint32_t>(image.m_viewPerMip.size());
+		
+		if (firstMipLevel >= imageMipCount) {
+			return;
+		}
+		
+		uint32_t levelCount;
+		
+		if (mipLevelCount > 0) {
+			levelCount = std::min<uint32_t>(mipLevelCount, imageMipCount - firstMipLevel);
+		} else {
+			levelCount = imageMipCount - firstMipLevel;
+		}
+		
+		size_t max_size;
+		const auto copies = getImageLevelCopies(
+				image, size, firstMipLevel, levelCount, arrayLayerCount, max_size
 		);
 		
-		const size_t max_size = std::min(size, image_size);
+		if (copies.empty()) {
+			vkcv_log(LogLevel::ERROR, "Image data is too small to fill a mip level");
+			return;
+		}
 
 		auto& core = getCore();
 
@@ -797,9 +1150,11 @@ namespace vkcv {
 				handle, 
 				data, 
 				baseArrayLayer, 
-				arrayLayerCount
+				arrayLayerCount,
+				copies
 			);
-		} else {
+		} else
+		if (max_size > getBufferManager().getStagingBufferSize()) {
 			fillImageViaCommandBuffer(
 				core, 
 				(*this), 
@@ -809,10 +1164,49 @@ namespace vkcv {
 				data, 
 				max_size, 
 				baseArrayLayer, 
-				arrayLayerCount
+				arrayLayerCount,
+				copies
+			);
+		} else {
+			const size_t stagingOffset = getBufferManager().stageData(
+				data,
+				max_size,
+				std::lcm<size_t>(16, getFormatBlock(image.m_format).size)
+			);
+
+			fillImageViaStagingBuffer(
+				core,
+				(*this),
+				getBufferManager(),
+				handle,
+				stagingOffset,
+				baseArrayLayer,
+				arrayLayerCount,
+				copies
 			);
 		}
 	}
+
+	Vector<vk::ImageMemoryBarrier> ImageManager::createImageOwnershipTransferBarriers(
+			const ImageHandle &handle, vk::ImageLayout newLayout,
+			uint32_t srcQueueFamily, uint32_t dstQueueFamily) {
+		auto &image = (*this) [handle];
+
+		auto barriers = createImageLayoutTransitionBarriers(image, 0, 0, newLayout, false);
+
+		for (auto& barrier : barriers) {
+			barrier.srcQueueFamilyIndex = srcQueueFamily;
+			barrier.dstQueueFamilyIndex = dstQueueFamily;
+
+			for (uint32_t i = 0; i < barrier.subresourceRange.layerCount; i++) {
+				for (uint32_t j = 0; j < barrier.subresourceRange.levelCount; j++) {
+					image.m_layers[barrier.subresourceRange.baseArrayLayer + i].m_layouts[barrier.subresourceRange.baseMipLevel + j] = newLayout;
+				}
+			}
+		}
+
+		return barriers;
+	}
 	
 	void ImageManager::recordImageMipChainGenerationToCmdStream(
 			const vkcv::CommandStreamHandle &cmdStream, const ImageHandle &handle) {
@@ -904,6 +1298,8 @@ namespace vkcv {
 		
 		// destroy old views
 		for (const auto &image : m_swapchainImages) {
+			invalidateFramebuffers(image.m_viewPerMip);
+			
 			for (const auto &view : image.m_viewPerMip) {
 				getCore().getContext().getDevice().destroyImageView(view);
 			}
@@ -939,4 +1335,79 @@ namespace vkcv {
 		}
 	}
 	
+	vk::Framebuffer ImageManager::getFramebuffer(const Vector<ImageHandle> &renderTargets,
+												 const vk::Extent2D &extent,
+												 const vk::RenderPass &renderPass) {
+		Vector<vk::ImageView> attachments;
+		attachments.reserve(renderTargets.size());
+		
+		for (const ImageHandle &handle : renderTargets) {
+			attachments.push_back(getVulkanImageView(handle));
+		}
+		
+		for (const auto &framebuffer : m_framebuffers) {
+			if ((framebuffer.m_renderPass == renderPass) &&
+				(framebuffer.m_extent == extent) &&
+				(framebuffer.m_attachments == attachments)) {
+				return framebuffer.m_handle;
+			}
+		}
+		
+		const vk::FramebufferCreateInfo createInfo(
+				{},
+				renderPass,
+				static_cast<uint32_t>(attachments.size()),
+				attachments.data(),
+				extent.width,
+				extent.height,
+				1
+		);
+		
+		const vk::Framebuffer framebuffer = getCore().getContext().getDevice().createFramebuffer(
+				createInfo
+		);
+		
+		if (framebuffer) {
+			m_framebuffers.push_back({ renderPass, attachments, extent, framebuffer });
+		}
+		
+		return framebuffer;
+	}
+	
+	void ImageManager::invalidateFramebuffers(const vk::RenderPass &renderPass) {
+		const vk::Device &device = getCore().getContext().getDevice();
+		
+		for (size_t i = 0; i < m_framebuffers.size();) {
+			if (m_framebuffers[i].m_renderPass == renderPass) {
+				device.destroyFramebuffer(m_framebuffers[i].m_handle);
+				m_framebuffers.erase(m_framebuffers.begin() + i);
+			} else {
+				i++;
+			}
+		}
+	}
+	
+	void ImageManager::invalidateFramebuffers(const Vector<vk::ImageView> &views) {
+		const vk::Device &device = getCore().getContext().getDevice();
+		
+		for (size_t i = 0; i < m_framebuffers.size();) {
+			const auto &attachments = m_framebuffers[i].m_attachments;
+			
+			const bool used = std::any_of(
+					attachments.begin(),
+					attachments.end(),
+					[&views](const vk::ImageView &attachment) {
+						return std::find(views.begin(), views.end(), attachment) != views.end();
+					}
+			);
+			
+			if (used) {
+				device.destroyFramebuffer(m_framebuffers[i].m_handle);
+				m_framebuffers.erase(m_framebuffers.begin() + i);
+			} else {
+				i++;
+			}
+		}
+	}
+	
 } // namespace vkcv
\ No newline at end of file
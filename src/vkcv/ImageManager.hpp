@@ -13,6 +13,7 @@
 
 #include "vkcv/Container.hpp"
 #include "vkcv/ImageConfig.hpp"
+#include "vkcv/MemoryStatistics.hpp"
 
 namespace vkcv {
 
@@ -46,6 +47,14 @@ namespace vkcv {
 		bool m_accessible;
 	};
 
+	struct FramebufferEntry {
+		vk::RenderPass m_renderPass;
+		Vector<vk::ImageView> m_attachments;
+		vk::Extent2D m_extent;
+
+		vk::Framebuffer m_handle;
+	};
+
 	/**
 	 * @brief Class to manage the creation, destruction, allocation
 	 * and filling of images.
@@ -59,13 +68,15 @@ namespace vkcv {
 		Vector<ImageEntry> m_swapchainImages;
 		int m_currentSwapchainInputImage;
 
+		Vector<FramebufferEntry> m_framebuffers;
+
 		using HandleManager<ImageEntry, ImageHandle>::init;
 		bool init(Core &core, BufferManager &bufferManager);
 
 		[[nodiscard]] uint64_t getIdFrom(const ImageHandle &handle) const override;
 
 		[[nodiscard]] ImageHandle createById(uint64_t id,
-											 const HandleDestroyFunction &destroy) override;
+											 HandleCounter &counter) override;
 
 		/**
 		 * Destroys and deallocates image represented by a given
@@ -82,6 +93,13 @@ namespace vkcv {
 		void recordImageMipGenerationToCmdBuffer(vk::CommandBuffer cmdBuffer,
 												 const ImageHandle &handle);
 
+		/**
+		 * @brief Destroys all cached framebuffers using any of the given image views.
+		 *
+		 * @param[in] views Image views
+		 */
+		void invalidateFramebuffers(const Vector<vk::ImageView> &views);
+
 	protected:
 		[[nodiscard]] virtual const ImageEntry &
 		operator[](const ImageHandle &handle) const override;
@@ -101,6 +119,25 @@ namespace vkcv {
 
 		[[nodiscard]] vk::DeviceMemory getVulkanDeviceMemory(const ImageHandle &handle) const;
 
+		/**
+		 * @brief Sets a debug label as name of the memory allocation of an
+		 * image represented by a given image handle, so its memory gets
+		 * accounted per label.
+		 *
+		 * @param[in] handle Image handle
+		 * @param[in] label Debug label
+		 */
+		void setDebugLabel(const ImageHandle &handle, const std::string &label);
+
+		/**
+		 * @brief Adds the memory used by all images to given memory
+		 * statistics per image format and debug label. Swapchain images
+		 * are not included.
+		 *
+		 * @param[in,out] statistics Memory statistics
+		 */
+		void appendMemoryStatistics(MemoryStatistics &statistics) const;
+
 		[[nodiscard]] vk::ImageView getVulkanImageView(const ImageHandle &handle,
 													   size_t mipLevel = 0,
 													   bool arrayView = false) const;
@@ -117,11 +154,30 @@ namespace vkcv {
 					   const void* data,
 					   size_t size,
 					   uint32_t firstLayer,
-					   uint32_t layerCount);
+					   uint32_t layerCount,
+					   uint32_t firstMipLevel,
+					   uint32_t mipLevelCount);
 
 		void recordImageMipChainGenerationToCmdStream(const vkcv::CommandStreamHandle &cmdStream,
 													  const ImageHandle &handle);
 
+		/**
+		 * @brief Creates the barriers to transfer the ownership of all subresources
+		 * of an image between queue families while switching to a new layout.
+		 * The tracked layouts are updated as if the barriers were recorded.
+		 *
+		 * @param[in] handle Image handle
+		 * @param[in] newLayout New image layout
+		 * @param[in] srcQueueFamily Queue family releasing the image
+		 * @param[in] dstQueueFamily Queue family acquiring the image
+		 * @return Image memory barriers
+		 */
+		[[nodiscard]] Vector<vk::ImageMemoryBarrier>
+		createImageOwnershipTransferBarriers(const ImageHandle &handle,
+											 vk::ImageLayout newLayout,
+											 uint32_t srcQueueFamily,
+											 uint32_t dstQueueFamily);
+
 		void recordMSAAResolve(vk::CommandBuffer cmdBuffer, const ImageHandle &src,
 							   const ImageHandle &dst);
 
@@ -148,5 +204,26 @@ namespace vkcv {
 		// if manual vulkan work, e.g. ImGui integration, changes an image layout this function must
 		// be used to update the internal image state
 		void updateImageLayoutManual(const vkcv::ImageHandle &handle, vk::ImageLayout layout);
+
+		/**
+		 * @brief Returns a framebuffer for a given render pass using images
+		 * as attachments. Framebuffers get cached until any of their images
+		 * or their render pass gets destroyed.
+		 *
+		 * @param[in] renderTargets Image handles of the attachments
+		 * @param[in] extent Extent of the framebuffer
+		 * @param[in] renderPass Vulkan render pass
+		 * @return Vulkan framebuffer
+		 */
+		[[nodiscard]] vk::Framebuffer getFramebuffer(const Vector<ImageHandle> &renderTargets,
+													 const vk::Extent2D &extent,
+													 const vk::RenderPass &renderPass);
+
+		/**
+		 * @brief Destroys all cached framebuffers using a given render pass.
+		 *
+		 * @param[in] renderPass Vulkan render pass
+		 */
+		void invalidateFramebuffers(const vk::RenderPass &renderPass);
 	};
 } // namespace vkcv
\ No newline at end of file
@@ -0,0 +1,143 @@
+
+#include "vkcv/MemoryStatistics.hpp"
+
+#include <sstream>
+
+namespace vkcv {
+
+	static const char* getBufferTypeName(BufferType type) {
+		switch (type) {
+		case BufferType::INDEX:
+			return "INDEX";
+		case BufferType::VERTEX:
+			return "VERTEX";
+		case BufferType::UNIFORM:
+			return "UNIFORM";
+		case BufferType::STORAGE:
+			return "STORAGE";
+		case BufferType::STAGING:
+			return "STAGING";
+		case BufferType::INDIRECT:
+			return "INDIRECT";
+		case BufferType::SHADER_BINDING:
+			return "SHADER_BINDING";
+		case BufferType::ACCELERATION_STRUCTURE_INPUT:
+			return "ACCELERATION_STRUCTURE_INPUT";
+		case BufferType::ACCELERATION_STRUCTURE_STORAGE:
+			return "ACCELERATION_STRUCTURE_STORAGE";
+		default:
+			return "UNKNOWN";
+		}
+	}
+
+	static void writeJSONString(std::ostringstream &stream, const std::string &value) {
+		stream << '"';
+
+		for (const char c : value) {
+			switch (c) {
+			case '"':
+				stream << "\\\"";
+				break;
+			case '\\':
+				stream << "\\\\";
+				break;
+			case '\n':
+				stream << "\\n";
+				break;
+			case '\r':
+				stream << "\\r";
+				break;
+			case '\t':
+				stream << "\\t";
+				break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20) {
+					stream << "\\u00";
+					stream << "0123456789abcdef" [(c >> 4) & 0xF];
+					stream << "0123456789abcdef" [c & 0xF];
+				} else {
+					stream << c;
+				}
+				break;
+			}
+		}
+
+		stream << '"';
+	}
+
+	static void writeJSONUsage(std::ostringstream &stream, const std::string &name,
+							   const MemoryUsage &usage) {
+		writeJSONString(stream, name);
+		stream << ":{\"bytes\":" << usage.bytes << ",\"count\":" << usage.count << '}';
+	}
+
+	void addMemoryUsage(MemoryUsage &usage, size_t bytes) {
+		usage.bytes += bytes;
+		usage.count++;
+	}
+
+	std::string memoryStatisticsToJSON(const MemoryStatistics &statistics) {
+		std::ostringstream stream;
+
+		stream << "{\"budgetSupported\":" << (statistics.budgetSupported ? "true" : "false");
+		stream << ",\"heaps\":[";
+
+		for (size_t i = 0; i < statistics.heaps.size(); i++) {
+			const auto &heap = statistics.heaps [i];
+
+			if (i > 0) {
+				stream << ',';
+			}
+
+			stream << "{\"index\":" << i
+				   << ",\"deviceLocal\":" << (heap.deviceLocal ? "true" : "false")
+				   << ",\"size\":" << heap.size
+				   << ",\"usage\":" << heap.usage
+				   << ",\"budget\":" << heap.budget
+				   << ",\"blockBytes\":" << heap.blockBytes
+				   << ",\"allocationBytes\":" << heap.allocationBytes
+				   << ",\"blockCount\":" << heap.blockCount
+				   << ",\"allocationCount\":" << heap.allocationCount << '}';
+		}
+
+		stream << "],\"bufferTypes\":{";
+
+		bool first = true;
+		for (const auto &entry : statistics.bufferTypes) {
+			if (!first) {
+				stream << ',';
+			}
+
+			writeJSONUsage(stream, getBufferTypeName(entry.first), entry.second);
+			first = false;
+		}
+
+		stream << "},\"imageFormats\":{";
+
+		first = true;
+		for (const auto &entry : statistics.imageFormats) {
+			if (!first) {
+				stream << ',';
+			}
+
+			writeJSONUsage(stream, vk::to_string(entry.first), entry.second);
+			first = false;
+		}
+
+		stream << "},\"labels\":{";
+
+		first = true;
+		for (const auto &entry : statistics.labels) {
+			if (!first) {
+				stream << ',';
+			}
+
+			writeJSONUsage(stream, entry.first, entry.second);
+			first = false;
+		}
+
+		stream << "}}";
+		return stream.str();
+	}
+
+} // namespace vkcv
@@ -42,10 +42,11 @@ namespace vkcv {
 		return m_clear_value;
 	}
 
-	PassConfig::PassConfig() : m_attachments(), m_multisampling(Multisampling::None) {}
+	PassConfig::PassConfig() :
+		m_attachments(), m_multisampling(Multisampling::None), m_dynamicRendering(false) {}
 
 	PassConfig::PassConfig(const AttachmentDescriptions &attachments, Multisampling multisampling) :
-		m_attachments(attachments), m_multisampling(multisampling) {}
+		m_attachments(attachments), m_multisampling(multisampling), m_dynamicRendering(false) {}
 
 	const AttachmentDescriptions &PassConfig::getAttachments() const {
 		return m_attachments;
@@ -59,4 +60,12 @@ namespace vkcv {
 		return m_multisampling;
 	}
 
+	void PassConfig::setDynamicRendering(bool dynamicRendering) {
+		m_dynamicRendering = dynamicRendering;
+	}
+
+	bool PassConfig::isDynamicRendering() const {
+		return m_dynamicRendering;
+	}
+
 } // namespace vkcv
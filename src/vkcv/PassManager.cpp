@@ -1,4 +1,5 @@
 #include "PassManager.hpp"
+#include "ImageManager.hpp"
 #include "vkcv/Core.hpp"
 #include "vkcv/Image.hpp"
 
@@ -24,24 +25,36 @@ namespace vkcv {
 		}
 	}
 
+	bool PassManager::init(Core &core, ImageManager &imageManager) {
+		if (!HandleManager<PassEntry, PassHandle>::init(core)) {
+			return false;
+		}
+
+		m_imageManager = &imageManager;
+		return true;
+	}
+
 	uint64_t PassManager::getIdFrom(const PassHandle &handle) const {
 		return handle.getId();
 	}
 
-	PassHandle PassManager::createById(uint64_t id, const HandleDestroyFunction &destroy) {
-		return PassHandle(id, destroy);
+	PassHandle PassManager::createById(uint64_t id, HandleCounter &counter) {
+		return PassHandle(id, counter, *this);
 	}
 
 	void PassManager::destroyById(uint64_t id) {
 		auto &pass = getById(id);
 
 		if (pass.m_Handle) {
+			m_imageManager->invalidateFramebuffers(pass.m_Handle);
+
 			getCore().getContext().getDevice().destroy(pass.m_Handle);
 			pass.m_Handle = nullptr;
 		}
 	}
 
-	PassManager::PassManager() noexcept : HandleManager<PassEntry, PassHandle>() {}
+	PassManager::PassManager() noexcept :
+		HandleManager<PassEntry, PassHandle>(), m_imageManager(nullptr) {}
 
 	PassManager::~PassManager() noexcept {
 		clear();
@@ -113,6 +126,27 @@ namespace vkcv {
 			layouts.push_back(layout);
 		}
 
+		if (config.isDynamicRendering()) {
+			const bool dynamicRendering =
+				(featureManager.checkFeatures<vk::PhysicalDeviceVulkan13Features>(
+					 vk::StructureType::ePhysicalDeviceVulkan13Features,
+					 [](const vk::PhysicalDeviceVulkan13Features &features) {
+						 return features.dynamicRendering;
+					 }) ||
+				 featureManager.checkFeatures<vk::PhysicalDeviceDynamicRenderingFeatures>(
+					 vk::StructureType::ePhysicalDeviceDynamicRenderingFeatures,
+					 [](const vk::PhysicalDeviceDynamicRenderingFeatures &features) {
+						 return features.dynamicRendering;
+					 }));
+
+			if (dynamicRendering) {
+				return add({ nullptr, config, layouts, true });
+			}
+
+			vkcv_log(LogLevel::WARNING,
+					 "Dynamic rendering is not enabled, using a render pass instead");
+		}
+
 		const vk::SubpassDescription subpassDescription(
 			{}, vk::PipelineBindPoint::eGraphics, 0, {},
 			static_cast<uint32_t>(colorAttachmentReferences.size()),
@@ -124,7 +158,7 @@ namespace vkcv {
 
 		vk::RenderPass renderPass = getCore().getContext().getDevice().createRenderPass(passInfo);
 
-		return add({ renderPass, config, layouts });
+		return add({ renderPass, config, layouts, false });
 	}
 
 	vk::RenderPass PassManager::getVkPass(const PassHandle &handle) const {
@@ -142,4 +176,85 @@ namespace vkcv {
 		return pass.m_Layouts;
 	}
 
+	bool PassManager::isDynamicRendering(const PassHandle &handle) const {
+		auto &pass = (*this) [handle];
+		return pass.m_DynamicRendering;
+	}
+
+	void PassManager::getAttachmentFormats(const PassHandle &handle,
+										   Vector<vk::Format> &colorFormats,
+										   vk::Format &depthFormat,
+										   vk::Format &stencilFormat) const {
+		auto &pass = (*this) [handle];
+
+		colorFormats.clear();
+		depthFormat = vk::Format::eUndefined;
+		stencilFormat = vk::Format::eUndefined;
+
+		for (const auto &attachment : pass.m_Config.getAttachments()) {
+			const vk::Format format = attachment.getFormat();
+
+			if (isDepthFormat(format)) {
+				depthFormat = format;
+			}
+
+			if (isStencilFormat(format)) {
+				stencilFormat = format;
+			}
+
+			if ((!isDepthFormat(format)) && (!isStencilFormat(format))) {
+				colorFormats.push_back(format);
+			}
+		}
+	}
+
+	void PassManager::recordBeginRendering(const PassHandle &handle,
+										   const Vector<vk::ImageView> &attachments,
+										   const vk::Rect2D &renderArea,
+										   const vk::CommandBuffer &cmdBuffer,
+										   vk::RenderingFlags flags) const {
+		auto &pass = (*this) [handle];
+
+		const auto &descriptions = pass.m_Config.getAttachments();
+
+		Vector<vk::RenderingAttachmentInfo> colorAttachments;
+		vk::RenderingAttachmentInfo depthAttachment;
+		vk::RenderingAttachmentInfo stencilAttachment;
+
+		bool depthUsed = false;
+		bool stencilUsed = false;
+
+		for (size_t i = 0; i < descriptions.size(); i++) {
+			const vk::RenderingAttachmentInfo attachmentInfo(
+				attachments [i], pass.m_Layouts [i], vk::ResolveModeFlagBits::eNone, nullptr,
+				vk::ImageLayout::eUndefined,
+				getVKLoadOpFromAttachOp(descriptions [i].getLoadOperation()),
+				getVkStoreOpFromAttachOp(descriptions [i].getStoreOperation()),
+				descriptions [i].getClearValue());
+
+			const bool depthFormat = isDepthFormat(descriptions [i].getFormat());
+			const bool stencilFormat = isStencilFormat(descriptions [i].getFormat());
+
+			if (depthFormat) {
+				depthAttachment = attachmentInfo;
+				depthUsed = true;
+			}
+
+			if (stencilFormat) {
+				stencilAttachment = attachmentInfo;
+				stencilUsed = true;
+			}
+
+			if ((!depthFormat) && (!stencilFormat)) {
+				colorAttachments.push_back(attachmentInfo);
+			}
+		}
+
+		const vk::RenderingInfo renderingInfo(flags, renderArea, 1, 0, colorAttachments,
+											  depthUsed ? &depthAttachment : nullptr,
+											  stencilUsed ? &stencilAttachment : nullptr);
+
+		cmdBuffer.beginRendering(renderingInfo, getCore().getContext().getDispatchLoaderDynamic());
+	}
+
 } // namespace vkcv
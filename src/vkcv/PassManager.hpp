@@ -9,10 +9,13 @@
 
 namespace vkcv {
 
+	class ImageManager;
+
 	struct PassEntry {
 		vk::RenderPass m_Handle;
 		PassConfig m_Config;
 		Vector<vk::ImageLayout> m_Layouts;
+		bool m_DynamicRendering;
 	};
 
 	/**
@@ -22,10 +25,15 @@ namespace vkcv {
 		friend class Core;
 
 	private:
+		ImageManager* m_imageManager;
+
+		using HandleManager<PassEntry, PassHandle>::init;
+		bool init(Core &core, ImageManager &imageManager);
+
 		[[nodiscard]] uint64_t getIdFrom(const PassHandle &handle) const override;
 
 		[[nodiscard]] PassHandle createById(uint64_t id,
-											const HandleDestroyFunction &destroy) override;
+											HandleCounter &counter) override;
 
 		/**
 		 * Destroys and deallocates pass represented by a given
@@ -48,6 +56,46 @@ namespace vkcv {
 
 		[[nodiscard]] const Vector<vk::ImageLayout> &
 		getLayouts(const PassHandle &handle) const;
+
+		/**
+		 * @brief Returns whether a pass uses dynamic rendering instead of
+		 * a render pass.
+		 *
+		 * @param[in] handle Pass handle
+		 * @return True, if the pass uses dynamic rendering, otherwise false
+		 */
+		[[nodiscard]] bool isDynamicRendering(const PassHandle &handle) const;
+
+		/**
+		 * @brief Returns the formats of the attachments of a pass split into
+		 * color attachments and its depth and stencil attachment as required
+		 * for dynamic rendering.
+		 *
+		 * @param[in] handle Pass handle
+		 * @param[out] colorFormats Formats of the color attachments
+		 * @param[out] depthFormat Format of the depth attachment or undefined
+		 * @param[out] stencilFormat Format of the stencil attachment or undefined
+		 */
+		void getAttachmentFormats(const PassHandle &handle,
+								  Vector<vk::Format> &colorFormats,
+								  vk::Format &depthFormat,
+								  vk::Format &stencilFormat) const;
+
+		/**
+		 * @brief Records the beginning of dynamic rendering of a pass
+		 * directly on given image views as attachments.
+		 *
+		 * @param[in] handle Pass handle
+		 * @param[in] attachments Image views of the attachments
+		 * @param[in] renderArea Render area
+		 * @param[in] cmdBuffer Vulkan command buffer
+		 * @param[in] flags (optional) Flags of dynamic rendering
+		 */
+		void recordBeginRendering(const PassHandle &handle,
+								  const Vector<vk::ImageView> &attachments,
+								  const vk::Rect2D &renderArea,
+								  const vk::CommandBuffer &cmdBuffer,
+								  vk::RenderingFlags flags = {}) const;
 	};
 
 } // namespace vkcv
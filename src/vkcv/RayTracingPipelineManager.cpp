@@ -13,8 +13,8 @@ namespace vkcv {
 		return handle.getId();
 	}
 	
-	RayTracingPipelineHandle RayTracingPipelineManager::createById(uint64_t id, const HandleDestroyFunction &destroy) {
-		return RayTracingPipelineHandle(id, destroy);
+	RayTracingPipelineHandle RayTracingPipelineManager::createById(uint64_t id, HandleCounter &counter) {
+		return RayTracingPipelineHandle(id, counter, *this);
 	}
 	
 	void RayTracingPipelineManager::destroyById(uint64_t id) {
@@ -357,7 +357,7 @@ namespace vkcv {
 		
 		const auto pipelineCreation = getCore().getContext().getDevice().createRayTracingPipelineKHR(
 				vk::DeferredOperationKHR(),
-				vk::PipelineCache(),
+				getCore().getPipelineCache(),
 				pipelineCreateInfo,
 				nullptr,
 				dynamicDispatch
@@ -38,7 +38,7 @@ namespace vkcv {
 		[[nodiscard]] uint64_t getIdFrom(const RayTracingPipelineHandle &handle) const override;
 		
 		[[nodiscard]] RayTracingPipelineHandle
-		createById(uint64_t id, const HandleDestroyFunction &destroy) override;
+		createById(uint64_t id, HandleCounter &counter) override;
 		
 		/**
 		 * Destroys and deallocates ray tracing pipeline represented by a given
@@ -2,18 +2,57 @@
 #include "SamplerManager.hpp"
 #include "vkcv/Core.hpp"
 
+#include <cstring>
+
 namespace vkcv {
 
+	static uint64_t getSamplerKey(SamplerFilterType magFilter, SamplerFilterType minFilter,
+								  SamplerMipmapMode mipmapMode, SamplerAddressMode addressMode,
+								  float mipLodBias, SamplerBorderColor borderColor) {
+		uint32_t bias;
+
+		// both signed zeros result in the same sampler
+		if (mipLodBias == 0.0f) {
+			mipLodBias = 0.0f;
+		}
+
+		std::memcpy(&bias, &mipLodBias, sizeof(bias));
+
+		return (
+			(static_cast<uint64_t>(magFilter) << 0) |
+			(static_cast<uint64_t>(minFilter) << 4) |
+			(static_cast<uint64_t>(mipmapMode) << 8) |
+			(static_cast<uint64_t>(addressMode) << 12) |
+			(static_cast<uint64_t>(borderColor) << 16) |
+			(static_cast<uint64_t>(bias) << 32)
+		);
+	}
+
 	uint64_t SamplerManager::getIdFrom(const SamplerHandle &handle) const {
 		return handle.getId();
 	}
 
-	SamplerHandle SamplerManager::createById(uint64_t id, const HandleDestroyFunction &destroy) {
-		return SamplerHandle(id, destroy);
+	SamplerHandle SamplerManager::createById(uint64_t id, HandleCounter &counter) {
+		return SamplerHandle(id, counter, *this);
 	}
 
 	void SamplerManager::destroyById(uint64_t id) {
+		std::lock_guard<std::mutex> lock(m_samplerMutex);
 		auto &sampler = getById(id);
+		const uint64_t index = (id & HANDLE_INDEX_MASK);
+
+		const auto it = m_samplerKeys.find(index);
+
+		// the key might already refer to a newer sampler in another slot
+		if (it != m_samplerKeys.end()) {
+			const auto indexIt = m_samplerIndices.find(it->second);
+
+			if ((indexIt != m_samplerIndices.end()) && (indexIt->second == index)) {
+				m_samplerIndices.erase(indexIt);
+			}
+
+			m_samplerKeys.erase(it);
+		}
 
 		if (sampler) {
 			getCore().getContext().getDevice().destroySampler(sampler);
@@ -21,7 +60,9 @@ namespace vkcv {
 		}
 	}
 
-	SamplerManager::SamplerManager() noexcept : HandleManager<vk::Sampler, SamplerHandle>() {}
+	SamplerManager::SamplerManager() noexcept :
+		HandleManager<vk::Sampler, SamplerHandle>(), m_samplerIndices(), m_samplerKeys(),
+		m_samplerMutex() {}
 
 	SamplerManager::~SamplerManager() noexcept {
 		clear();
@@ -114,6 +155,22 @@ namespace vkcv {
 			return SamplerHandle();
 		}
 
+		const uint64_t key = getSamplerKey(magFilter, minFilter, mipmapMode, addressMode,
+										   mipLodBias, borderColor);
+
+		std::lock_guard<std::mutex> lock(m_samplerMutex);
+		const auto it = m_samplerIndices.find(key);
+
+		if (it != m_samplerIndices.end()) {
+			// the sampler is shared via the reference counter of its slot, unless
+			// it has been released and only waits for its deferred destruction
+			const SamplerHandle handle = createHandleIfReferenced(getHandleId(it->second));
+
+			if (handle) {
+				return handle;
+			}
+		}
+
 		const vk::SamplerCreateInfo samplerCreateInfo(
 			vk::SamplerCreateFlags(), vkMagFilter, vkMinFilter, vkMipmapMode, vkAddressMode,
 			vkAddressMode, vkAddressMode, mipLodBias, false, 16.0f, false, vk::CompareOp::eAlways,
@@ -122,7 +179,16 @@ namespace vkcv {
 		const vk::Sampler sampler =
 			getCore().getContext().getDevice().createSampler(samplerCreateInfo);
 
-		return add(sampler);
+		SamplerHandle handle = add(sampler);
+
+		if (handle) {
+			const uint64_t index = (handle.getId() & HANDLE_INDEX_MASK);
+
+			m_samplerIndices [key] = index;
+			m_samplerKeys [index] = key;
+		}
+
+		return handle;
 	}
 
 	vk::Sampler SamplerManager::getVulkanSampler(const SamplerHandle &handle) const {
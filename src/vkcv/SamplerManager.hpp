@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <vulkan/vulkan.hpp>
 
 #include "HandleManager.hpp"
@@ -16,10 +17,23 @@ namespace vkcv {
 		friend class Core;
 
 	private:
+		/**
+		 * @brief Slot indices of created samplers by a key packing all of
+		 * their attributes, so equal samplers can be shared.
+		 */
+		Dictionary<uint64_t, uint64_t> m_samplerIndices;
+
+		/**
+		 * @brief Keys of created samplers by their slot indices, so
+		 * destroyed samplers can be removed from the indices directly.
+		 */
+		Dictionary<uint64_t, uint64_t> m_samplerKeys;
+		std::mutex m_samplerMutex;
+
 		[[nodiscard]] uint64_t getIdFrom(const SamplerHandle &handle) const override;
 
 		[[nodiscard]] SamplerHandle createById(uint64_t id,
-											   const HandleDestroyFunction &destroy) override;
+											   HandleCounter &counter) override;
 
 		void destroyById(uint64_t id) override;
 
@@ -28,6 +42,18 @@ namespace vkcv {
 
 		~SamplerManager() noexcept override;
 
+		/**
+		 * @brief Creates a sampler with given attributes or returns a
+		 * matching handle of an equal sampler.
+		 *
+		 * @param[in] magFilter Magnifying filter
+		 * @param[in] minFilter Minimizing filter
+		 * @param[in] mipmapMode Mipmapping filter
+		 * @param[in] addressMode Address mode
+		 * @param[in] mipLodBias Mip level of detail bias
+		 * @param[in] borderColor Border color
+		 * @return Sampler handle
+		 */
 		SamplerHandle createSampler(SamplerFilterType magFilter, SamplerFilterType minFilter,
 									SamplerMipmapMode mipmapMode, SamplerAddressMode addressMode,
 									float mipLodBias, SamplerBorderColor borderColor);
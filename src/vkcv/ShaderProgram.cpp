@@ -57,16 +57,24 @@ namespace vkcv {
 		m_Shaders {}, m_VertexAttachments {}, m_DescriptorSets {} {}
 
 	bool ShaderProgram::addShader(ShaderStage stage, const std::filesystem::path &path) {
+		Vector<uint32_t> shaderCode;
+		if (!readBinaryFromFile(path, shaderCode)) {
+			return false;
+		}
+
+		return addShader(stage, shaderCode);
+	}
+
+	bool ShaderProgram::addShader(ShaderStage stage, const Vector<uint32_t> &binary) {
 		if (m_Shaders.find(stage) != m_Shaders.end()) {
 			vkcv_log(LogLevel::WARNING, "Overwriting existing shader stage");
 		}
 
-		Vector<uint32_t> shaderCode;
-		if ((!readBinaryFromFile(path, shaderCode)) || (shaderCode.empty())) {
+		if (binary.empty()) {
 			return false;
 		}
-		
-		m_Shaders.insert(std::make_pair(stage, shaderCode));
+
+		m_Shaders.insert(std::make_pair(stage, binary));
 		reflectShader(stage);
 		return true;
 	}
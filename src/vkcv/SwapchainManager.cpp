@@ -11,8 +11,8 @@ namespace vkcv {
 	}
 
 	SwapchainHandle SwapchainManager::createById(uint64_t id,
-												 const HandleDestroyFunction &destroy) {
-		return SwapchainHandle(id, destroy);
+												 HandleCounter &counter) {
+		return SwapchainHandle(id, counter, *this);
 	}
 
 	void SwapchainManager::destroyById(uint64_t id) {
@@ -29,6 +29,10 @@ namespace vkcv {
 		}
 	}
 
+	bool SwapchainManager::isDestructionDeferred() const {
+		return false;
+	}
+
 	SwapchainManager::SwapchainManager() noexcept :
 		HandleManager<SwapchainEntry, SwapchainHandle>() {}
 
@@ -42,7 +42,7 @@ namespace vkcv {
 		[[nodiscard]] uint64_t getIdFrom(const SwapchainHandle &handle) const override;
 
 		[[nodiscard]] SwapchainHandle createById(uint64_t id,
-												 const HandleDestroyFunction &destroy) override;
+												 HandleCounter &counter) override;
 
 		/**
 		 * @brief Destroys a specific swapchain by a given id
@@ -51,6 +51,13 @@ namespace vkcv {
 		 */
 		void destroyById(uint64_t id) override;
 
+		/**
+		 * @brief Swapchains are destroyed immediately together with their window.
+		 *
+		 * @return False
+		 */
+		[[nodiscard]] bool isDestructionDeferred() const override;
+
 	public:
 		SwapchainManager() noexcept;
 
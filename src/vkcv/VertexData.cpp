@@ -14,15 +14,18 @@ namespace vkcv {
 	}
 
 	VertexData::VertexData(const Vector<VertexBufferBinding> &bindings) :
-		m_bindings(bindings), m_indices(), m_indexBitCount(IndexBitCount::Bit16), m_count(0) {}
+		m_bindings(bindings), m_indices(), m_indexBitCount(IndexBitCount::Bit16), m_indexOffset(0),
+		m_count(0) {}
 
 	const Vector<VertexBufferBinding> &VertexData::getVertexBufferBindings() const {
 		return m_bindings;
 	}
 
-	void VertexData::setIndexBuffer(const BufferHandle &indices, IndexBitCount indexBitCount) {
+	void VertexData::setIndexBuffer(const BufferHandle &indices, IndexBitCount indexBitCount,
+									size_t offset) {
 		m_indices = indices;
 		m_indexBitCount = indexBitCount;
+		m_indexOffset = offset;
 	}
 
 	const BufferHandle &VertexData::getIndexBuffer() const {
@@ -33,6 +36,10 @@ namespace vkcv {
 		return m_indexBitCount;
 	}
 
+	size_t VertexData::getIndexOffset() const {
+		return m_indexOffset;
+	}
+
 	void VertexData::setCount(size_t count) {
 		m_count = count;
 	}
@@ -6,8 +6,8 @@ namespace vkcv {
 		return handle.getId();
 	}
 
-	WindowHandle WindowManager::createById(uint64_t id, const HandleDestroyFunction &destroy) {
-		return WindowHandle(id, destroy);
+	WindowHandle WindowManager::createById(uint64_t id, HandleCounter &counter) {
+		return WindowHandle(id, counter, *this);
 	}
 
 	void WindowManager::destroyById(uint64_t id) {
@@ -19,6 +19,10 @@ namespace vkcv {
 		}
 	}
 
+	bool WindowManager::isDestructionDeferred() const {
+		return false;
+	}
+
 	WindowManager::WindowManager() noexcept : HandleManager<Window*, WindowHandle>() {}
 
 	WindowManager::~WindowManager() noexcept {
@@ -60,8 +64,10 @@ namespace vkcv {
 		Vector<WindowHandle> handles;
 
 		for (size_t id = 0; id < getCount(); id++) {
-			if (getById(id)->isOpen()) {
-				handles.push_back(WindowHandle(id));
+			const Window* window = getById(id);
+
+			if ((window) && (window->isOpen())) {
+				handles.push_back(WindowHandle(getHandleId(id)));
 			}
 		}
 
@@ -22,7 +22,7 @@ namespace vkcv {
 		[[nodiscard]] uint64_t getIdFrom(const WindowHandle &handle) const override;
 
 		[[nodiscard]] WindowHandle createById(uint64_t id,
-											  const HandleDestroyFunction &destroy) override;
+											  HandleCounter &counter) override;
 
 		/**
 		 * Destroys a specific window by a given id.
@@ -31,6 +31,13 @@ namespace vkcv {
 		 */
 		void destroyById(uint64_t id) override;
 
+		/**
+		 * Windows are destroyed immediately since they don't get used by the GPU.
+		 *
+		 * @return False
+		 */
+		[[nodiscard]] bool isDestructionDeferred() const override;
+
 	public:
 		WindowManager() noexcept;
 
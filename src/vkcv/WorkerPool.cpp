@@ -0,0 +1,117 @@
+/**
+ * @author Tobias Frisch
+ * @file vkcv/WorkerPool.cpp
+ */
+
+#include "WorkerPool.hpp"
+
+namespace vkcv {
+
+	WorkerPool::WorkerPool(size_t threadCount) :
+		m_threads(),
+		m_mutex(),
+		m_runMutex(),
+		m_started(),
+		m_finished(),
+		m_task(),
+		m_taskCount(0),
+		m_nextTask(0),
+		m_generation(0),
+		m_pendingWorkers(0),
+		m_running(true) {
+		if (threadCount > 1) {
+			m_threads.reserve(threadCount - 1);
+		}
+
+		for (size_t i = 1; i < threadCount; i++) {
+			m_threads.emplace_back(&WorkerPool::work, this);
+		}
+	}
+
+	WorkerPool::~WorkerPool() {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_running = false;
+		}
+
+		m_started.notify_all();
+
+		for (auto &thread : m_threads) {
+			thread.join();
+		}
+	}
+
+	void WorkerPool::execute() {
+		size_t index;
+
+		while ((index = m_nextTask.fetch_add(1)) < m_taskCount) {
+			m_task(index);
+		}
+	}
+
+	void WorkerPool::work() {
+		uint64_t generation = 0;
+
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+
+				m_started.wait(lock, [this, generation]() {
+					return (!m_running) || (m_generation != generation);
+				});
+
+				if (!m_running) {
+					return;
+				}
+
+				generation = m_generation;
+			}
+
+			execute();
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				if (--m_pendingWorkers == 0) {
+					m_finished.notify_one();
+				}
+			}
+		}
+	}
+
+	size_t WorkerPool::getThreadCount() const {
+		return m_threads.size() + 1;
+	}
+
+	void WorkerPool::run(size_t taskCount, const WorkerTaskFunction &task) {
+		if ((taskCount <= 1) || (m_threads.empty())) {
+			for (size_t i = 0; i < taskCount; i++) {
+				task(i);
+			}
+
+			return;
+		}
+
+		// runs from different threads get executed one after another
+		std::lock_guard<std::mutex> runLock(m_runMutex);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			m_task = task;
+			m_taskCount = taskCount;
+			m_nextTask = 0;
+			m_pendingWorkers = m_threads.size();
+			m_generation++;
+		}
+
+		m_started.notify_all();
+		execute();
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_finished.wait(lock, [this]() { return m_pendingWorkers == 0; });
+
+		m_task = nullptr;
+	}
+
+} // namespace vkcv
@@ -0,0 +1,90 @@
+#pragma once
+/**
+ * @authors Tobias Frisch
+ * @file vkcv/WorkerPool.hpp
+ * @brief Pool of persistent worker threads to distribute work across.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "vkcv/Container.hpp"
+
+namespace vkcv {
+
+	/**
+	 * @brief Function to be called for each task distributed by a worker pool.
+	 */
+	typedef std::function<void(size_t)> WorkerTaskFunction;
+
+	/**
+	 * @brief Class to run tasks in parallel on a pool of worker threads which
+	 * stay alive between runs, so no threads get created per run.
+	 */
+	class WorkerPool {
+	private:
+		Vector<std::thread> m_threads;
+
+		std::mutex m_mutex;
+		std::mutex m_runMutex;
+		std::condition_variable m_started;
+		std::condition_variable m_finished;
+
+		WorkerTaskFunction m_task;
+		size_t m_taskCount;
+		std::atomic<size_t> m_nextTask;
+
+		uint64_t m_generation;
+		size_t m_pendingWorkers;
+		bool m_running;
+
+		/**
+		 * @brief Executes tasks of the current run until all of them have
+		 * been claimed.
+		 */
+		void execute();
+
+		/**
+		 * @brief Main loop of each worker thread waiting for new runs.
+		 */
+		void work();
+
+	public:
+		/**
+		 * @brief Constructor of a worker pool using a given amount of
+		 * threads, including the thread calling run().
+		 *
+		 * @param[in] threadCount Amount of threads
+		 */
+		explicit WorkerPool(size_t threadCount);
+
+		WorkerPool(const WorkerPool &other) = delete;
+		WorkerPool(WorkerPool &&other) = delete;
+
+		~WorkerPool();
+
+		WorkerPool &operator=(const WorkerPool &other) = delete;
+		WorkerPool &operator=(WorkerPool &&other) = delete;
+
+		/**
+		 * @brief Returns the amount of threads executing tasks in a run,
+		 * including the thread calling run().
+		 *
+		 * @return Amount of threads
+		 */
+		[[nodiscard]] size_t getThreadCount() const;
+
+		/**
+		 * @brief Runs a given amount of tasks distributed across all threads
+		 * of the pool and returns after all of them have been finished.
+		 *
+		 * @param[in] taskCount Amount of tasks
+		 * @param[in] task Function to execute a task by its index
+		 */
+		void run(size_t taskCount, const WorkerTaskFunction &task);
+	};
+
+} // namespace vkcv